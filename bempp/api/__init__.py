@@ -55,6 +55,7 @@ from bempp.api.fmm.fmm_assembler import clear_fmm_cache
 
 from bempp.api.utils import pool
 from bempp.api.utils.pool import create_device_pool
+from bempp.api.utils import instrumentation
 
 from numba.core.errors import (
     NumbaDeprecationWarning,
@@ -76,6 +77,8 @@ try:
     from bempp.core.opencl_kernels import set_default_cpu_device_by_name
     from bempp.core.opencl_kernels import set_default_gpu_device_by_name
     from bempp.core.opencl_kernels import set_default_gpu_device
+    from bempp.core.opencl_kernels import set_assembly_devices
+    from bempp.core.opencl_kernels import set_assembly_devices_by_name
 except:
     pass
 
@@ -166,7 +169,12 @@ def set_logging_level(level):
 
 # pylint: disable=too-few-public-methods
 class Timer:
-    """Context manager to measure time in Bempp."""
+    """
+    Context manager to measure time in Bempp.
+
+    Inside an instrumentation recording the timed operation is also
+    recorded as a span named after the message.
+    """
 
     def __init__(self, enable_log=True, message="", level="timing"):
         """Construct."""
@@ -176,11 +184,16 @@ class Timer:
         self.enable_log = enable_log
         self.level = level
         self.message = message
+        self._span = None
 
     def __enter__(self):
         """Enter."""
+        from bempp.api.utils import instrumentation
+
         if self.enable_log:
             log("Start operation: " + self.message, level=self.level)
+        self._span = instrumentation.span(self.message or "Timer")
+        self._span.__enter__()
         self.start = _time.time()
         return self
 
@@ -188,6 +201,7 @@ class Timer:
         """Exit."""
         self.end = _time.time()
         self.interval = self.end - self.start
+        self._span.__exit__(*args)
         if self.enable_log:
             log(
                 "Finished Operation: " + self.message + f": {self.interval}s",
@@ -294,10 +308,17 @@ if DEFAULT_DEVICE_INTERFACE == "numba":
         "Numba backend activated. For full performance the OpenCL backend with an OpenCL CPU driver is required."
     )
 
+# The device interface "auto" selects the backend of each dense assembly
+# with the calibrated cost model in bempp.core.cost_model.
+
 DEFAULT_PRECISION = "double"
 VECTORIZATION_MODE = "auto"
 
 BOUNDARY_OPERATOR_DEVICE_TYPE = "cpu"
 POTENTIAL_OPERATOR_DEVICE_TYPE = "cpu"
 
+# Partition the OpenCL CPU device into NUMA sub-devices and distribute
+# dense assembly and potential evaluation across them.
+OPENCL_NUMA_FISSION = False
+
 ALL = -1  # Useful global identifier
@@ -8,6 +8,7 @@ def _create_assembler(
     from bempp.core.singular_assembler import SingularAssembler
     from bempp.core.dense_assembler import DenseAssembler
     from bempp.core.diagonal_assembler import DiagonalAssembler
+    from bempp.core.moment_assembler import MomentAssembler
     from bempp.api.fmm.fmm_assembler import FmmAssembler
     from bempp.api import check_for_fmm
 
@@ -29,7 +30,11 @@ def _create_assembler(
         return DenseAssembler(domain, dual_to_range, parameters)
     if identifier == "sparse":
         return SparseAssembler(domain, dual_to_range, parameters)
+    if identifier == "moments":
+        return MomentAssembler(domain, dual_to_range, parameters)
     if identifier == "fmm":
+        if domain.grid.is_curved or dual_to_range.grid.is_curved:
+            raise ValueError("The FMM assembler does not support curved grids.")
         if not check_for_fmm():
             raise ValueError(
                 "No compatible FMM library found. Please install Exafmm from github.com/exafmm/exafmm-t."
@@ -64,6 +69,7 @@ class AssemblerInterface(object):
         self._parameters = _api.assign_parameters(parameters)
         self._device_interface = device_interface
         self._precision = precision
+        self._assembler_type = assembler
 
         if self._device_interface is None:
             self._device_interface = bempp.api.DEFAULT_DEVICE_INTERFACE
@@ -100,6 +106,50 @@ class AssemblerInterface(object):
             **kwargs,
         )
 
+    def deform(self, domain, dual_to_range):
+        """Return an assembler of the same type for deformed spaces."""
+        if not isinstance(self._assembler_type, str):
+            raise ValueError("Only assemblers created from a string can be deformed.")
+        return AssemblerInterface(
+            domain,
+            dual_to_range,
+            self._assembler_type,
+            self._device_interface,
+            self._precision,
+            self._parameters,
+        )
+
+    @property
+    def supports_accumulation(self):
+        """Return true if the weak form can be summed into a dense array."""
+        return hasattr(self._implementation, "accumulate")
+
+    def result_type(self, operator_descriptor):
+        """Return the dtype of the assembled weak form."""
+        return self._implementation.result_type(operator_descriptor, self._precision)
+
+    def accumulate(self, operator_descriptor, result, alpha=1):
+        """Add alpha times the weak form to the dense array result in place."""
+        self._implementation.accumulate(
+            operator_descriptor,
+            self._device_interface,
+            self._precision,
+            result,
+            alpha,
+        )
+
+    @property
+    def is_dense(self):
+        """Return true if the assembler produces dense weak forms."""
+        from bempp.core.dense_assembler import DenseAssembler
+
+        return isinstance(self._implementation, DenseAssembler)
+
+    @property
+    def supports_incremental_assembly(self):
+        """Return true if the assembler can update a previous weak form."""
+        return self.is_dense
+
 
 class AssemblerBase(object):
     """Base class for assemblers."""
@@ -145,15 +195,28 @@ class PotentialAssembler(object):
         parameters,
     ):
         """Interface for potential operators."""
+        import bempp.api
+
+        if device_interface is None:
+            device_interface = bempp.api.DEFAULT_DEVICE_INTERFACE
+
         self.space = space
         self.points = points
         self.kernel_dimension = operator_descriptor.kernel_dimension
+        self.operator_descriptor = operator_descriptor
+        self.device_interface = device_interface
+        self.assembler = assembler
+        self.parameters = bempp.api.assign_parameters(parameters)
         self._is_complex = operator_descriptor.is_complex
 
         self._implementation = select_potential_implementation(
             space, points, operator_descriptor, device_interface, assembler, parameters
         )
 
+        if assembler == "direction_grid":
+            # The directions are given as a pair of polar and azimuthal angles.
+            self.points = self._implementation.points
+
     def evaluate(self, x):
         """Evaluate the potential."""
         import numpy as np
@@ -179,6 +242,11 @@ def select_potential_implementation(
     if device_interface is None:
         device_interface = bempp.api.DEFAULT_DEVICE_INTERFACE
 
+    if space.grid.is_curved and assembler != "dense":
+        raise ValueError(
+            f"The {assembler} potential assembler does not support curved grids."
+        )
+
     if assembler == "dense":
         from bempp.core.dense_potential_assembler import DensePotentialAssembler
 
@@ -196,5 +264,19 @@ def select_potential_implementation(
         return FmmPotentialAssembler(
             space, operator_descriptor, points, device_interface, parameters
         )
+    elif assembler == "octree":
+        from bempp.core.octree_potential_assembler import OctreePotentialAssembler
+
+        return OctreePotentialAssembler(
+            space, operator_descriptor, points, device_interface, parameters
+        )
+    elif assembler == "direction_grid":
+        from bempp.core.direction_grid_far_field_assembler import (
+            DirectionGridFarFieldAssembler,
+        )
+
+        return DirectionGridFarFieldAssembler(
+            space, operator_descriptor, points, device_interface, parameters
+        )
     else:
         raise ValueError(f"Unknown potential assembler: {assembler}")
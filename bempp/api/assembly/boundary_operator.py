@@ -1,5 +1,7 @@
 """Implementation of boundary operators."""
 
+import numpy as _np
+
 
 class BoundaryOperator(object):
     """A base class for boundary operators."""
@@ -110,6 +112,7 @@ class BoundaryOperatorWithAssembler(BoundaryOperator):
 
         self._assembler = assembler
         self._operator_descriptor = operator_descriptor
+        self._previous_weak_form = None
 
     @property
     def assembler(self):
@@ -121,9 +124,68 @@ class BoundaryOperatorWithAssembler(BoundaryOperator):
         """Operator descriptor."""
         return self._operator_descriptor
 
+    def deform(self, grid):
+        """
+        Return the operator on a deformed grid.
+
+        The grid must be obtained from the grid of the spaces of this
+        operator with Grid.deform. If the weak form of this operator has
+        been assembled densely, the weak form of the deformed operator
+        only recomputes the rows and columns associated with elements
+        whose geometry changed.
+        """
+        from bempp.api.assembly.discrete_boundary_operator import (
+            DenseDiscreteBoundaryOperator,
+        )
+
+        spaces = [self.domain, self.range, self.dual_to_range]
+        if any(space.grid != spaces[0].grid for space in spaces):
+            raise ValueError("All spaces must be defined on the same grid.")
+
+        deformed = {}
+        for space in spaces:
+            if space.id not in deformed:
+                deformed[space.id] = space.deform(grid)
+        domain, range_, dual_to_range = [deformed[space.id] for space in spaces]
+
+        descriptor = self.descriptor
+        if descriptor.singular_part is not None:
+            descriptor = descriptor._replace(
+                singular_part=descriptor.singular_part.deform(grid)
+            )
+
+        operator = BoundaryOperatorWithAssembler(
+            domain,
+            range_,
+            dual_to_range,
+            self.assembler.deform(domain, dual_to_range),
+            descriptor,
+        )
+
+        if self.assembler.supports_incremental_assembly and isinstance(
+            self._cached, DenseDiscreteBoundaryOperator
+        ):
+            operator._previous_weak_form = (
+                self._cached.to_dense(),
+                self.domain.grid.changed_elements(grid),
+            )
+
+        return operator
+
     def _assemble(self):
         """Assemble the operator."""
-        return self.assembler.assemble(self.descriptor)
+        from bempp.api.utils import instrumentation
+
+        with instrumentation.span("assembly", operator=self.descriptor.identifier):
+            if self._previous_weak_form is not None:
+                previous_weak_form, changed_elements = self._previous_weak_form
+                self._previous_weak_form = None
+                return self.assembler.assemble(
+                    self.descriptor,
+                    previous_weak_form=previous_weak_form,
+                    changed_elements=changed_elements,
+                )
+            return self.assembler.assemble(self.descriptor)
 
 
 class _SumBoundaryOperator(BoundaryOperator):
@@ -147,7 +209,10 @@ class _SumBoundaryOperator(BoundaryOperator):
 
     def _assemble(self):
         """Implement the weak form."""
-        return self._op1.weak_form() + self._op2.weak_form()
+        weak_form = _assemble_linear_combination(self)
+        if weak_form is None:
+            weak_form = self._op1.weak_form() + self._op2.weak_form()
+        return weak_form
 
 
 class _ScaledBoundaryOperator(BoundaryOperator):
@@ -164,7 +229,12 @@ class _ScaledBoundaryOperator(BoundaryOperator):
 
     def _assemble(self):
         """Implement the weak form."""
-        return self._op.weak_form() * self._alpha
+        weak_form = None
+        if isinstance(self._op, _SumBoundaryOperator):
+            weak_form = _assemble_linear_combination(self)
+        if weak_form is None:
+            weak_form = self._op.weak_form() * self._alpha
+        return weak_form
 
 
 class _ProductBoundaryOperator(BoundaryOperator):
@@ -331,7 +401,11 @@ class MultiplicationOperator(BoundaryOperator):
 
         import numpy as _np
 
-        points, weights = rule(self._parameters.quadrature.regular)
+        points, weights = rule(
+            self._parameters.quadrature.adapted_order(
+                "regular", self.domain, self.dual_to_range, self._grid_fun.space
+            )
+        )
 
         comp_trial, comp_test, comp_fun = return_compatible_representation(
             self.domain, self.dual_to_range, self._grid_fun.space
@@ -368,11 +442,13 @@ class MultiplicationOperator(BoundaryOperator):
 
         data = _np.zeros(number_of_elements * nshape_trial * nshape_test, dtype=dtype)
 
+        grid_data = grid.data("double")
+
         for index, elem_index in enumerate(elements):
             scale_vals = (
                 self._grid_fun.evaluate(elem_index, points)
                 * weights
-                * grid.integration_elements[index]
+                * grid_data.geometry(elem_index, points)[2]
             )
             domain_vals = comp_trial.evaluate(elem_index, points)
             trial_vals = op(domain_vals, scale_vals)
@@ -406,3 +482,67 @@ class MultiplicationOperator(BoundaryOperator):
             mat = self.dual_to_range.dof_transformation.T @ mat
 
         return SparseDiscreteBoundaryOperator(mat)
+
+
+def _linear_combination_terms(op, alpha=1):
+    """Return a list of (coefficient, operator) pairs that sum up to op."""
+    if isinstance(op, _SumBoundaryOperator):
+        return _linear_combination_terms(op._op1, alpha) + _linear_combination_terms(
+            op._op2, alpha
+        )
+    if isinstance(op, _ScaledBoundaryOperator):
+        return _linear_combination_terms(op._op, alpha * op._alpha)
+    return [(alpha, op)]
+
+
+def _is_fusable(op):
+    """Return true if the weak form of op can be summed into a dense array."""
+    return (
+        isinstance(op, BoundaryOperatorWithAssembler)
+        and op._cached is None
+        and op._previous_weak_form is None
+        and op.assembler.supports_accumulation
+        and not op.domain.requires_dof_transformation
+        and not op.dual_to_range.requires_dof_transformation
+    )
+
+
+def _assemble_linear_combination(op):
+    """
+    Assemble a linear combination of operators.
+
+    All terms whose assembler can sum into a dense array are accumulated
+    into a single matrix, so that only one dense matrix is kept in memory.
+    The weak forms of the remaining terms are added afterwards. Returns
+    None if the linear combination has fewer than two dense terms.
+    """
+    from bempp.api.assembly.discrete_boundary_operator import (
+        DenseDiscreteBoundaryOperator,
+    )
+
+    terms = _linear_combination_terms(op)
+    fused = [(alpha, term) for alpha, term in terms if _is_fusable(term)]
+
+    if sum(1 for _, term in fused if term.assembler.is_dense) < 2:
+        # Fusion only saves memory if there are several dense terms.
+        return None
+
+    dtype = _np.result_type(
+        *[term.assembler.result_type(term.descriptor) for _, term in fused],
+        *[_np.min_scalar_type(alpha) for alpha, _ in fused],
+    )
+
+    mat = _np.zeros(
+        (op.dual_to_range.global_dof_count, op.domain.global_dof_count), dtype=dtype
+    )
+
+    for alpha, term in fused:
+        if alpha != 0:
+            term.assembler.accumulate(term.descriptor, mat, alpha)
+
+    result = DenseDiscreteBoundaryOperator(mat)
+    for alpha, term in terms:
+        if not _is_fusable(term):
+            result = result + term.weak_form() * alpha
+
+    return result
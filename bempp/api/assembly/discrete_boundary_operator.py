@@ -1,6 +1,7 @@
 """Data structures for assembled boundary operators."""
 
 import warnings
+import numba as _numba
 import numpy as _np
 from bempp.helpers import timeit as _timeit
 from scipy.sparse.linalg.interface import LinearOperator as _LinearOperator
@@ -29,7 +30,7 @@ class _DiscreteOperatorBase(_LinearOperator):
 
     def __sub__(self, other):
         """Subtraction."""
-        return self.__add__(self, -other)
+        return self.__add__(-other)
 
     def dot(self, other):
         """Product with other objects."""
@@ -189,31 +190,63 @@ class DenseDiscreteBoundaryOperator(_DiscreteOperatorBase):
     :class:`scipy.sparse.linalg.interface.LinearOperator`
     and thereby implements the SciPy LinearOperator protocol.
 
+    The operator is a linear combination of dense matrices. Sums and
+    scalar multiples of dense operators are not formed explicitly but
+    applied term by term in each product. The matrices may be stored in
+    a lower precision than the dtype of the operator, in which case they
+    are promoted during the product (see with_storage_precision).
+
     """
 
-    def __init__(self, impl):
-        """Construct. Should not be called by the user."""
-        self._impl = impl
-        super().__init__(impl.dtype, impl.shape)
+    def __init__(self, impl, dtype=None):
+        """
+        Construct. Should not be called by the user.
+
+        impl is either a dense matrix or a list of (coefficient, matrix)
+        pairs. dtype is the type of the operator and defaults to the
+        type of the matrix.
+        """
+        if isinstance(impl, list):
+            self._terms = impl
+        else:
+            self._terms = [(1, impl)]
+        if dtype is None:
+            dtype = _np.result_type(*[mat.dtype for _, mat in self._terms])
+        super().__init__(_np.dtype(dtype), self._terms[0][1].shape)
 
     def _matmat(self, x):
         """Multiply the operator by a matrix or operator."""
-        if _np.iscomplexobj(x) and not _np.iscomplexobj(self.to_dense()):
-            return self.to_dense().dot(
-                _np.real(x).astype(self.dtype)
-            ) + 1j * self.to_dense().dot(_np.imag(x).astype(self.dtype))
-        return self.to_dense().dot(x.astype(self.dtype))
+        real_type = _real_type(self.dtype)
+        result_type = _product_type(self.dtype, x.dtype)
+        result = None
+        for coefficient, mat in self._terms:
+            product = _dense_product(
+                mat, x, _product_type(_np.promote_types(mat.dtype, real_type), x.dtype)
+            )
+            if coefficient != 1:
+                product = coefficient * product
+            if result is None:
+                result = product.astype(result_type, copy=False)
+            else:
+                result += product
+        return result
 
     def __add__(self, other):
         """Add two operators."""
         if isinstance(other, DenseDiscreteBoundaryOperator):
-            return DenseDiscreteBoundaryOperator(self.to_dense() + other.to_dense())
+            if self.shape != other.shape:
+                raise ValueError(
+                    f"Operators have incompatible shapes {self.shape} != {other.shape}"
+                )
+            return DenseDiscreteBoundaryOperator(
+                self._terms + other._terms, _np.result_type(self.dtype, other.dtype)
+            )
         else:
             return super().__add__(other)
 
     def __neg__(self):
         """Negate the operator."""
-        return DenseDiscreteBoundaryOperator(-self.to_dense())
+        return self._scale(-1)
 
     def __mul__(self, other):
         """Multiply."""
@@ -224,45 +257,151 @@ class DenseDiscreteBoundaryOperator(_DiscreteOperatorBase):
         if isinstance(other, DenseDiscreteBoundaryOperator):
             return DenseDiscreteBoundaryOperator(self.to_dense().dot(other.to_dense()))
         if _np.isscalar(other):
-            if self._impl.dtype in ["float32", "complex64"]:
-                # Necessary to ensure that scalar multiplication does not change
-                # precision to double precision.
-                if _np.iscomplexobj(other):
-                    return DenseDiscreteBoundaryOperator(
-                        self.to_dense() * _np.dtype("complex64").type(other)
-                    )
-                else:
-                    return DenseDiscreteBoundaryOperator(
-                        self.to_dense() * _np.dtype("float32").type(other)
-                    )
-            else:
-                return DenseDiscreteBoundaryOperator(self.to_dense() * other)
+            return self._scale(other)
         return super().dot(other)
 
     def __rmul__(self, other):
         """Multiply."""
         if _np.isscalar(other):
-            return DenseDiscreteBoundaryOperator(self.to_dense() * other)
+            return self._scale(other)
         else:
             return NotImplemented
 
+    def _scale(self, alpha):
+        """Return the operator scaled by alpha."""
+        # Scalars are converted to the precision of the operator, so that
+        # scalar multiplication does not change single to double precision.
+        if _np.iscomplexobj(alpha):
+            alpha = _np.promote_types(_real_type(self.dtype), "complex64").type(alpha)
+        else:
+            alpha = _real_type(self.dtype).type(alpha)
+        return DenseDiscreteBoundaryOperator(
+            [(alpha * coefficient, mat) for coefficient, mat in self._terms],
+            _np.result_type(self.dtype, alpha),
+        )
+
     def _transpose(self):
         """Transpose of the operator."""
-        return DenseDiscreteBoundaryOperator(self.to_dense().T)
+        return DenseDiscreteBoundaryOperator(
+            [(coefficient, mat.T) for coefficient, mat in self._terms], self.dtype
+        )
 
     def _adjoint(self):
         """Adjoint of the operator."""
-        return DenseDiscreteBoundaryOperator(self.to_dense().conjugate().transpose())
+        return DenseDiscreteBoundaryOperator(
+            [
+                (
+                    _np.conjugate(coefficient),
+                    mat.T.conjugate() if _np.iscomplexobj(mat) else mat.T,
+                )
+                for coefficient, mat in self._terms
+            ],
+            self.dtype,
+        )
+
+    def with_storage_precision(self, precision):
+        """
+        Return the operator with its matrices stored in a given precision.
+
+        precision is 'single' or 'double'. The dtype of the operator is not
+        changed. Matrices stored in single precision are promoted during
+        each product, which halves the memory of the operator and the
+        memory traffic of matrix-vector products.
+        """
+        from bempp.api.utils.helpers import get_type
+
+        types = get_type(precision)
+        return DenseDiscreteBoundaryOperator(
+            [
+                (
+                    coefficient,
+                    mat.astype(
+                        types.complex if _np.iscomplexobj(mat) else types.real,
+                        copy=False,
+                    ),
+                )
+                for coefficient, mat in self._terms
+            ],
+            self.dtype,
+        )
 
     def to_dense(self):
         """Return dense matrix."""
-        return self._impl
+        if len(self._terms) == 1:
+            coefficient, mat = self._terms[0]
+            if coefficient == 1 and mat.dtype == self.dtype:
+                return mat
+        result = _np.zeros(self.shape, dtype=self.dtype)
+        for coefficient, mat in self._terms:
+            if coefficient == 1:
+                result += mat
+            else:
+                result += coefficient * mat
+        return result
 
     def to_sparse(self):
         """Return sparse matrix if operator is sparse."""
         raise ValueError("This matrix is not sparse.")
 
 
+# Products of matrices stored in lower precision with up to this number of
+# right-hand sides are computed by a Numba kernel that promotes the matrix
+# entries on the fly. For more right-hand sides blocks of rows are promoted
+# and multiplied with BLAS.
+_PROMOTION_KERNEL_MAX_RHS = 4
+_PROMOTION_BLOCK_ROWS = 256
+
+
+def _real_type(dtype):
+    """Return the real type with the precision of dtype."""
+    return _np.empty(0, dtype=dtype).real.dtype
+
+
+def _product_type(dtype, other):
+    """Return the type of a product of dtype with other at the precision of dtype."""
+    if _np.dtype(other).kind == "c":
+        return _np.promote_types(dtype, "complex64")
+    return _np.dtype(dtype)
+
+
+def _dense_product(mat, x, dtype):
+    """
+    Return mat @ x computed in dtype.
+
+    A real matrix is applied to a complex x in a single real product
+    by viewing x as a real array with twice the number of columns.
+    """
+    if not _np.iscomplexobj(mat) and dtype.kind == "c":
+        real_type = _real_type(dtype)
+        x = _np.ascontiguousarray(x, dtype=dtype).view(real_type)
+        return _dense_product(mat, x, real_type).view(dtype)
+
+    x = _np.asarray(x, dtype=dtype)
+    if mat.dtype == dtype:
+        return mat @ x
+
+    result = _np.zeros((mat.shape[0], x.shape[1]), dtype=dtype)
+    if x.shape[1] <= _PROMOTION_KERNEL_MAX_RHS:
+        _promoted_matmat(mat, _np.ascontiguousarray(x.T), result)
+    else:
+        for start in range(0, mat.shape[0], _PROMOTION_BLOCK_ROWS):
+            end = min(start + _PROMOTION_BLOCK_ROWS, mat.shape[0])
+            _np.matmul(mat[start:end].astype(dtype), x, out=result[start:end])
+    return result
+
+
+@_numba.njit(parallel=True, fastmath=True, cache=True)
+def _promoted_matmat(mat, x_transpose, result):
+    """Add mat @ x_transpose.T to result in the precision of result."""
+    nrows, ncols = mat.shape
+    for row in _numba.prange(nrows):
+        for rhs in range(x_transpose.shape[0]):
+            value = result[row, rhs]
+            for col in range(ncols):
+                value += mat[row, col] * x_transpose[rhs, col]
+            result[row, rhs] = value
+
+
 class DiagonalOperator(_DiscreteOperatorBase):
     """
     Main class for discrete diagonal operators.
@@ -632,7 +771,7 @@ class _Solver(object):  # pylint: disable=too-few-public-methods
             use_mkl_pardiso = True
         except:
             solver_interface = splu
-            actual_mat = mat
+            actual_mat = mat.tocsc()
 
         if mat.shape[0] == mat.shape[1]:
             # Square matrix case
@@ -660,7 +799,12 @@ class _Solver(object):  # pylint: disable=too-few-public-methods
     def solve(self, rhs):
         """Solve with right-hand side mat."""
         if self._dtype == "float64" and _np.iscomplexobj(rhs):
-            return self.solve(_np.real(rhs)) + 1j * self.solve(_np.imag(rhs))
+            # Solve for the real and imaginary parts in a single call.
+            columns = rhs.reshape(rhs.shape[0], -1)
+            ncols = columns.shape[1]
+            result = self._solve_fun(_np.hstack([_np.real(columns), _np.imag(columns)]))
+            result = result[:, :ncols] + 1j * result[:, ncols:]
+            return result.reshape((result.shape[0],) + rhs.shape[1:])
 
         return self._solve_fun(rhs)
 
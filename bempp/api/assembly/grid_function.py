@@ -260,79 +260,9 @@ class GridFunction(object):
             self._representation = "dual"
 
         if fun is not None:
-            from bempp.api.integration.triangle_gauss import rule
-
-            points, weights = rule(self._parameters.quadrature.regular)
-
-            if function_parameters is None:
-                function_parameters = _np.array([], dtype="float64")
-
-            if fun.bempp_type == "real":
-                dtype = "float64"
-            else:
-                dtype = "complex128"
-                if function_parameters is not None:
-                    function_parameters = function_parameters.astype("complex128")
-
-            grid_projections = _np.zeros(comp_dual.grid_dof_count, dtype=dtype)
-            if not fun.bempp_vectorized:
-                # Callable is not vectorized
-
-                # Create a Numba callable from the function
-                _project_function(
-                    fun,
-                    comp_dual.grid.data("double"),
-                    comp_dual.support_elements,
-                    comp_dual.local2global,
-                    comp_dual.local_multipliers,
-                    comp_dual.normal_multipliers,
-                    comp_dual.numba_evaluate,
-                    comp_dual.shapeset.evaluate,
-                    points,
-                    weights,
-                    comp_domain.codomain_dimension,
-                    grid_projections,
-                    function_parameters,
-                )
-            else:
-                # Callable is vectorized
-
-                (
-                    global_quad_points,
-                    global_normals,
-                    global_domain_indices,
-                ) = get_function_quadrature_information(
-                    comp_dual.grid.data("double"),
-                    comp_dual.support_elements,
-                    comp_dual.normal_multipliers,
-                    points,
-                )
-                function_data = _np.empty(
-                    (comp_domain.codomain_dimension, global_quad_points.shape[1]),
-                    dtype=dtype,
-                )
-                fun(
-                    global_quad_points,
-                    global_normals,
-                    global_domain_indices,
-                    function_data,
-                    function_parameters,
-                )
-                _project_function_vectorized(
-                    function_data,
-                    comp_dual.grid.data("double"),
-                    comp_dual.support_elements,
-                    comp_dual.local2global,
-                    comp_dual.local_multipliers,
-                    comp_dual.normal_multipliers,
-                    comp_dual.numba_evaluate,
-                    comp_dual.shapeset.evaluate,
-                    points,
-                    weights,
-                    comp_domain.codomain_dimension,
-                    grid_projections,
-                    function_parameters,
-                )
+            grid_projections = _project_callables(
+                [fun], comp_domain, comp_dual, self._parameters, function_parameters
+            )[0]
 
             self._projections = comp_dual.dof_transformation.T @ grid_projections
 
@@ -553,7 +483,9 @@ class GridFunction(object):
         """Integrate grid function over a grid."""
         from bempp.api.integration.triangle_gauss import rule
 
-        points, weights = rule(self._parameters.quadrature.regular)
+        points, weights = rule(
+            self._parameters.quadrature.adapted_order("regular", self.space)
+        )
 
         return _integrate(
             self.grid_coefficients,
@@ -645,6 +577,70 @@ class GridFunction(object):
 
         return self + (-other)
 
+    @classmethod
+    def from_callables(
+        cls,
+        space,
+        funs,
+        dual_space=None,
+        parameters=None,
+        function_parameters=None,
+    ):
+        """
+        Create several grid functions from callables in one pass over the grid.
+
+        Parameters
+        ----------
+        space : bempp.api.space.Space
+            The space over which the GridFunctions are defined.
+        funs : callable or list of callables
+            The callables to discretise. All callables must be of the same
+            type (real or complex, vectorized or not). If a single callable
+            is given, it is discretised once for each row of
+            function_parameters.
+        dual_space : bempp.api.Space
+            A representation of the dual space. If not specified
+            then space == dual_space is assumed (optional).
+        parameters : bempp.api.ParameterList
+            A ParameterList object used for the assembly of
+            the GridFunctions (optional).
+        function_parameters : np.ndarray
+            Two-dimensional array whose rows contain the parameters for
+            the callables. A one-dimensional array is used for all
+            callables (optional).
+
+        Returns a list of GridFunction objects.
+
+        """
+        from bempp.api.utils.helpers import assign_parameters
+        from bempp.api.space.space import return_compatible_representation
+
+        if dual_space is None:
+            dual_space = space
+
+        parameters = assign_parameters(parameters)
+        comp_domain, comp_dual = return_compatible_representation(space, dual_space)
+
+        if not isinstance(funs, (list, tuple)):
+            if function_parameters is None or _np.ndim(function_parameters) < 2:
+                funs = [funs]
+            else:
+                funs = len(function_parameters) * [funs]
+
+        grid_projections = _project_callables(
+            funs, comp_domain, comp_dual, parameters, function_parameters
+        )
+
+        return [
+            cls(
+                space,
+                dual_space=dual_space,
+                projections=comp_dual.dof_transformation.T @ projections,
+                parameters=parameters,
+            )
+            for projections in grid_projections
+        ]
+
     @classmethod
     def from_random(cls, space):
         """Create a random grid function normalized to unit norm."""
@@ -713,7 +709,115 @@ class GridFunction(object):
     # return bempp.api.GridFunction(space, coefficients=values)
 
 
-@_numba.njit
+def _project_callables(funs, comp_domain, comp_dual, parameters, function_parameters):
+    """
+    Project a list of callables onto the grid dofs of the dual space.
+
+    Returns an array of shape (len(funs), comp_dual.grid_dof_count). The
+    quadrature data is computed only once for all callables. Several
+    parameter sets for the same non-vectorized callable, or several
+    vectorized callables, are projected in a single traversal of the grid.
+    """
+    from bempp.api.integration.triangle_gauss import rule
+
+    points, weights = rule(parameters.quadrature.adapted_order("regular", comp_dual))
+    nfuns = len(funs)
+
+    if len(set(fun.bempp_type for fun in funs)) != 1 or (
+        len(set(fun.bempp_vectorized for fun in funs)) != 1
+    ):
+        raise ValueError(
+            "All callables must be of the same type and either all or none "
+            + "must be vectorized."
+        )
+
+    if funs[0].bempp_type == "real":
+        dtype = "float64"
+    else:
+        dtype = "complex128"
+
+    if function_parameters is None:
+        function_parameters = _np.array([], dtype="float64")
+    function_parameters = _np.asarray(function_parameters).astype(dtype)
+    if function_parameters.ndim < 2:
+        function_parameters = _np.tile(function_parameters, (nfuns, 1))
+    if len(function_parameters) != nfuns:
+        raise ValueError("One set of function parameters per callable required.")
+    function_parameters = _np.ascontiguousarray(function_parameters)
+
+    grid_data = comp_dual.grid.data("double")
+    grid_projections = _np.zeros((nfuns, comp_dual.grid_dof_count), dtype=dtype)
+
+    if not funs[0].bempp_vectorized:
+        # Callables are not vectorized. Each distinct callable requires
+        # a separate traversal since Numba needs to compile it into the loop.
+        batches = {}
+        for index, fun in enumerate(funs):
+            batches.setdefault(id(fun), []).append(index)
+
+        for indices in batches.values():
+            projections = _np.zeros(
+                (len(indices), comp_dual.grid_dof_count), dtype=dtype
+            )
+            _project_function(
+                funs[indices[0]],
+                grid_data,
+                comp_dual.support_elements,
+                comp_dual.local2global,
+                comp_dual.local_multipliers,
+                comp_dual.normal_multipliers,
+                comp_dual.numba_evaluate,
+                comp_dual.shapeset.evaluate,
+                points,
+                weights,
+                comp_domain.codomain_dimension,
+                projections,
+                function_parameters[indices],
+            )
+            grid_projections[indices] = projections
+    else:
+        # Callables are vectorized
+        (
+            global_quad_points,
+            global_normals,
+            global_domain_indices,
+        ) = get_function_quadrature_information(
+            grid_data,
+            comp_dual.support_elements,
+            comp_dual.normal_multipliers,
+            points,
+        )
+        function_data = _np.empty(
+            (nfuns, comp_domain.codomain_dimension, global_quad_points.shape[1]),
+            dtype=dtype,
+        )
+        for index, fun in enumerate(funs):
+            fun(
+                global_quad_points,
+                global_normals,
+                global_domain_indices,
+                function_data[index],
+                function_parameters[index],
+            )
+        _project_function_vectorized(
+            function_data,
+            grid_data,
+            comp_dual.support_elements,
+            comp_dual.local2global,
+            comp_dual.local_multipliers,
+            comp_dual.normal_multipliers,
+            comp_dual.numba_evaluate,
+            comp_dual.shapeset.evaluate,
+            points,
+            weights,
+            comp_domain.codomain_dimension,
+            grid_projections,
+        )
+
+    return grid_projections
+
+
+@_numba.njit(parallel=True)
 def _integrate(
     coefficients,
     grid_data,
@@ -729,9 +833,13 @@ def _integrate(
     number_of_shape_functions,
 ):
     """Integrate a grid function over a grid."""
-    result = _np.zeros(codomain_dimension, dtype=coefficients.dtype)
+    nelements = len(support_elements)
+    element_results = _np.zeros(
+        (nelements, codomain_dimension), dtype=coefficients.dtype
+    )
 
-    for index in support_elements:
+    for element_index in _numba.prange(nelements):
+        index = support_elements[element_index]
         element_vals = evaluate_on_element(
             index,
             shapeset_evaluate,
@@ -741,24 +849,27 @@ def _integrate(
             normal_multipliers,
         )
 
-        result += (
+        integration_elements = grid_data.geometry(index, points)[2]
+
+        element_results[element_index] = _np.sum(
             _np.sum(
-                _np.sum(
-                    (element_vals * weights)
-                    * (
-                        coefficients[local2global[index]] * local_multipliers[index]
-                    ).reshape(number_of_shape_functions, 1),
-                    axis=-1,
-                ),
+                (element_vals * (weights * integration_elements))
+                * (
+                    coefficients[local2global[index]] * local_multipliers[index]
+                ).reshape(number_of_shape_functions, 1),
                 axis=-1,
-            )
-            * grid_data.integration_elements[index]
+            ),
+            axis=-1,
         )
 
+    result = _np.zeros(codomain_dimension, dtype=coefficients.dtype)
+    for element_index in range(nelements):
+        result += element_results[element_index]
+
     return result
 
 
-@_numba.njit
+@_numba.njit(parallel=True)
 def get_function_quadrature_information(
     grid_data, support_elements, normal_multipliers, quad_points
 ):
@@ -771,13 +882,13 @@ def get_function_quadrature_information(
     global_normals = _np.empty((3, npoints), dtype=_np.float64)
     global_domain_indices = _np.empty(npoints, dtype=_np.float64)
 
-    for index, element in enumerate(support_elements):
-        global_quad_points[
-            :, nlocal * index : nlocal * (1 + index)
-        ] = grid_data.local2global(element, quad_points)
+    for index in _numba.prange(nelements):
+        element = support_elements[index]
+        element_points, element_normals, _ = grid_data.geometry(element, quad_points)
+        global_quad_points[:, nlocal * index : nlocal * (1 + index)] = element_points
         for local_index in range(nlocal):
             global_normals[:, nlocal * index + local_index] = (
-                grid_data.normals[element] * normal_multipliers[element]
+                element_normals[:, local_index] * normal_multipliers[element]
             )
             global_domain_indices[
                 nlocal * index + local_index
@@ -786,8 +897,28 @@ def get_function_quadrature_information(
     return (global_quad_points, global_normals, global_domain_indices)
 
 
-# Must be used in jit mode as fun might just be a Python callable and not numba compiled.
 @_numba.njit
+def _scatter_element_projections(
+    element_projections, support_elements, local2global, projections
+):
+    """
+    Sum up the element contributions into the global projections.
+
+    The element contributions are computed in parallel into separate
+    storage so that no two threads write into the same dof.
+    """
+    nbatch = projections.shape[0]
+    for element_index in range(len(support_elements)):
+        element = support_elements[element_index]
+        for batch_index in range(nbatch):
+            for local_fun_index in range(element_projections.shape[2]):
+                projections[
+                    batch_index, local2global[element, local_fun_index]
+                ] += element_projections[element_index, batch_index, local_fun_index]
+
+
+# Must be used in jit mode as fun might just be a Python callable and not numba compiled.
+@_numba.njit(parallel=True)
 def _project_function(
     fun,
     grid_data,
@@ -803,14 +934,20 @@ def _project_function(
     projections,
     function_parameters,
 ):
-    """Project a Numba callable onto a grid."""
+    """Project a Numba callable onto a grid for several parameter sets."""
     npoints = points.shape[1]
-    global_points = _np.empty((3, npoints), dtype=_np.float64)
-    fvalues = _np.empty((codomain_dimension, npoints), dtype=projections.dtype)
-    fun_result = _np.empty(codomain_dimension, dtype=projections.dtype)
-    point = _np.empty(3, dtype=_np.float64)
+    nelements = len(support_elements)
+    nbatch = projections.shape[0]
+    nshape_funs = local2global.shape[1]
+
+    element_projections = _np.zeros(
+        (nelements, nbatch, nshape_funs), dtype=projections.dtype
+    )
 
-    for index in support_elements:
+    for element_index in _numba.prange(nelements):
+        index = support_elements[element_index]
+        fvalues = _np.empty((codomain_dimension, npoints), dtype=projections.dtype)
+        fun_result = _np.empty(codomain_dimension, dtype=projections.dtype)
 
         element_vals = evaluate_on_element(
             index,
@@ -821,38 +958,38 @@ def _project_function(
             normal_multipliers,
         )
 
-        for j in range(3):
-            global_points[j] = (
-                (1.0 - points[0] - points[1])
-                * grid_data.vertices[j, grid_data.elements[0, index]]
-                + points[0] * grid_data.vertices[j, grid_data.elements[1, index]]
-                + points[1] * grid_data.vertices[j, grid_data.elements[2, index]]
-            )
-
-        for j in range(npoints):
-            point = global_points[:, j]
+        global_points, normals, integration_elements = grid_data.geometry(index, points)
+        normals *= normal_multipliers[index]
 
-            fun(
-                point,
-                grid_data.normals[index] * normal_multipliers[index],
-                grid_data.domain_indices[index],
-                fun_result,
-                function_parameters,
-            )
-            fvalues[:, j] = fun_result
+        for batch_index in range(nbatch):
+            for j in range(npoints):
+                fun(
+                    global_points[:, j],
+                    normals[:, j],
+                    grid_data.domain_indices[index],
+                    fun_result,
+                    function_parameters[batch_index],
+                )
+                fvalues[:, j] = fun_result
 
-        for local_fun_index in range(element_vals.shape[1]):
-            projections[local2global[index, local_fun_index]] += (
-                _np.sum(
+            for local_fun_index in range(element_vals.shape[1]):
+                element_projections[
+                    element_index, batch_index, local_fun_index
+                ] = _np.sum(
                     _np.sum(
-                        element_vals[:, local_fun_index, :] * fvalues * weights, axis=0
+                        element_vals[:, local_fun_index, :]
+                        * fvalues
+                        * (weights * integration_elements),
+                        axis=0,
                     )
                 )
-                * grid_data.integration_elements[index]
-            )
 
+    _scatter_element_projections(
+        element_projections, support_elements, local2global, projections
+    )
 
-@_numba.njit
+
+@_numba.njit(parallel=True)
 def _project_function_vectorized(
     function_data,
     grid_data,
@@ -866,12 +1003,19 @@ def _project_function_vectorized(
     weights,
     codomain_dimension,
     projections,
-    function_parameters,
 ):
-    """Project a Numba callable onto a grid."""
+    """Project the values of several vectorized callables onto a grid."""
     npoints = points.shape[1]
+    nelements = len(support_elements)
+    nbatch = projections.shape[0]
+    nshape_funs = local2global.shape[1]
 
-    for index, element in enumerate(support_elements):
+    element_projections = _np.zeros(
+        (nelements, nbatch, nshape_funs), dtype=projections.dtype
+    )
+
+    for index in _numba.prange(nelements):
+        element = support_elements[index]
 
         element_vals = evaluate_on_element(
             element,
@@ -881,16 +1025,21 @@ def _project_function_vectorized(
             local_multipliers,
             normal_multipliers,
         )
+        integration_elements = grid_data.geometry(element, points)[2]
 
-        for local_fun_index in range(element_vals.shape[1]):
-            projections[local2global[element, local_fun_index]] += (
-                _np.sum(
+        for batch_index in range(nbatch):
+            for local_fun_index in range(element_vals.shape[1]):
+                element_projections[index, batch_index, local_fun_index] = _np.sum(
                     _np.sum(
                         element_vals[:, local_fun_index, :]
-                        * function_data[:, index * npoints : (1 + index) * npoints]
-                        * weights,
+                        * function_data[
+                            batch_index, :, index * npoints : (1 + index) * npoints
+                        ]
+                        * (weights * integration_elements),
                         axis=0,
                     )
                 )
-                * grid_data.integration_elements[element]
-            )
+
+    _scatter_element_projections(
+        element_projections, support_elements, local2global, projections
+    )
@@ -1,5 +1,22 @@
 """Definition of potential operators."""
 
+# Pairs of scalar potential kernels that can be evaluated with a single
+# combined kernel. The first entry is the single layer, the second entry
+# the double layer kernel.
+_FUSED_SCALAR_KERNELS = {
+    ("laplace_single_layer", "laplace_double_layer"): "laplace_single_and_double_layer",
+    (
+        "helmholtz_single_layer",
+        "helmholtz_double_layer",
+    ): "helmholtz_single_and_double_layer",
+    (
+        "modified_helmholtz_single_layer",
+        "modified_helmholtz_double_layer",
+    ): "modified_helmholtz_single_and_double_layer",
+}
+
+_FUSED_MAXWELL_ASSEMBLY_TYPES = ("maxwell_electric_field", "maxwell_magnetic_field")
+
 
 class PotentialOperator(object):
     """Provides an interface to potential operators.
@@ -22,7 +39,10 @@ class PotentialOperator(object):
             which the potential is applied to.
 
         """
-        return self._evaluator.evaluate(grid_fun.coefficients)
+        from bempp.api.utils import instrumentation
+
+        with instrumentation.span("potential evaluation"):
+            return self._evaluator.evaluate(grid_fun.coefficients)
 
     def _is_compatible(self, other):
         """Check compatibility with other potential operator."""
@@ -37,6 +57,10 @@ class PotentialOperator(object):
             and self.space.is_compatible(other.space)
         )
 
+    def _terms(self):
+        """Return a list of (scale, elementary operator) pairs."""
+        return [(1.0, self)]
+
     def __add__(self, obj):
         """Add."""
         if not self._is_compatible(obj):
@@ -114,6 +138,10 @@ class _ScaledPotentialOperator(PotentialOperator):
         """
         return self._alpha * self._op.evaluate(grid_fun)
 
+    def _terms(self):
+        """Return a list of (scale, elementary operator) pairs."""
+        return [(self._alpha * alpha, op) for alpha, op in self._op._terms()]
+
     @property
     def space(self):
         """Return the underlying function space."""
@@ -127,7 +155,7 @@ class _ScaledPotentialOperator(PotentialOperator):
     @property
     def evaluation_points(self):
         """Return the evaluation points."""
-        return self._op.points
+        return self._op.evaluation_points
 
 
 class _SumPotentialOperator(PotentialOperator):
@@ -135,16 +163,20 @@ class _SumPotentialOperator(PotentialOperator):
 
     def __init__(self, op1, op2):
         """Create sum of two potential operators."""
-        if not op1._is__compatible(op2):
+        if not op1._is_compatible(op2):
             raise ValueError("Potential operators are not compatible.")
 
         self._op1 = op1
         self._op2 = op2
+        self._fused_evaluator = None
 
     def evaluate(self, grid_fun):
         """
         Apply the potential operator to a grid function.
 
+        If all summands can be evaluated by a single combined kernel
+        the sum is computed in one pass over the grid.
+
         Parameters
         ----------
         grid_fun : bempp.api.GridFunction
@@ -152,8 +184,18 @@ class _SumPotentialOperator(PotentialOperator):
             which the potential is applied to.
 
         """
+        if self._fused_evaluator is None:
+            self._fused_evaluator = _fuse_potential_operators(self._terms())
+
+        if self._fused_evaluator:
+            return self._fused_evaluator.evaluate(grid_fun.coefficients)
+
         return self._op1.evaluate(grid_fun) + self._op2.evaluate(grid_fun)
 
+    def _terms(self):
+        """Return a list of (scale, elementary operator) pairs."""
+        return self._op1._terms() + self._op2._terms()
+
     @property
     def space(self):
         """Return the underlying function space."""
@@ -167,4 +209,137 @@ class _SumPotentialOperator(PotentialOperator):
     @property
     def evaluation_points(self):
         """Return the evaluation points."""
-        return self._op1.points
+        return self._op1.evaluation_points
+
+
+class _FusedPotentialEvaluator(object):
+    """
+    Evaluate a linear combination of potentials with a single kernel call.
+
+    The underlying evaluator returns the individual potentials stacked
+    along the first axis. They are combined with the given coefficients.
+    """
+
+    def __init__(self, evaluator, coefficients, component_count):
+        """Create a fused evaluator."""
+        self._evaluator = evaluator
+        self._coefficients = coefficients
+        self._component_count = component_count
+
+    def evaluate(self, x):
+        """Evaluate the potential."""
+        values = self._evaluator.evaluate(x)
+        result = 0
+        for index, coeff in enumerate(self._coefficients):
+            result = (
+                result
+                + coeff
+                * values[
+                    index * self._component_count : (index + 1) * self._component_count
+                ]
+            )
+        return result
+
+
+def _fuse_potential_operators(terms):
+    """
+    Try to combine a list of scaled potential operators into one evaluator.
+
+    Returns False if the operators cannot be fused.
+    """
+    import numpy as np
+    from bempp.api.assembly.assembler import PotentialAssembler
+    from bempp.api.operators import OperatorDescriptor
+
+    # Merge identical operators
+
+    scales = []
+    ops = []
+    for alpha, op in terms:
+        for index, other in enumerate(ops):
+            if op is other:
+                scales[index] += alpha
+                break
+        else:
+            scales.append(alpha)
+            ops.append(op)
+
+    assemblers = [op._evaluator for op in ops]
+
+    if not all(
+        isinstance(assembler, PotentialAssembler) and assembler.assembler == "dense"
+        for assembler in assemblers
+    ):
+        return False
+
+    reference = assemblers[0]
+    descriptors = [assembler.operator_descriptor for assembler in assemblers]
+
+    for assembler in assemblers[1:]:
+        if assembler.space != reference.space:
+            return False
+        if not np.array_equal(assembler.points, reference.points):
+            return False
+        if assembler.device_interface != reference.device_interface:
+            return False
+        if (
+            assembler.parameters.quadrature.regular
+            != reference.parameters.quadrature.regular
+        ):
+            return False
+        if assembler.operator_descriptor.precision != descriptors[0].precision:
+            return False
+        if list(assembler.operator_descriptor.options) != list(descriptors[0].options):
+            return False
+
+    if len(ops) == 1:
+        # Only a single operator left after merging. No need for a new kernel.
+        return _FusedPotentialEvaluator(reference, scales, reference.kernel_dimension)
+
+    if len(ops) != 2:
+        return False
+
+    assembly_types = [descriptor.assembly_type for descriptor in descriptors]
+    kernel_types = tuple(descriptor.kernel_type for descriptor in descriptors)
+
+    if assembly_types == ["default_scalar", "default_scalar"]:
+        if kernel_types in _FUSED_SCALAR_KERNELS:
+            order = [0, 1]
+        elif kernel_types[::-1] in _FUSED_SCALAR_KERNELS:
+            order = [1, 0]
+        else:
+            return False
+        kernel_type = _FUSED_SCALAR_KERNELS[tuple(kernel_types[i] for i in order)]
+        assembly_type = "fused_scalar"
+        component_count = 1
+    elif sorted(assembly_types) == list(_FUSED_MAXWELL_ASSEMBLY_TYPES):
+        order = [assembly_types.index(name) for name in _FUSED_MAXWELL_ASSEMBLY_TYPES]
+        kernel_type = descriptors[0].kernel_type
+        assembly_type = "fused_maxwell"
+        component_count = 3
+    else:
+        return False
+
+    operator_descriptor = OperatorDescriptor(
+        "fused_" + "_".join(descriptors[i].identifier for i in order),  # Identifier
+        descriptors[0].options,  # Options
+        kernel_type,  # Kernel type
+        assembly_type,  # Assembly type
+        descriptors[0].precision,  # Precision
+        any(descriptor.is_complex for descriptor in descriptors),  # Is complex
+        None,  # Singular part
+        2 * component_count,  # Kernel dimension
+    )
+
+    evaluator = PotentialAssembler(
+        reference.space,
+        reference.points,
+        operator_descriptor,
+        reference.device_interface,
+        "dense",
+        reference.parameters,
+    )
+
+    return _FusedPotentialEvaluator(
+        evaluator, [scales[i] for i in order], component_count
+    )
@@ -0,0 +1,179 @@
+"""Wideband operators interpolated in the wavenumber."""
+
+import numpy as _np
+
+
+class WidebandOperator(object):
+    """
+    Boundary operator interpolated over an interval of wavenumbers.
+
+    The operator is assembled at Chebychev nodes of the wavenumber
+    interval. Before interpolation, the oscillatory phase exp(ikr) is
+    factored out of each matrix entry, where r is the distance between
+    the centers of the supports of the corresponding basis functions.
+    The remaining factor depends smoothly on the wavenumber and is
+    well approximated by a low order polynomial. The node matrices are
+    stored as memory-mapped files.
+
+    This class is not supposed to be instantiated directly. Use for
+    example :func:`bempp.api.operators.boundary.helmholtz.wideband`.
+    """
+
+    def __init__(
+        self,
+        operator_factory,
+        domain,
+        range_,
+        dual_to_range,
+        wavenumber_interval,
+        order,
+        factor_phase=True,
+        directory=None,
+    ):
+        """Assemble the operator at the interpolation nodes."""
+        import os
+        import tempfile
+        from bempp.api import as_matrix
+        from bempp.api.utils.interpolation import ChebychevInterpolation
+
+        kmin, kmax = wavenumber_interval
+        if not kmin < kmax:
+            raise ValueError("Wavenumber interval must satisfy kmin < kmax.")
+
+        self._domain = domain
+        self._range = range_
+        self._dual_to_range = dual_to_range
+        self._interval = (kmin, kmax)
+
+        interpolation = ChebychevInterpolation(order)
+        self._nodes = interpolation.nodes
+        self._weights = interpolation.weights
+
+        if directory is None:
+            self._tempdir = tempfile.TemporaryDirectory(prefix="bempp_wideband_")
+            directory = self._tempdir.name
+        else:
+            self._tempdir = None
+
+        shape = (dual_to_range.global_dof_count, domain.global_dof_count)
+
+        if factor_phase:
+            self._distances = _dof_distances(dual_to_range, domain)
+        else:
+            self._distances = None
+
+        self._node_matrices = _np.lib.format.open_memmap(
+            os.path.join(directory, "node_matrices.npy"),
+            mode="w+",
+            dtype="complex128",
+            shape=(len(self._nodes),) + shape,
+        )
+
+        for index, wavenumber in enumerate(self.wavenumbers):
+            mat = operator_factory(
+                domain, range_, dual_to_range, wavenumber
+            ).weak_form()
+            self._node_matrices[index] = self._remove_phase(as_matrix(mat), wavenumber)
+
+        self._node_matrices.flush()
+
+    @property
+    def domain(self):
+        """Return the domain space."""
+        return self._domain
+
+    @property
+    def range(self):
+        """Return the range space."""
+        return self._range
+
+    @property
+    def dual_to_range(self):
+        """Return the dual to range space."""
+        return self._dual_to_range
+
+    @property
+    def wavenumber_interval(self):
+        """Return the interval of admissible wavenumbers."""
+        return self._interval
+
+    @property
+    def wavenumbers(self):
+        """Return the wavenumbers at the interpolation nodes."""
+        kmin, kmax = self._interval
+        return kmin + 0.5 * (kmax - kmin) * (1 + self._nodes)
+
+    def weak_form(self, wavenumber):
+        """Return the interpolated weak form for a given wavenumber."""
+        from bempp.api.assembly.discrete_boundary_operator import (
+            DenseDiscreteBoundaryOperator,
+        )
+
+        kmin, kmax = self._interval
+        if not kmin <= wavenumber <= kmax:
+            raise ValueError(
+                f"Wavenumber {wavenumber} is outside of the interval [{kmin}, {kmax}]."
+            )
+
+        local_coordinate = 2 * (wavenumber - kmin) / (kmax - kmin) - 1
+        coefficients = _barycentric_coefficients(
+            self._nodes, self._weights, local_coordinate
+        )
+
+        mat = _np.zeros(self._node_matrices.shape[1:], dtype="complex128")
+        for coefficient, node_matrix in zip(coefficients, self._node_matrices):
+            if coefficient != 0:
+                mat += coefficient * node_matrix
+
+        if self._distances is not None:
+            mat *= _np.exp(1j * wavenumber * self._distances)
+
+        return DenseDiscreteBoundaryOperator(mat)
+
+    def _remove_phase(self, mat, wavenumber):
+        """Remove the oscillatory phase from a matrix."""
+        if self._distances is None:
+            return mat
+        return mat * _np.exp(-1j * wavenumber * self._distances)
+
+
+def _barycentric_coefficients(nodes, weights, point):
+    """Return the values of the Lagrange polynomials at a given point."""
+    diff = point - nodes
+    exact = _np.flatnonzero(diff == 0)
+    if len(exact) > 0:
+        coefficients = _np.zeros(len(nodes))
+        coefficients[exact[0]] = 1
+        return coefficients
+    temp = weights / diff
+    return temp / _np.sum(temp)
+
+
+def _dof_centers(space):
+    """Return the average centroid of the support of each global dof."""
+    grid = space.grid
+    elements = space.support_elements
+    nshape = space.number_of_shape_functions
+
+    centers = _np.zeros((space.grid_dof_count, 3), dtype="float64")
+    counts = _np.zeros(space.grid_dof_count, dtype="float64")
+
+    dofs = space.local2global[elements].ravel()
+    _np.add.at(centers, dofs, _np.repeat(grid.centroids[elements], nshape, axis=0))
+    _np.add.at(counts, dofs, 1)
+
+    transformation = abs(space.dof_transformation)
+    return (transformation.T @ centers) / (transformation.T @ counts)[:, None]
+
+
+def _dof_distances(dual_to_range, domain):
+    """Return the distances between the dof centers of two spaces."""
+    test_centers = _dof_centers(dual_to_range)
+    trial_centers = _dof_centers(domain)
+
+    distances = _np.zeros((len(test_centers), len(trial_centers)), dtype="float64")
+    for dim in range(3):
+        distances += (
+            _np.subtract.outer(test_centers[:, dim], trial_centers[:, dim]) ** 2
+        )
+    return _np.sqrt(distances)
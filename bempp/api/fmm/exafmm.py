@@ -140,6 +140,9 @@ class ExafmmInterface(object):
         """Evalute the Fmm."""
         import bempp.api
         from bempp.api.fmm.helpers import debug_fmm
+        from bempp.api.utils import instrumentation
+
+        instrumentation.count("fmm calls")
 
         with bempp.api.Timer(message="Evaluating Fmm."):
             self._module.update_charges(self._tree, vec)
@@ -156,6 +156,7 @@ def get_local_interaction_operator(
     import bempp.api
     from bempp.api import GLOBAL_PARAMETERS
     from bempp.api.utils.helpers import get_type
+    from bempp.core.cost_model import resolve_device_interface
     from scipy.sparse import csr_matrix
     from scipy.sparse.linalg import aslinearoperator
     from scipy.sparse.linalg import LinearOperator
@@ -192,7 +193,10 @@ def get_local_interaction_operator(
         )
 
     elif GLOBAL_PARAMETERS.fmm.near_field_representation == "evaluate":
-        if bempp.api.DEFAULT_DEVICE_INTERFACE == "numba":
+        device_interface = resolve_device_interface(
+            bempp.api.DEFAULT_DEVICE_INTERFACE
+        ).split("_")[0]
+        if device_interface == "numba":
             evaluator = get_local_interaction_evaluator_numba(
                 grid.data(precision),
                 local_points.astype(dtype),
@@ -204,7 +208,7 @@ def get_local_interaction_operator(
             return LinearOperator(
                 shape=(rows, cols), matvec=evaluator, dtype=result_type
             )
-        elif bempp.api.DEFAULT_DEVICE_INTERFACE == "opencl":
+        elif device_interface == "opencl":
             evaluator = get_local_interaction_evaluator_opencl(
                 grid,
                 local_points.astype(dtype),
@@ -218,7 +222,7 @@ def get_local_interaction_operator(
             )
         else:
             raise ValueError(
-                "DEFAULT_DEVICE_INTERFACE must be one of 'numba', 'opencl'."
+                "DEFAULT_DEVICE_INTERFACE must be one of 'numba', 'opencl', 'auto'."
             )
     else:
         raise ValueError("Unknown value for near_field_representation.")
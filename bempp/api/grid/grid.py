@@ -11,15 +11,34 @@ VERTICES_ID = 1
 
 _EDGE_LOCAL = _np.array([[0, 1], [2, 0], [1, 2]])
 
+# Position of the node on local edge j in a six-node (meshio triangle6) element.
+_TRIANGLE6_EDGE_NODES = _np.array([3, 5, 4])
+
 
 class Grid(object):
     """The Grid class."""
 
     @_timeit
     def __init__(
-        self, vertices, elements, domain_indices=None, grid_id=None, scatter=True
+        self,
+        vertices,
+        elements,
+        domain_indices=None,
+        grid_id=None,
+        scatter=True,
+        edge_nodes=None,
     ):
-        """Create a grid from a vertices and an elements array."""
+        """
+        Create a grid from a vertices and an elements array.
+
+        The elements array is either a 3 x N array of flat triangles or
+        a 6 x N array of curved (quadratic) triangles. For six-node
+        triangles the first three rows are the corners and the last
+        three rows the nodes on the edges (0, 1), (1, 2) and (2, 0),
+        which is the triangle6 node order of Gmsh and meshio.
+        Alternatively, the edge nodes of a curved grid can be given as
+        a 3 x nedges array edge_nodes, ordered as the edges of the grid.
+        """
         from bempp.api import log
         from bempp.api.utils import pool
         from bempp.api.utils.helpers import create_unique_id
@@ -37,6 +56,7 @@ class Grid(object):
         self._edge_neighbors = None
         self._vertex_neighbors = None
         self._barycentric_grid = None
+        self._edge_nodes = None
         if grid_id:
             self._id = grid_id
         else:
@@ -55,8 +75,11 @@ class Grid(object):
         self._element_to_vertex_matrix = None
         self._element_to_element_matrix = None
 
-        self._normalize_and_assign_input(vertices, elements, domain_indices)
+        element_nodes = self._normalize_and_assign_input(
+            vertices, elements, domain_indices
+        )
         self._enumerate_edges()
+        self._assign_edge_nodes(element_nodes, edge_nodes)
 
         self._get_element_adjacency_for_edges_and_vertices()
         self._compute_geometric_quantities()
@@ -66,41 +89,7 @@ class Grid(object):
         self._compute_edge_neighbors()
         self._compute_vertex_neighbors()
 
-        self._grid_data_double = GridDataDouble(
-            self._vertices,
-            self._elements,
-            self._edges,
-            self._element_edges,
-            self._volumes,
-            self._normals,
-            self._jacobians,
-            self._jacobian_inverse_transposed,
-            self._diameters,
-            self._integration_elements,
-            self._centroids,
-            self._domain_indices,
-            self._vertex_on_boundary,
-            self._element_neighbors.indices,
-            self._element_neighbors.indexptr,
-        )
-
-        self._grid_data_single = GridDataFloat(
-            self._vertices.astype("float32"),
-            self._elements,
-            self._edges,
-            self._element_edges,
-            self._volumes.astype("float32"),
-            self._normals.astype("float32"),
-            self._jacobians.astype("float32"),
-            self._jacobian_inverse_transposed.astype("float32"),
-            self._diameters.astype("float32"),
-            self._integration_elements.astype("float32"),
-            self._centroids.astype("float32"),
-            self._domain_indices,
-            self._vertex_on_boundary,
-            self._element_neighbors.indices,
-            self._element_neighbors.indexptr,
-        )
+        self._create_grid_data()
 
         self._is_scattered = False
 
@@ -199,6 +188,21 @@ class Grid(object):
         """Return edges."""
         return self._edges
 
+    @property
+    def is_curved(self):
+        """Return true if the grid consists of curved six-node triangles."""
+        return self._edge_nodes is not None
+
+    @property
+    def edge_nodes(self):
+        """
+        Return the nodes on the edges of a curved grid.
+
+        Returns a 3 x nedges array whose jth column is the node on
+        the jth edge, or None for a grid of flat triangles.
+        """
+        return self._edge_nodes
+
     @property
     def centroids(self):
         """Return the centroids of the elements."""
@@ -237,6 +241,26 @@ class Grid(object):
         """
         return self.vertices.T[self.elements.flatten(order="F"), :].flatten(order="C")
 
+    @property
+    def curved_as_array(self):
+        """
+        Convert a curved grid to an array.
+
+        For a grid with N elements returns a 1d array with
+        18 * N entries. The entries [18 * e, 18 * (e + 1)] contain the
+        three corners of element e followed by the nodes on its three
+        local edges. For flat grids the edge nodes are the edge midpoints.
+        """
+        nodes = _np.empty((self.number_of_elements, 6, 3), dtype="float64")
+        nodes[:, :3, :] = _np.reshape(self.as_array, (self.number_of_elements, 3, 3))
+        if self.is_curved:
+            nodes[:, 3:, :] = self.edge_nodes.T[self.element_edges.T]
+        else:
+            nodes[:, 3:, :] = 0.5 * (
+                nodes[:, _EDGE_LOCAL[:, 0], :] + nodes[:, _EDGE_LOCAL[:, 1], :]
+            )
+        return nodes.flatten(order="C")
+
     @property
     def bounding_box(self):
         """
@@ -325,6 +349,10 @@ class Grid(object):
     @property
     def barycentric_refinement(self):
         """Return the barycentric refinement of this grid."""
+        if self.is_curved:
+            raise ValueError(
+                "Barycentric refinements are not supported for curved grids."
+            )
         if self._barycentric_grid is None:
             self._barycentric_grid = barycentric_refinement(self)
         return self._barycentric_grid
@@ -338,9 +366,11 @@ class Grid(object):
         """Initialise the grid on all workers."""
         from bempp.api.utils import pool
 
-        array_proxies = pool.to_buffer(
-            self.vertices, self.elements, self.domain_indices
-        )
+        arrays = [self.vertices, self.elements, self.domain_indices]
+        if self.is_curved:
+            arrays.append(self.edge_nodes)
+
+        array_proxies = pool.to_buffer(*arrays)
 
         pool.execute(_grid_scatter_worker, self.id, array_proxies)
         self._is_scattered = True
@@ -434,6 +464,8 @@ class Grid(object):
 
     def refine(self):
         """Return a new grid with all elements refined."""
+        if self.is_curved:
+            raise ValueError("Refinement is not supported for curved grids.")
         new_number_of_vertices = self.number_of_edges + self.number_of_vertices
 
         new_vertices = _np.empty(
@@ -471,6 +503,99 @@ class Grid(object):
 
         return Grid(new_vertices, new_elements, new_domain_indices)
 
+    def deform(self, vertices, edge_nodes=None):
+        """
+        Return a new grid with the same topology and new vertex coordinates.
+
+        The topological information (edges, adjacency and neighbor
+        relations) is shared with this grid and only the geometric
+        quantities are recomputed. Spaces and operators can be
+        transferred to the deformed grid with their respective
+        deform methods.
+
+        Parameters
+        ----------
+        vertices : np.ndarray
+            A 3 x N array of new coordinates for the N vertices of the grid.
+        edge_nodes : np.ndarray
+            For curved grids an optional 3 x nedges array of new edge
+            nodes. By default each edge node is moved by the mean
+            displacement of the two vertices of its edge.
+
+        """
+        from bempp.api import log
+        from bempp.api.utils import pool
+        from bempp.api.utils.helpers import align_array, create_unique_id
+
+        vertices = align_array(vertices, "float64", "F")
+        if vertices.shape != self._vertices.shape:
+            raise ValueError(
+                f"vertices must have shape {self._vertices.shape}, not {vertices.shape}."
+            )
+
+        if edge_nodes is not None:
+            if not self.is_curved:
+                raise ValueError("Edge nodes can only be given for curved grids.")
+            edge_nodes = align_array(edge_nodes, "float64", "F")
+            if edge_nodes.shape != self._edge_nodes.shape:
+                raise ValueError(
+                    f"edge_nodes must have shape {self._edge_nodes.shape}, "
+                    + f"not {edge_nodes.shape}."
+                )
+        elif self.is_curved:
+            displacements = vertices - self._vertices
+            edge_nodes = self._edge_nodes + 0.5 * (
+                displacements[:, self._edges[0]] + displacements[:, self._edges[1]]
+            )
+
+        grid = Grid.__new__(Grid)
+        grid.__dict__.update(self.__dict__)
+
+        grid._id = create_unique_id()
+        grid._vertices = vertices
+        grid._edge_nodes = edge_nodes
+        grid._barycentric_grid = None
+        grid._device_interfaces = {}
+
+        grid._compute_geometric_quantities()
+        grid._create_grid_data()
+
+        grid._is_scattered = False
+
+        if pool.is_initialised() and not pool.is_worker():
+            grid._scatter()
+        if not pool.is_worker():
+            log(f"Created grid with id {grid.id} by deforming grid {self.id}.")
+
+        return grid
+
+    def has_same_topology(self, other):
+        """Return true if other grid has the same vertex and element numbering."""
+        return self.number_of_vertices == other.number_of_vertices and (
+            self.elements is other.elements
+            or _np.array_equal(self.elements, other.elements)
+        )
+
+    def changed_elements(self, other):
+        """
+        Return the indices of the elements whose geometry differs from other.
+
+        The other grid must have the same topology as this grid, for
+        example because it was obtained with deform.
+        """
+        if not self.has_same_topology(other):
+            raise ValueError("Grids do not have the same topology.")
+
+        if self.is_curved != other.is_curved:
+            return _np.arange(self.number_of_elements)
+
+        moved_vertices = _np.any(self.vertices != other.vertices, axis=0)
+        moved = _np.any(moved_vertices[self.elements], axis=0)
+        if self.is_curved:
+            moved_edges = _np.any(self.edge_nodes != other.edge_nodes, axis=0)
+            moved |= _np.any(moved_edges[self.element_edges], axis=0)
+        return _np.flatnonzero(moved)
+
     def _compute_vertex_neighbors(self):
         """Return all elements adjacent to a given vertex."""
         from bempp.helpers import IndexList
@@ -484,16 +609,63 @@ class Grid(object):
         #    self._vertex_neighbors[index] = indices[indptr[index] : indptr[index + 1]]
 
     def _normalize_and_assign_input(self, vertices, elements, domain_indices):
-        """Convert input into the right form."""
+        """
+        Convert input into the right form.
+
+        For six-node triangles only the corners are kept as vertices of
+        the grid. The coordinates of the edge nodes of each element are
+        returned as a 3 x 3 x N array, and None otherwise.
+        """
         from bempp.api.utils.helpers import align_array
 
         if domain_indices is None:
             domain_indices = _np.zeros(elements.shape[1], dtype="uint32")
 
+        element_nodes = None
+
+        if elements.shape[0] == 6:
+            vertices = _np.asarray(vertices, dtype="float64")
+            elements = _np.asarray(elements, dtype="int64")
+            element_nodes = vertices[:, elements[_TRIANGLE6_EDGE_NODES]]
+            corners, elements = _np.unique(elements[:3], return_inverse=True)
+            vertices = vertices[:, corners]
+            elements = elements.reshape(3, -1)
+        elif elements.shape[0] != 3:
+            raise ValueError("elements must have either 3 or 6 rows.")
+
         self._vertices = align_array(vertices, "float64", "F")
         self._elements = align_array(elements, "uint32", "F")
         self._domain_indices = align_array(domain_indices, "uint32", "F")
 
+        return element_nodes
+
+    def _assign_edge_nodes(self, element_nodes, edge_nodes):
+        """Store the edge nodes of a curved grid."""
+        from bempp.api.utils.helpers import align_array
+
+        if element_nodes is not None and edge_nodes is not None:
+            raise ValueError(
+                "Edge nodes can either be given by six-node elements or "
+                + "by the edge_nodes array, but not both."
+            )
+
+        if element_nodes is not None:
+            edge_nodes = _np.empty((3, self.number_of_edges), dtype="float64")
+            for local_index in range(3):
+                edge_nodes[:, self._element_edges[local_index]] = element_nodes[
+                    :, local_index
+                ]
+
+        if edge_nodes is not None:
+            edge_nodes = align_array(edge_nodes, "float64", "F")
+            if edge_nodes.shape != (3, self.number_of_edges):
+                raise ValueError(
+                    f"edge_nodes must have shape {(3, self.number_of_edges)}, "
+                    + f"not {edge_nodes.shape}."
+                )
+
+        self._edge_nodes = edge_nodes
+
     def _enumerate_edges(self):
         """
         Enumerate all edges in a given grid.
@@ -632,6 +804,69 @@ class Grid(object):
                 jac_transpose_jac_inv[index]
             )
 
+        if self.is_curved:
+            # Normals, Jacobians and centroids are those of the flat
+            # triangles through the corners. Volumes are integrated
+            # over the curved elements.
+            from bempp.api.integration.triangle_gauss import rule
+
+            points, weights = rule(6)
+            self._volumes = _curved_volumes(
+                self._vertices,
+                self._elements,
+                self._element_edges,
+                self._edge_nodes,
+                points,
+                weights,
+            )
+
+    def _create_grid_data(self):
+        """Create the Numba containers for the grid data."""
+        if self.is_curved:
+            edge_nodes = self._edge_nodes
+        else:
+            edge_nodes = _np.empty((3, 0), dtype="float64")
+
+        self._grid_data_double = GridDataDouble(
+            self._vertices,
+            self._elements,
+            self._edges,
+            self._element_edges,
+            self._volumes,
+            self._normals,
+            self._jacobians,
+            self._jacobian_inverse_transposed,
+            self._diameters,
+            self._integration_elements,
+            self._centroids,
+            self._domain_indices,
+            self._vertex_on_boundary,
+            self._element_neighbors.indices,
+            self._element_neighbors.indexptr,
+            edge_nodes,
+            self.is_curved,
+        )
+
+        self._grid_data_single = GridDataFloat(
+            self._vertices.astype("float32"),
+            self._elements,
+            self._edges,
+            self._element_edges,
+            self._volumes.astype("float32"),
+            self._normals.astype("float32"),
+            self._jacobians.astype("float32"),
+            self._jacobian_inverse_transposed.astype("float32"),
+            self._diameters.astype("float32"),
+            self._integration_elements.astype("float32"),
+            self._centroids.astype("float32"),
+            self._domain_indices,
+            self._vertex_on_boundary,
+            self._element_neighbors.indices,
+            self._element_neighbors.indexptr,
+            edge_nodes.astype("float32"),
+            self.is_curved,
+        )
+
     def _compute_boundary_information(self):
         """
         Return a boolean array with boundary information.
@@ -695,6 +930,8 @@ class Grid(object):
         ("vertex_on_boundary", _numba.boolean[:]),
         ("element_neighbor_indices", _numba.uint32[:]),
         ("element_neighbor_indexptr", _numba.uint32[:]),
+        ("edge_nodes", _numba.float64[:, :]),
+        ("is_curved", _numba.boolean),
     ]
 )
 class GridDataDouble(object):
@@ -717,6 +954,8 @@ class GridDataDouble(object):
         vertex_on_boundary,
         element_neighbor_indices,
         element_neighbor_indexptr,
+        edge_nodes,
+        is_curved,
     ):
         """Create a GridDataDouble."""
         self.vertices = vertices
@@ -734,13 +973,57 @@ class GridDataDouble(object):
         self.vertex_on_boundary = vertex_on_boundary
         self.element_neighbor_indices = element_neighbor_indices
         self.element_neighbor_indexptr = element_neighbor_indexptr
+        self.edge_nodes = edge_nodes
+        self.is_curved = is_curved
 
     def local2global(self, elem_index, local_coords):
         """Map local to global coordinates."""
+        if self.is_curved:
+            return _quadratic_geometry(
+                _element_nodes(
+                    self.vertices,
+                    self.elements,
+                    self.element_edges,
+                    self.edge_nodes,
+                    elem_index,
+                ),
+                local_coords,
+            )[0]
         return _np.expand_dims(
             self.vertices[:, self.elements[0, elem_index]], 1
         ) + self.jacobians[elem_index].dot(local_coords)
 
+    def geometry(self, elem_index, local_coords):
+        """
+        Return the geometry of an element at given local coordinates.
+
+        Returns the global points, the unit normals and the integration
+        elements at the local points. For flat triangles the normals and
+        integration elements are constant over the element.
+        """
+        if self.is_curved:
+            return _quadratic_geometry(
+                _element_nodes(
+                    self.vertices,
+                    self.elements,
+                    self.element_edges,
+                    self.edge_nodes,
+                    elem_index,
+                ),
+                local_coords,
+            )
+        npoints = local_coords.shape[1]
+        normals = _np.empty((3, npoints), dtype=local_coords.dtype)
+        integration_elements = _np.empty(npoints, dtype=local_coords.dtype)
+        for index in range(npoints):
+            normals[:, index] = self.normals[elem_index]
+            integration_elements[index] = self.integration_elements[elem_index]
+        return (
+            self.local2global(elem_index, local_coords),
+            normals,
+            integration_elements,
+        )
+
 
 @_numba.experimental.jitclass(
     [
@@ -759,6 +1042,8 @@ class GridDataDouble(object):
         ("vertex_on_boundary", _numba.boolean[:]),
         ("element_neighbor_indices", _numba.uint32[:]),
         ("element_neighbor_indexptr", _numba.uint32[:]),
+        ("edge_nodes", _numba.float32[:, :]),
+        ("is_curved", _numba.boolean),
     ]
 )
 class GridDataFloat(object):
@@ -781,6 +1066,8 @@ class GridDataFloat(object):
         vertex_on_boundary,
         element_neighbor_indices,
         element_neighbor_indexptr,
+        edge_nodes,
+        is_curved,
     ):
         """Create a GridDataFloat."""
         self.vertices = vertices
@@ -798,13 +1085,57 @@ class GridDataFloat(object):
         self.vertex_on_boundary = vertex_on_boundary
         self.element_neighbor_indices = element_neighbor_indices
         self.element_neighbor_indexptr = element_neighbor_indexptr
+        self.edge_nodes = edge_nodes
+        self.is_curved = is_curved
 
     def local2global(self, elem_index, local_coords):
         """Map local to global coordinates."""
+        if self.is_curved:
+            return _quadratic_geometry(
+                _element_nodes(
+                    self.vertices,
+                    self.elements,
+                    self.element_edges,
+                    self.edge_nodes,
+                    elem_index,
+                ),
+                local_coords,
+            )[0]
         return _np.expand_dims(
             self.vertices[:, self.elements[0, elem_index]], 1
         ) + self.jacobians[elem_index].dot(local_coords)
 
+    def geometry(self, elem_index, local_coords):
+        """
+        Return the geometry of an element at given local coordinates.
+
+        Returns the global points, the unit normals and the integration
+        elements at the local points. For flat triangles the normals and
+        integration elements are constant over the element.
+        """
+        if self.is_curved:
+            return _quadratic_geometry(
+                _element_nodes(
+                    self.vertices,
+                    self.elements,
+                    self.element_edges,
+                    self.edge_nodes,
+                    elem_index,
+                ),
+                local_coords,
+            )
+        npoints = local_coords.shape[1]
+        normals = _np.empty((3, npoints), dtype=local_coords.dtype)
+        integration_elements = _np.empty(npoints, dtype=local_coords.dtype)
+        for index in range(npoints):
+            normals[:, index] = self.normals[elem_index]
+            integration_elements[index] = self.integration_elements[elem_index]
+        return (
+            self.local2global(elem_index, local_coords),
+            normals,
+            integration_elements,
+        )
+
 
 class ElementGeometry(object):
     """Provides geometry information for an element."""
@@ -856,6 +1187,10 @@ class ElementGeometry(object):
 
     def local2global(self, points):
         """Map points in local coordinates to global."""
+        if self._grid.is_curved:
+            return self._grid.data("double").local2global(
+                self._index, _np.asarray(points, dtype="float64")
+            )
         return _np.expand_dims(self.corners[:, 0], 1) + self.jacobian @ points
 
 
@@ -1211,6 +1546,8 @@ def _vertices_from_edge_index(element, local_index):
 
 def grid_from_segments(grid, segments):
     """Return new grid from segments of existing grid."""
+    if grid.is_curved:
+        raise ValueError("Segments of curved grids are not supported.")
     element_in_new_grid = _np.zeros(grid.number_of_elements, dtype=_np.bool)
 
     for elem in range(grid.number_of_elements):
@@ -1337,6 +1674,9 @@ def union(grids, domain_indices=None, swapped_normals=None):
     """
     from bempp.api.grid.grid import Grid
 
+    if any(grid.is_curved for grid in grids):
+        raise ValueError("The union of curved grids is not supported.")
+
     vertex_offset = 0
     element_offset = 0
 
@@ -1502,13 +1842,21 @@ def _grid_scatter_worker(grid_id, array_proxies):
     from bempp.api.grid.grid import Grid
     from bempp.api import log
 
-    vertices, elements, domain_indices = pool.from_buffer(array_proxies)
+    arrays = pool.from_buffer(array_proxies)
+    vertices, elements, domain_indices = arrays[:3]
+    edge_nodes = arrays[3].copy() if len(arrays) > 3 else None
 
     # if not pool.has_key(grid_id):
     if grid_id not in pool:
         pool.insert_data(
             grid_id,
-            Grid(vertices.copy(), elements.copy(), domain_indices.copy(), grid_id),
+            Grid(
+                vertices.copy(),
+                elements.copy(),
+                domain_indices.copy(),
+                grid_id,
+                edge_nodes=edge_nodes,
+            ),
         )
         log(f"Copied grid with id {grid_id} to worker {pool.get_id()}", "debug")
     else:
@@ -1541,8 +1889,94 @@ def grid_to_points(grid_data, local_points):
     points = _np.empty((number_of_points * number_of_elements, 3), dtype=_np.float64)
 
     for elem in range(number_of_elements):
-        points[number_of_points * elem : number_of_points * (1 + elem), :] = (
-            _np.expand_dims(grid_data.vertices[:, grid_data.elements[0, elem]], 1)
-            + grid_data.jacobians[elem].dot(local_points)
-        ).T
+        points[
+            number_of_points * elem : number_of_points * (1 + elem), :
+        ] = grid_data.local2global(elem, local_points).T
     return points
+
+
+@_numba.njit(cache=True)
+def _element_nodes(vertices, elements, element_edges, edge_nodes, elem_index):
+    """Return the corners and edge nodes of a curved element as 3 x 6 array."""
+    nodes = _np.empty((3, 6), dtype=vertices.dtype)
+    for local_index in range(3):
+        nodes[:, local_index] = vertices[:, elements[local_index, elem_index]]
+        nodes[:, 3 + local_index] = edge_nodes[
+            :, element_edges[local_index, elem_index]
+        ]
+    return nodes
+
+
+@_numba.njit(cache=True)
+def _quadratic_geometry(nodes, local_coords):
+    """
+    Evaluate the quadratic map of a six-node triangle.
+
+    The nodes are the three corners followed by the nodes on the local
+    edges (0, 1), (2, 0) and (1, 2). Returns the global points, the unit
+    normals and the integration elements at the local points.
+    """
+    npoints = local_coords.shape[1]
+    dtype = local_coords.dtype
+    points = _np.zeros((3, npoints), dtype=dtype)
+    normals = _np.empty((3, npoints), dtype=dtype)
+    integration_elements = _np.empty(npoints, dtype=dtype)
+
+    values = _np.empty(6, dtype=dtype)
+    ds = _np.empty(6, dtype=dtype)
+    dt = _np.empty(6, dtype=dtype)
+
+    for index in range(npoints):
+        s = local_coords[0, index]
+        t = local_coords[1, index]
+        lam0 = 1 - s - t
+
+        values[0] = lam0 * (2 * lam0 - 1)
+        values[1] = s * (2 * s - 1)
+        values[2] = t * (2 * t - 1)
+        values[3] = 4 * lam0 * s
+        values[4] = 4 * t * lam0
+        values[5] = 4 * s * t
+
+        ds[0] = 1 - 4 * lam0
+        ds[1] = 4 * s - 1
+        ds[2] = 0
+        ds[3] = 4 * (lam0 - s)
+        ds[4] = -4 * t
+        ds[5] = 4 * t
+
+        dt[0] = 1 - 4 * lam0
+        dt[1] = 0
+        dt[2] = 4 * t - 1
+        dt[3] = -4 * s
+        dt[4] = 4 * (lam0 - t)
+        dt[5] = 4 * s
+
+        jac_s = _np.zeros(3, dtype=dtype)
+        jac_t = _np.zeros(3, dtype=dtype)
+        for node in range(6):
+            for dim in range(3):
+                points[dim, index] += values[node] * nodes[dim, node]
+                jac_s[dim] += ds[node] * nodes[dim, node]
+                jac_t[dim] += dt[node] * nodes[dim, node]
+
+        normal = _np.cross(jac_s, jac_t)
+        integration_element = _np.sqrt(_np.sum(normal * normal))
+        normals[:, index] = normal / integration_element
+        integration_elements[index] = integration_element
+
+    return points, normals, integration_elements
+
+
+@_numba.njit(cache=True)
+def _curved_volumes(vertices, elements, element_edges, edge_nodes, points, weights):
+    """Integrate the volumes of curved elements."""
+    number_of_elements = elements.shape[1]
+    volumes = _np.empty(number_of_elements, dtype=_np.float64)
+    for elem in range(number_of_elements):
+        integration_elements = _quadratic_geometry(
+            _element_nodes(vertices, elements, element_edges, edge_nodes, elem),
+            points,
+        )[2]
+        volumes[elem] = _np.sum(integration_elements * weights)
+    return volumes
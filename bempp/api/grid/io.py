@@ -14,16 +14,30 @@ def import_grid(filename):
 
     https://github.com/nschloe/meshio
 
+    Grids of six-node (triangle6) elements are imported as curved
+    grids. Files that contain both flat and curved triangles are not
+    supported.
+
     """
     from bempp.api.grid.grid import Grid
 
     mesh = _meshio.read(filename)
 
+    if "triangle6" in mesh.cells_dict:
+        if "triangle" in mesh.cells_dict:
+            raise ValueError(
+                "Grids with both flat (triangle) and curved (triangle6) elements "
+                + "are not supported."
+            )
+        cell_type = "triangle6"
+    else:
+        cell_type = "triangle"
+
     vertices = mesh.points.T
-    elements = mesh.cells_dict["triangle"].T.astype("uint32")
+    elements = mesh.cells_dict[cell_type].T.astype("uint32")
 
     try:
-        domain_indices = mesh.cell_data_dict["gmsh:physical"]["triangle"]
+        domain_indices = mesh.cell_data_dict["gmsh:physical"][cell_type]
     except:
         domain_indices = None
 
@@ -47,7 +61,8 @@ def export(
     https://github.com/nschloe/meshio
 
     Note that export of domain indices is only possible for Gmsh (.msh)
-    format files.
+    format files. Curved grids are exported as six-node triangles,
+    except for vertex data, which is exported on the flat triangles.
 
     Parameters
     ----------
@@ -121,8 +136,15 @@ def export(
         else:
             raise ValueError("'data_type' must be one of 'element' or 'node'")
 
-    cells = [("triangle", grid.elements.T.astype("int32"))]
-    points = grid.vertices.T
+    if grid.is_curved and point_data is None:
+        # Edge nodes are numbered after the vertices.
+        edge_nodes = grid.number_of_vertices + grid.element_edges
+        elements = _np.vstack([grid.elements, edge_nodes[[0, 2, 1]]])
+        cells = [("triangle6", elements.T.astype("int32"))]
+        points = _np.hstack([grid.vertices, grid.edge_nodes]).T
+    else:
+        cells = [("triangle", grid.elements.T.astype("int32"))]
+        points = grid.vertices.T
 
     if gmsh:
         # physical and geometrical index must be 2 dim arrays with first dimension
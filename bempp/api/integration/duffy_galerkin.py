@@ -1,6 +1,22 @@
 """Duffy transformation rules for singular integration for Galerkin integrals."""
+import collections as _collections
+import functools as _functools
+
 import numpy as _np
 
+# Ordered pairs of local vertices of a shared edge. The position of a pair
+# in this list is its permutation index in the edge adjacent tables.
+EDGE_PERMUTATIONS = [(0, 1), (1, 0), (1, 2), (2, 1), (0, 2), (2, 0)]
+
+# Local vertex of a shared vertex. The position in this list is the
+# permutation index in the vertex adjacent tables.
+VERTEX_PERMUTATIONS = [0, 1, 2]
+
+SingularQuadratureTable = _collections.namedtuple(
+    "SingularQuadratureTable",
+    "test_points trial_points weights number_of_points number_of_permutations",
+)
+
 
 def number_of_quadrature_points(order, adjacency):
     """Return the number of quadrature points for given adjacency.
@@ -309,3 +325,51 @@ def remap_points_shared_edge(points, shared_vertex1, shared_vertex2):
     new_points = A.dot(points) + new_vertices[:, 0].reshape(2, 1)
 
     return _np.require(new_points, requirements=["F"])
+
+
+@_functools.lru_cache(maxsize=None)
+def tables(order):
+    """
+    Return the reference tables of the singular rules of a given order.
+
+    Returns a dictionary that maps each adjacency ("coincident",
+    "edge_adjacent", "vertex_adjacent") to a SingularQuadratureTable. Its
+    test and trial points are 2 x (number_of_permutations * number_of_points)
+    arrays that contain the points of the rule remapped for each
+    permutation in EDGE_PERMUTATIONS or VERTEX_PERMUTATIONS, one after the
+    other. The points of the pth permutation start at column
+    p * number_of_points. The tables are computed once for each order and
+    must not be modified.
+    """
+    remaps = {
+        "coincident": [lambda points: points],
+        "edge_adjacent": [
+            _functools.partial(
+                remap_points_shared_edge, shared_vertex1=first, shared_vertex2=second
+            )
+            for first, second in EDGE_PERMUTATIONS
+        ],
+        "vertex_adjacent": [
+            _functools.partial(remap_points_shared_vertex, vertex_id=vertex)
+            for vertex in VERTEX_PERMUTATIONS
+        ],
+    }
+
+    result = {}
+    for adjacency, adjacency_remaps in remaps.items():
+        test_points, trial_points, weights = rule(order, adjacency)
+        table = SingularQuadratureTable(
+            _np.asfortranarray(
+                _np.hstack([remap(test_points) for remap in adjacency_remaps])
+            ),
+            _np.asfortranarray(
+                _np.hstack([remap(trial_points) for remap in adjacency_remaps])
+            ),
+            weights,
+            len(weights),
+            len(adjacency_remaps),
+        )
+        for array in table[:3]:
+            array.flags.writeable = False
+        result[adjacency] = table
+    return result
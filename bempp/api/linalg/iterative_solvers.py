@@ -117,6 +117,7 @@ def cg(
 
     import bempp.api
     import time
+    from bempp.api.utils import instrumentation
 
     if not isinstance(A, BoundaryOperator):
         raise ValueError("A must be of type BoundaryOperator")
@@ -139,9 +140,14 @@ def cg(
     callback = IterationCounter(return_residuals, True, A_op, b_vec)
     bempp.api.log("Starting CG iteration")
     start_time = time.time()
-    x, info = scipy.sparse.linalg.cg(
-        A_op, b_vec, tol=tol, maxiter=maxiter, callback=callback
-    )
+    with instrumentation.span("cg"):
+        x, info = scipy.sparse.linalg.cg(
+            instrumentation.counted_operator(A_op),
+            b_vec,
+            tol=tol,
+            maxiter=maxiter,
+            callback=callback,
+        )
     end_time = time.time()
     bempp.api.log(
         "CG finished in %i iterations and took %.2E sec."
@@ -179,6 +185,7 @@ def _gmres_single_op_imp(
 
     import bempp.api
     import time
+    from bempp.api.utils import instrumentation
 
     if not isinstance(b, GridFunction):
         raise ValueError("b must be of type GridFunction")
@@ -201,9 +208,15 @@ def _gmres_single_op_imp(
 
     bempp.api.log("Starting GMRES iteration")
     start_time = time.time()
-    x, info = scipy.sparse.linalg.gmres(
-        A_op, b_vec, tol=tol, restart=restart, maxiter=maxiter, callback=callback
-    )
+    with instrumentation.span("gmres"):
+        x, info = scipy.sparse.linalg.gmres(
+            instrumentation.counted_operator(A_op),
+            b_vec,
+            tol=tol,
+            restart=restart,
+            maxiter=maxiter,
+            callback=callback,
+        )
     end_time = time.time()
     bempp.api.log(
         "GMRES finished in %i iterations and took %.2E sec."
@@ -239,6 +252,7 @@ def _gmres_block_op_imp(
 
     import bempp.api
     import time
+    from bempp.api.utils import instrumentation
     from bempp.api.assembly.blocked_operator import (
         coefficients_from_grid_functions_list,
         projections_from_grid_functions_list,
@@ -258,9 +272,15 @@ def _gmres_block_op_imp(
 
     bempp.api.log("Starting GMRES iteration")
     start_time = time.time()
-    x, info = scipy.sparse.linalg.gmres(
-        A_op, b_vec, tol=tol, restart=restart, maxiter=maxiter, callback=callback
-    )
+    with instrumentation.span("gmres"):
+        x, info = scipy.sparse.linalg.gmres(
+            instrumentation.counted_operator(A_op),
+            b_vec,
+            tol=tol,
+            restart=restart,
+            maxiter=maxiter,
+            callback=callback,
+        )
     end_time = time.time()
     bempp.api.log(
         "GMRES finished in %i iterations and took %.2E sec."
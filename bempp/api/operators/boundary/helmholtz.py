@@ -176,6 +176,91 @@ def hypersingular(
     )
 
 
+def wideband(
+    operator,
+    domain,
+    range_,
+    dual_to_range,
+    wavenumber_interval,
+    order=8,
+    parameters=None,
+    assembler="default_nonlocal",
+    device_interface=None,
+    precision=None,
+    factor_phase=True,
+    directory=None,
+):
+    """
+    Create a Helmholtz operator interpolated over a wavenumber interval.
+
+    The operator is assembled at order + 1 Chebychev nodes in the
+    interval. Its weak form for any wavenumber in the interval is then
+    obtained by interpolation.
+
+    Parameters
+    ----------
+    operator : callable
+        The Helmholtz operator to interpolate, e.g. single_layer,
+        double_layer or hypersingular from this module.
+    domain : bempp.api.Space
+        The domain space.
+    range_ : bempp.api.Space
+        The range space.
+    dual_to_range : bempp.api.Space
+        The dual to range space.
+    wavenumber_interval : tuple
+        The real interval (kmin, kmax) of wavenumbers.
+    order : int
+        The order of the Chebychev interpolation.
+    parameters : Parameters
+        An optional parameters object.
+    assembler : string
+        The assembler type. It must produce dense weak forms.
+    device_interface : DeviceInterface
+        The device interface object to be used.
+    precision : string
+        Either "single" or "double" for single or
+        double precision mode.
+    factor_phase : bool
+        If True, factor out the phase exp(ikr) before interpolation,
+        where r is the distance between basis function supports.
+    directory : string
+        Directory for the memory-mapped node matrices. By default a
+        temporary directory is used.
+
+    Output
+    ------
+    A WidebandOperator object, whose weak_form(k) method returns the
+    interpolated weak form for a wavenumber k.
+
+    """
+    from bempp.api.assembly.wideband_operator import WidebandOperator
+
+    def operator_factory(domain, range_, dual_to_range, wavenumber):
+        """Create the operator for a given wavenumber."""
+        return operator(
+            domain,
+            range_,
+            dual_to_range,
+            wavenumber,
+            parameters=parameters,
+            assembler=assembler,
+            device_interface=device_interface,
+            precision=precision,
+        )
+
+    return WidebandOperator(
+        operator_factory,
+        domain,
+        range_,
+        dual_to_range,
+        wavenumber_interval,
+        order,
+        factor_phase=factor_phase,
+        directory=directory,
+    )
+
+
 def multitrace_operator(
     grid,
     wavenumber,
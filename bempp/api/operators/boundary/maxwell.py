@@ -70,6 +70,82 @@ def magnetic_field(
     )
 
 
+def combined_field(
+    domain,
+    range_,
+    dual_to_range,
+    wavenumber,
+    electric_weight=1,
+    magnetic_weight=1,
+    parameters=None,
+    assembler="default_nonlocal",
+    device_interface=None,
+    precision=None,
+):
+    """
+    Assemble a weighted sum of the electric and magnetic field operators.
+
+    The operator is electric_weight * E + magnetic_weight * M, where
+    E and M are the electric and magnetic field boundary operators.
+    Both are assembled in a single pass over all pairs of elements,
+    which avoids evaluating the Green's function and the basis
+    functions twice. This is the main building block of combined
+    field integral equations (CFIE).
+
+    Parameters
+    ----------
+    domain : bempp.api.Space
+        The domain space. Must be an RWG space.
+    range_ : bempp.api.Space
+        The range space.
+    dual_to_range : bempp.api.Space
+        The dual to range space. Must be an SNC space.
+    wavenumber : complex
+        A real or complex wavenumber.
+    electric_weight : complex
+        The weight of the electric field operator.
+    magnetic_weight : complex
+        The weight of the magnetic field operator.
+    parameters : Parameters
+        An optional parameters object.
+    assembler : string
+        The assembler type.
+    device_interface : DeviceInterface
+        The device interface object to be used.
+    precision : string
+        Either "single" or "double" for single or
+        double precision mode.
+
+    """
+    if domain.identifier != "rwg0":
+        raise ValueError("Domain space must be an RWG type function space.")
+
+    if dual_to_range.identifier != "snc0":
+        raise ValueError("Dual to range space must be an SNC type function space.")
+
+    return _common.create_operator(
+        "maxwell_combined_field_boundary",
+        domain,
+        range_,
+        dual_to_range,
+        parameters,
+        assembler,
+        [
+            _np.real(wavenumber),
+            _np.imag(wavenumber),
+            _np.real(electric_weight),
+            _np.imag(electric_weight),
+            _np.real(magnetic_weight),
+            _np.imag(magnetic_weight),
+        ],
+        "helmholtz_single_layer",
+        "maxwell_combined_field",
+        device_interface,
+        precision,
+        True,
+    )
+
+
 def multitrace_operator(
     grid,
     wavenumber,
@@ -55,6 +55,66 @@ def rwg0_function_space(
     )
 
 
+def rwg1_function_space(
+    grid,
+    support_elements=None,
+    segments=None,
+    swapped_normals=None,
+    include_boundary_dofs=False,
+    truncate_at_segment_edge=True,
+):
+    """
+    Define a space of linear div-conforming functions.
+
+    Each edge carries two dofs, the RWG function of the edge and a
+    hierarchical function whose normal component varies linearly along
+    the edge. Together they span the linear div-conforming (BDM1) space.
+    """
+    from .space import SpaceBuilder, _process_segments
+    from bempp.api.utils.helpers import serialise_list_of_lists
+
+    support, normal_multipliers = _process_segments(
+        grid, support_elements, segments, swapped_normals
+    )
+
+    edge_neighbors, edge_neighbors_ptr = serialise_list_of_lists(grid.edge_neighbors)
+
+    (
+        global_dof_count,
+        support,
+        local2global,
+        local_multipliers,
+    ) = _compute_rwg0_space_data(
+        support,
+        edge_neighbors,
+        edge_neighbors_ptr,
+        grid.element_edges,
+        grid.number_of_elements,
+        grid.number_of_edges,
+        include_boundary_dofs,
+        truncate_at_segment_edge,
+    )
+
+    local2global, local_multipliers = _compute_rwg1_space_data(
+        grid.elements, local2global, local_multipliers
+    )
+
+    return (
+        SpaceBuilder(grid)
+        .set_codomain_dimension(3)
+        .set_support(support)
+        .set_normal_multipliers(normal_multipliers)
+        .set_order(1)
+        .set_is_localised(False)
+        .set_shapeset("rwg1")
+        .set_identifier("rwg1")
+        .set_local2global(local2global)
+        .set_local_multipliers(local_multipliers)
+        .set_numba_evaluator(_numba_rwg1_evaluate)
+        .build()
+    )
+
+
 def rwg0_barycentric_function_space(coarse_space):
     """Define a space of RWG functions of order 0 over a barycentric grid."""
     from .space import SpaceBuilder
@@ -680,6 +740,39 @@ def _compute_rwg0_space_data(
     return dof_count, support, local2global_map, local_multipliers
 
 
+@_numba.njit(cache=True)
+def _compute_rwg1_space_data(elements, local2global_map, local_multipliers):
+    """
+    Extend the RWG0 local2global map to the RWG1 space.
+
+    The RWG0 dof of an edge becomes dof 2 * i, the hierarchical function
+    of the edge dof 2 * i + 1. The sign of the hierarchical function is
+    chosen such that it is linear from the edge vertex with the smaller
+    index to the vertex with the larger index in both neighbouring elements.
+    """
+    edge_local = _np.array([[0, 1], [2, 0], [1, 2]])
+    number_of_elements = local2global_map.shape[0]
+
+    rwg1_local2global = _np.zeros((number_of_elements, 6), dtype=_np.uint32)
+    rwg1_local_multipliers = _np.zeros((number_of_elements, 6), dtype=_np.float64)
+
+    for element_index in range(number_of_elements):
+        for local_index in range(3):
+            dof = local2global_map[element_index, local_index]
+            multiplier = local_multipliers[element_index, local_index]
+            first = elements[edge_local[local_index, 0], element_index]
+            second = elements[edge_local[local_index, 1], element_index]
+            orientation = 1 if first < second else -1
+            rwg1_local2global[element_index, local_index] = 2 * dof
+            rwg1_local2global[element_index, 3 + local_index] = 2 * dof + 1
+            rwg1_local_multipliers[element_index, local_index] = multiplier
+            rwg1_local_multipliers[element_index, 3 + local_index] = (
+                orientation * multiplier
+            )
+
+    return rwg1_local2global, rwg1_local_multipliers
+
+
 @_numba.njit(cache=True)
 def generate_rwg0_map(grid_data, support_elements, local_coords, coeffs):
     """Actually generate the sparse matrix data."""
@@ -774,6 +867,44 @@ def _numba_rwg0_evaluate(
     return result
 
 
+@_numba.njit()
+def _numba_rwg1_evaluate(
+    element_index,
+    shapeset_evaluate,
+    local_coordinates,
+    grid_data,
+    local_multipliers,
+    normal_multipliers,
+):
+    """Evaluate the basis on an element."""
+    reference_values = shapeset_evaluate(local_coordinates)
+    npoints = local_coordinates.shape[1]
+    result = _np.empty((3, 6, npoints), dtype=_np.float64)
+
+    edge_lengths = _np.empty(3, dtype=_np.float64)
+    edge_lengths[0] = _np.linalg.norm(
+        grid_data.vertices[:, grid_data.elements[0, element_index]]
+        - grid_data.vertices[:, grid_data.elements[1, element_index]]
+    )
+    edge_lengths[1] = _np.linalg.norm(
+        grid_data.vertices[:, grid_data.elements[2, element_index]]
+        - grid_data.vertices[:, grid_data.elements[0, element_index]]
+    )
+    edge_lengths[2] = _np.linalg.norm(
+        grid_data.vertices[:, grid_data.elements[1, element_index]]
+        - grid_data.vertices[:, grid_data.elements[2, element_index]]
+    )
+
+    for index in range(6):
+        result[:, index, :] = (
+            local_multipliers[element_index, index]
+            * edge_lengths[index % 3]
+            / grid_data.integration_elements[element_index]
+            * grid_data.jacobians[element_index].dot(reference_values[:, index, :])
+        )
+    return result
+
+
 @_numba.njit()
 def _numba_snc0_evaluate(
     element_index,
@@ -450,6 +450,313 @@ def _compute_p1_dof_map(
     return local2global_final, local_multipliers, support_final
 
 
+@_timeit
+def p2_discontinuous_function_space(
+    grid,
+    support_elements=None,
+    segments=None,
+    swapped_normals=None,
+    include_boundary_dofs=None,
+    truncate_at_segment_edge=None,
+):
+    """Define a discontinuous space of piecewise quadratic functions."""
+    return _higher_order_discontinuous_function_space(
+        grid,
+        2,
+        support_elements,
+        segments,
+        swapped_normals,
+        include_boundary_dofs,
+        truncate_at_segment_edge,
+    )
+
+
+@_timeit
+def p3_discontinuous_function_space(
+    grid,
+    support_elements=None,
+    segments=None,
+    swapped_normals=None,
+    include_boundary_dofs=None,
+    truncate_at_segment_edge=None,
+):
+    """Define a discontinuous space of piecewise cubic functions."""
+    return _higher_order_discontinuous_function_space(
+        grid,
+        3,
+        support_elements,
+        segments,
+        swapped_normals,
+        include_boundary_dofs,
+        truncate_at_segment_edge,
+    )
+
+
+@_timeit
+def p2_continuous_function_space(
+    grid,
+    support_elements=None,
+    segments=None,
+    swapped_normals=None,
+    include_boundary_dofs=False,
+    truncate_at_segment_edge=True,
+):
+    """Define a space of continuous piecewise quadratic functions."""
+    return _higher_order_continuous_function_space(
+        grid,
+        2,
+        support_elements,
+        segments,
+        swapped_normals,
+        include_boundary_dofs,
+        truncate_at_segment_edge,
+    )
+
+
+@_timeit
+def p3_continuous_function_space(
+    grid,
+    support_elements=None,
+    segments=None,
+    swapped_normals=None,
+    include_boundary_dofs=False,
+    truncate_at_segment_edge=True,
+):
+    """Define a space of continuous piecewise cubic functions."""
+    return _higher_order_continuous_function_space(
+        grid,
+        3,
+        support_elements,
+        segments,
+        swapped_normals,
+        include_boundary_dofs,
+        truncate_at_segment_edge,
+    )
+
+
+def _higher_order_discontinuous_function_space(
+    grid,
+    order,
+    support_elements,
+    segments,
+    swapped_normals,
+    include_boundary_dofs,
+    truncate_at_segment_edge,
+):
+    """Define a discontinuous Lagrange space of order 2 or 3."""
+    from .space import SpaceBuilder, _process_segments
+
+    if include_boundary_dofs is not None:
+        log(
+            "Setting include_boundary_dofs has no effect on this space type.", "warning"
+        )
+    if truncate_at_segment_edge is not None:
+        log(
+            "Setting truncate_at_segment_edge has no effect on this space type.",
+            "warning",
+        )
+
+    support, normal_multipliers = _process_segments(
+        grid, support_elements, segments, swapped_normals
+    )
+
+    nshape = (order + 1) * (order + 2) // 2
+
+    elements_in_support = _np.flatnonzero(support)
+    support_size = len(elements_in_support)
+
+    local2global = _np.zeros((grid.number_of_elements, nshape), dtype="uint32")
+    local2global[support] = _np.arange(nshape * support_size).reshape(
+        support_size, nshape
+    )
+
+    local_multipliers = _np.zeros((grid.number_of_elements, nshape), dtype="float64")
+    local_multipliers[support] = 1
+
+    return (
+        SpaceBuilder(grid)
+        .set_codomain_dimension(1)
+        .set_support(support)
+        .set_normal_multipliers(normal_multipliers)
+        .set_order(order)
+        .set_is_localised(True)
+        .set_shapeset(f"p{order}_discontinuous")
+        .set_identifier(f"p{order}_discontinuous")
+        .set_local2global(local2global)
+        .set_local_multipliers(local_multipliers)
+        .set_numba_surface_gradient(_numba_lagrange_surface_gradient)
+        .build()
+    )
+
+
+def _higher_order_continuous_function_space(
+    grid,
+    order,
+    support_elements,
+    segments,
+    swapped_normals,
+    include_boundary_dofs,
+    truncate_at_segment_edge,
+):
+    """Define a continuous Lagrange space of order 2 or 3."""
+    from .space import SpaceBuilder, _process_segments
+    from bempp.api.utils.helpers import serialise_list_of_lists
+
+    if not truncate_at_segment_edge:
+        raise ValueError(
+            "truncate_at_segment_edge=False is only supported for order 1 spaces."
+        )
+
+    support, normal_multipliers = _process_segments(
+        grid, support_elements, segments, swapped_normals
+    )
+
+    vertex_neighbors, vertex_index_ptr = grid.vertex_neighbors
+    edge_neighbors, edge_index_ptr = serialise_list_of_lists(grid.edge_neighbors)
+
+    local2global, local_multipliers, support = _compute_lagrange_dof_map(
+        grid.elements,
+        grid.element_edges,
+        grid.vertex_on_boundary,
+        grid.number_of_edges,
+        support,
+        order,
+        include_boundary_dofs,
+        vertex_neighbors,
+        vertex_index_ptr,
+        edge_neighbors,
+        edge_index_ptr,
+    )
+
+    return (
+        SpaceBuilder(grid)
+        .set_codomain_dimension(1)
+        .set_support(support)
+        .set_normal_multipliers(normal_multipliers)
+        .set_order(order)
+        .set_is_localised(False)
+        .set_shapeset(f"p{order}_discontinuous")
+        .set_identifier(f"p{order}_continuous")
+        .set_local2global(local2global)
+        .set_local_multipliers(local_multipliers)
+        .set_numba_surface_gradient(_numba_lagrange_surface_gradient)
+        .build()
+    )
+
+
+@_timeit
+@_numba.njit(cache=True)
+def _compute_lagrange_dof_map(
+    elements,
+    element_edges,
+    vertex_on_boundary,
+    number_of_edges,
+    support,
+    order,
+    include_boundary_dofs,
+    vertex_neighbors,
+    vertex_index_ptr,
+    edge_neighbors,
+    edge_index_ptr,
+):
+    """
+    Compute the local2global and local_multipliers maps for P2 and P3 spaces.
+
+    Each vertex carries one dof, each edge order - 1 dofs and each element
+    the remaining interior dofs. The dofs on an edge are numbered from the
+    vertex with the smaller index to the vertex with the larger index, so
+    that neighbouring elements agree on them.
+    """
+    edge_local = _np.array([[0, 1], [2, 0], [1, 2]])
+
+    number_of_elements = elements.shape[1]
+    number_of_vertices = vertex_on_boundary.shape[0]
+    dofs_per_edge = order - 1
+    nshape = (order + 1) * (order + 2) // 2
+    interior_offset = 3 + 3 * dofs_per_edge
+
+    vertex_dofs = -_np.ones(number_of_vertices, dtype=_np.int64)
+    edge_dofs = -_np.ones(number_of_edges, dtype=_np.int64)
+    visited_vertices = _np.zeros(number_of_vertices, dtype=_np.bool_)
+    visited_edges = _np.zeros(number_of_edges, dtype=_np.bool_)
+    element_dofs = -_np.ones(number_of_elements, dtype=_np.int64)
+
+    dof_count = 0
+    for element_index in range(number_of_elements):
+        if not support[element_index]:
+            continue
+        for local_index in range(3):
+            vertex = elements[local_index, element_index]
+            if visited_vertices[vertex]:
+                continue
+            visited_vertices[vertex] = True
+            is_interior = not vertex_on_boundary[vertex]
+            for neighbor in vertex_neighbors[
+                vertex_index_ptr[vertex] : vertex_index_ptr[vertex + 1]
+            ]:
+                if not support[neighbor]:
+                    is_interior = False
+            if is_interior or include_boundary_dofs:
+                vertex_dofs[vertex] = dof_count
+                dof_count += 1
+        for local_index in range(3):
+            edge = element_edges[local_index, element_index]
+            if visited_edges[edge]:
+                continue
+            visited_edges[edge] = True
+            neighbors = edge_neighbors[edge_index_ptr[edge] : edge_index_ptr[edge + 1]]
+            is_interior = len(neighbors) == 2
+            for neighbor in neighbors:
+                if not support[neighbor]:
+                    is_interior = False
+            if is_interior or include_boundary_dofs:
+                edge_dofs[edge] = dof_count
+                dof_count += dofs_per_edge
+        if nshape > interior_offset:
+            element_dofs[element_index] = dof_count
+            dof_count += nshape - interior_offset
+
+    support_final = _np.zeros(number_of_elements, dtype=_np.bool_)
+    local2global = _np.zeros((number_of_elements, nshape), dtype=_np.uint32)
+    local_multipliers = _np.zeros((number_of_elements, nshape), dtype=_np.float64)
+
+    for element_index in range(number_of_elements):
+        if not support[element_index]:
+            continue
+        dofmap = -_np.ones(nshape, dtype=_np.int64)
+        for local_index in range(3):
+            dofmap[local_index] = vertex_dofs[elements[local_index, element_index]]
+        for local_index in range(3):
+            edge_dof = edge_dofs[element_edges[local_index, element_index]]
+            if edge_dof == -1:
+                continue
+            first = elements[edge_local[local_index, 0], element_index]
+            second = elements[edge_local[local_index, 1], element_index]
+            for index in range(dofs_per_edge):
+                if first < second:
+                    offset = index
+                else:
+                    offset = dofs_per_edge - 1 - index
+                dofmap[3 + local_index * dofs_per_edge + index] = edge_dof + offset
+        if element_dofs[element_index] != -1:
+            for index in range(nshape - interior_offset):
+                dofmap[interior_offset + index] = element_dofs[element_index] + index
+        if _np.max(dofmap) == -1:
+            continue
+        # Unused local dofs are mapped to an existing dof in the element
+        # with multiplier zero, as in the P1 space.
+        support_final[element_index] = True
+        max_dof = _np.max(dofmap)
+        for local_index in range(nshape):
+            if dofmap[local_index] == -1:
+                local2global[element_index, local_index] = max_dof
+            else:
+                local2global[element_index, local_index] = dofmap[local_index]
+                local_multipliers[element_index, local_index] = 1
+
+    return local2global, local_multipliers, support_final
+
+
 @_numba.njit
 def _numba_p0_surface_gradient(
     element_index,
@@ -480,3 +787,23 @@ def _numba_p1_surface_gradient(
             reference_values[0, :, index, :]
         )
     return result
+
+
+@_numba.njit
+def _numba_lagrange_surface_gradient(
+    element_index,
+    shapeset_gradient,
+    local_coordinates,
+    grid_data,
+    local_multipliers,
+    normal_multipliers,
+):
+    """Evaluate the surface gradient of a Lagrange space of any order."""
+    reference_values = shapeset_gradient(local_coordinates)
+    nshape = reference_values.shape[2]
+    result = _np.empty((1, 3, nshape, local_coordinates.shape[1]), dtype=_np.float64)
+    for index in range(nshape):
+        result[0, :, index, :] = grid_data.jac_inv_trans[element_index].dot(
+            reference_values[0, :, index, :]
+        )
+    return result
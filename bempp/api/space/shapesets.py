@@ -16,6 +16,7 @@ class Shapeset(object):
         self._number_of_shape_functions = data["number_of_shape_functions"]
         self._identifier = data["identifier"]
         self._dimension = data["dimension"]
+        self._degree = data["degree"]
 
     @property
     def evaluate(self):
@@ -42,6 +43,32 @@ class Shapeset(object):
         """Return the dimension of the shapeset."""
         return self._dimension
 
+    @property
+    def degree(self):
+        """Return the polynomial degree of the shapeset."""
+        return self._degree
+
+
+# Local vertices of the edges of the reference element. This is the
+# same edge numbering as used by the grid.
+_EDGE_VERTICES = _np.array([[0, 1], [2, 0], [1, 2]])
+
+# Vertices of the reference element.
+_REFERENCE_VERTICES = _np.array([[0.0, 0.0], [1.0, 0.0], [0.0, 1.0]])
+
+# Gradients of the barycentric coordinates on the reference element.
+_BARYCENTRIC_GRADIENTS = _np.array([[-1.0, -1.0], [1.0, 0.0], [0.0, 1.0]])
+
+
+@_numba.njit
+def _barycentric_coordinates(local_coordinates):
+    """Return the barycentric coordinates of points on the reference element."""
+    bary = _np.empty((3, local_coordinates.shape[1]), dtype=local_coordinates.dtype)
+    bary[0] = 1 - local_coordinates[0] - local_coordinates[1]
+    bary[1] = local_coordinates[0]
+    bary[2] = local_coordinates[1]
+    return bary
+
 
 @_numba.njit
 def _p0_shapeset_evaluate(local_coordinates):
@@ -94,6 +121,104 @@ def _p1_disc_shapeset_gradient(local_coordinates):
     return grad
 
 
+@_numba.njit
+def _p2_disc_shapeset_evaluate(local_coordinates):
+    """
+    Evaluate P2 discontinuous shapeset.
+
+    The first three functions are associated with the vertices and the
+    last three with the midpoints of the edges.
+    """
+    bary = _barycentric_coordinates(local_coordinates)
+    vals = _np.empty((1, 6, local_coordinates.shape[1]), dtype=local_coordinates.dtype)
+    for vertex in range(3):
+        vals[0, vertex] = bary[vertex] * (2 * bary[vertex] - 1)
+    for edge in range(3):
+        first, second = _EDGE_VERTICES[edge]
+        vals[0, 3 + edge] = 4 * bary[first] * bary[second]
+    return vals
+
+
+@_numba.njit
+def _p2_disc_shapeset_gradient(local_coordinates):
+    """Evaluate P2 discontinuous shapeset gradient."""
+    bary = _barycentric_coordinates(local_coordinates)
+    grad = _np.empty(
+        (1, 2, 6, local_coordinates.shape[1]), dtype=local_coordinates.dtype
+    )
+    for dim in range(2):
+        for vertex in range(3):
+            grad[0, dim, vertex] = (4 * bary[vertex] - 1) * _BARYCENTRIC_GRADIENTS[
+                vertex, dim
+            ]
+        for edge in range(3):
+            first, second = _EDGE_VERTICES[edge]
+            grad[0, dim, 3 + edge] = 4 * (
+                bary[first] * _BARYCENTRIC_GRADIENTS[second, dim]
+                + bary[second] * _BARYCENTRIC_GRADIENTS[first, dim]
+            )
+    return grad
+
+
+@_numba.njit
+def _p3_disc_shapeset_evaluate(local_coordinates):
+    """
+    Evaluate P3 discontinuous shapeset.
+
+    The first three functions are associated with the vertices, followed
+    by two functions for each edge, ordered from the first to the second
+    vertex of the edge, and the bubble function at the centroid.
+    """
+    bary = _barycentric_coordinates(local_coordinates)
+    vals = _np.empty((1, 10, local_coordinates.shape[1]), dtype=local_coordinates.dtype)
+    for vertex in range(3):
+        vals[0, vertex] = (
+            0.5 * bary[vertex] * (3 * bary[vertex] - 1) * (3 * bary[vertex] - 2)
+        )
+    for edge in range(3):
+        first, second = _EDGE_VERTICES[edge]
+        vals[0, 3 + 2 * edge] = 4.5 * bary[first] * bary[second] * (3 * bary[first] - 1)
+        vals[0, 4 + 2 * edge] = (
+            4.5 * bary[first] * bary[second] * (3 * bary[second] - 1)
+        )
+    vals[0, 9] = 27 * bary[0] * bary[1] * bary[2]
+    return vals
+
+
+@_numba.njit
+def _p3_disc_shapeset_gradient(local_coordinates):
+    """Evaluate P3 discontinuous shapeset gradient."""
+    bary = _barycentric_coordinates(local_coordinates)
+    grad = _np.empty(
+        (1, 2, 10, local_coordinates.shape[1]), dtype=local_coordinates.dtype
+    )
+    for dim in range(2):
+        for vertex in range(3):
+            grad[0, dim, vertex] = (
+                0.5
+                * (27 * bary[vertex] ** 2 - 18 * bary[vertex] + 2)
+                * _BARYCENTRIC_GRADIENTS[vertex, dim]
+            )
+        for edge in range(3):
+            first, second = _EDGE_VERTICES[edge]
+            first_grad = _BARYCENTRIC_GRADIENTS[first, dim]
+            second_grad = _BARYCENTRIC_GRADIENTS[second, dim]
+            grad[0, dim, 3 + 2 * edge] = 4.5 * (
+                (6 * bary[first] - 1) * bary[second] * first_grad
+                + bary[first] * (3 * bary[first] - 1) * second_grad
+            )
+            grad[0, dim, 4 + 2 * edge] = 4.5 * (
+                (6 * bary[second] - 1) * bary[first] * second_grad
+                + bary[second] * (3 * bary[second] - 1) * first_grad
+            )
+        grad[0, dim, 9] = 27 * (
+            bary[1] * bary[2] * _BARYCENTRIC_GRADIENTS[0, dim]
+            + bary[0] * bary[2] * _BARYCENTRIC_GRADIENTS[1, dim]
+            + bary[0] * bary[1] * _BARYCENTRIC_GRADIENTS[2, dim]
+        )
+    return grad
+
+
 @_numba.njit
 def _rwg0_shapeset_evaluate(local_coordinates):
     """Evaluate RWG 0 shapeset."""
@@ -121,6 +246,55 @@ def _rwg0_shapeset_gradient(local_coordinates):
     return grad
 
 
+@_numba.njit
+def _rwg1_shapeset_evaluate(local_coordinates):
+    """
+    Evaluate RWG 1 shapeset.
+
+    This is a hierarchical basis of the linear div-conforming (BDM 1)
+    functions. For an edge from vertex a to vertex b opposite to vertex c
+    the BDM 1 functions are lambda_a (v_a - v_c) and lambda_b (v_b - v_c).
+    The first three functions are their sums, which are the RWG 0
+    functions. The last three are their differences, whose normal
+    component varies linearly along the edge.
+    """
+    bary = _barycentric_coordinates(local_coordinates)
+    rwg0 = _rwg0_shapeset_evaluate(local_coordinates)
+    vals = _np.empty((2, 6, local_coordinates.shape[1]), dtype=local_coordinates.dtype)
+    vals[:, :3, :] = rwg0
+    for edge in range(3):
+        first, second = _EDGE_VERTICES[edge]
+        opposite = 3 - first - second
+        for dim in range(2):
+            vals[dim, 3 + edge] = bary[first] * (
+                _REFERENCE_VERTICES[first, dim] - _REFERENCE_VERTICES[opposite, dim]
+            ) - bary[second] * (
+                _REFERENCE_VERTICES[second, dim] - _REFERENCE_VERTICES[opposite, dim]
+            )
+    return vals
+
+
+@_numba.njit
+def _rwg1_shapeset_gradient(local_coordinates):
+    """Evaluate RWG 1 shapeset gradient."""
+    npoints = local_coordinates.shape[1]
+    grad = _np.zeros((2, 2, 6, npoints), dtype=local_coordinates.dtype)
+    for edge in range(3):
+        first, second = _EDGE_VERTICES[edge]
+        opposite = 3 - first - second
+        for component in range(2):
+            grad[component, component, edge] = 1
+            for dim in range(2):
+                grad[component, dim, 3 + edge] = _BARYCENTRIC_GRADIENTS[first, dim] * (
+                    _REFERENCE_VERTICES[first, component]
+                    - _REFERENCE_VERTICES[opposite, component]
+                ) - _BARYCENTRIC_GRADIENTS[second, dim] * (
+                    _REFERENCE_VERTICES[second, component]
+                    - _REFERENCE_VERTICES[opposite, component]
+                )
+    return grad
+
+
 _SHAPESETS = {
     "p0_discontinuous": {
         "evaluate": _p0_shapeset_evaluate,
@@ -128,6 +302,7 @@ _SHAPESETS = {
         "number_of_shape_functions": 1,
         "identifier": "p0_discontinuous",
         "dimension": 1,
+        "degree": 0,
     },
     "p1_discontinuous": {
         "evaluate": _p1_disc_shapeset_evaluate,
@@ -135,6 +310,23 @@ _SHAPESETS = {
         "number_of_shape_functions": 3,
         "identifier": "p1_discontinuous",
         "dimension": 1,
+        "degree": 1,
+    },
+    "p2_discontinuous": {
+        "evaluate": _p2_disc_shapeset_evaluate,
+        "gradient": _p2_disc_shapeset_gradient,
+        "number_of_shape_functions": 6,
+        "identifier": "p2_discontinuous",
+        "dimension": 1,
+        "degree": 2,
+    },
+    "p3_discontinuous": {
+        "evaluate": _p3_disc_shapeset_evaluate,
+        "gradient": _p3_disc_shapeset_gradient,
+        "number_of_shape_functions": 10,
+        "identifier": "p3_discontinuous",
+        "dimension": 1,
+        "degree": 3,
     },
     "rwg0": {
         "evaluate": _rwg0_shapeset_evaluate,
@@ -142,5 +334,14 @@ _SHAPESETS = {
         "number_of_shape_functions": 3,
         "identifier": "rwg0",
         "dimension": 2,
+        "degree": 1,
+    },
+    "rwg1": {
+        "evaluate": _rwg1_shapeset_evaluate,
+        "gradient": _rwg1_shapeset_gradient,
+        "number_of_shape_functions": 6,
+        "identifier": "rwg1",
+        "dimension": 2,
+        "degree": 1,
     },
 }
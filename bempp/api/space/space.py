@@ -49,10 +49,18 @@ def function_space(grid, kind, degree, scatter=True, **kwargs):
             space_f = scalar_spaces.p0_discontinuous_function_space
         if degree == 1:
             space_f = scalar_spaces.p1_discontinuous_function_space
+        if degree == 2:
+            space_f = scalar_spaces.p2_discontinuous_function_space
+        if degree == 3:
+            space_f = scalar_spaces.p3_discontinuous_function_space
 
     if kind == "P":
         if degree == 1:
             space_f = scalar_spaces.p1_continuous_function_space
+        if degree == 2:
+            space_f = scalar_spaces.p2_continuous_function_space
+        if degree == 3:
+            space_f = scalar_spaces.p3_continuous_function_space
 
     if kind == "DUAL":
         if degree == 0:
@@ -64,6 +72,10 @@ def function_space(grid, kind, degree, scatter=True, **kwargs):
         if degree == 0:
             space_f = maxwell_spaces.rwg0_function_space
 
+    if kind == "RWG":
+        if degree == 1:
+            space_f = maxwell_spaces.rwg1_function_space
+
     if kind == "SNC" or kind == "NC":
         if degree == 0:
             space_f = maxwell_spaces.snc0_function_space
@@ -327,6 +339,7 @@ class FunctionSpace(object):
         self._requires_dof_transformation = requires_dof_transformation
         self._is_barycentric = is_barycentric
         self._barycentric_representation = barycentric_representation
+        self._barycentric_representation_factory = barycentric_representation
         self._dof_transformation = dof_transformation
         self._numba_evaluate = numba_evaluator
         self._numba_surface_gradient = numba_surface_gradient
@@ -338,8 +351,8 @@ class FunctionSpace(object):
         self._id = create_unique_id()
         self._hash_string = None
         self._color_map = None
-        self._mass_matrix = None
-        self._inverse_mass_matrix = None
+        self._mass_matrices = {}
+        self._inverse_mass_matrices = {}
         self._sorted_indices = None
         self._indexptr = None
         self._is_scattered = False
@@ -641,26 +654,102 @@ class FunctionSpace(object):
             self.normal_multipliers,
         )
 
-    def mass_matrix(self):
-        """Return the mass matrix associated with this space."""
-        if self._mass_matrix is None:
+    def mass_matrix(self, dual_space=None):
+        """
+        Return the mass matrix associated with this space.
+
+        If dual_space is given, return the mass matrix between this
+        space and the dual space. The result is cached in this space.
+        """
+        if dual_space is None:
+            dual_space = self
+
+        if dual_space.id not in self._mass_matrices:
             from bempp.api.operators.boundary.sparse import identity
 
-            self._mass_matrix = identity(self, self, self).weak_form()
+            self._mass_matrices[dual_space.id] = identity(
+                self, self, dual_space
+            ).weak_form()
 
-        return self._mass_matrix
+        return self._mass_matrices[dual_space.id]
 
-    def inverse_mass_matrix(self):
-        """Return the inverse mass matrix for this space."""
+    def inverse_mass_matrix(self, dual_space=None, lumped=False):
+        """
+        Return the inverse mass matrix for this space.
+
+        The factorization of the mass matrix is computed once and cached
+        in this space, so that all operators and blocked operators with
+        this range space share it. For discontinuous spaces the mass
+        matrix is block diagonal and is inverted element by element.
+
+        Parameters
+        ----------
+        dual_space : Space
+            The dual space of the mass matrix. By default this space.
+        lumped : bool
+            If True, return the inverse of the diagonal matrix of row sums
+            of the mass matrix. This is exact for DP0 spaces and an
+            approximation otherwise.
+        """
         from bempp.api.assembly.discrete_boundary_operator import (
+            DiagonalOperator,
             InverseSparseDiscreteBoundaryOperator,
+            SparseDiscreteBoundaryOperator,
         )
 
-        if self._inverse_mass_matrix is None:
-            self._inverse_mass_matrix = InverseSparseDiscreteBoundaryOperator(
-                self.mass_matrix()
-            )
-        return self._inverse_mass_matrix
+        if dual_space is None:
+            dual_space = self
+
+        key = (dual_space.id, lumped)
+
+        if key not in self._inverse_mass_matrices:
+            mass_matrix = self.mass_matrix(dual_space)
+            if lumped:
+                if mass_matrix.shape[0] != mass_matrix.shape[1]:
+                    raise ValueError("Lumped mass matrices must be square.")
+                self._inverse_mass_matrices[key] = DiagonalOperator(
+                    1.0 / _np.ravel(mass_matrix.to_sparse().sum(axis=1))
+                )
+            elif dual_space.id == self.id and self._has_element_local_dofs():
+                self._inverse_mass_matrices[key] = SparseDiscreteBoundaryOperator(
+                    _invert_block_diagonal(
+                        mass_matrix.to_sparse(),
+                        self.local2global[self.support_elements],
+                    )
+                )
+            else:
+                self._inverse_mass_matrices[
+                    key
+                ] = InverseSparseDiscreteBoundaryOperator(mass_matrix)
+
+        return self._inverse_mass_matrices[key]
+
+    def _has_element_local_dofs(self):
+        """Return true if each global dof belongs to exactly one element."""
+        if self.requires_dof_transformation:
+            return False
+        dofs = self.local2global[self.support_elements].ravel()
+        return len(_np.unique(dofs)) == len(dofs) == self.global_dof_count
+
+    def deform(self, grid):
+        """
+        Return this space defined on a deformed grid.
+
+        The grid must have the same topology as the grid of this
+        space, for example because it was created with Grid.deform.
+        The dof maps and the element coloring of this space are reused.
+        """
+        if not self.grid.has_same_topology(grid):
+            raise ValueError("Grid does not have the same topology as the space grid.")
+
+        if self.is_barycentric:
+            raise ValueError("Barycentric spaces cannot be deformed.")
+
+        space = _copy_space_to_grid(self, grid)
+        if self._localised_space is not self:
+            _copy_coloring(self._localised_space, space._localised_space)
+
+        return space
 
     def _generate_hash(self):
         """Generate a hash for the space object."""
@@ -909,6 +998,62 @@ def invert_local2global(local2global_map, local_multipliers):
     return global2local_map
 
 
+def _invert_block_diagonal(mat, element_dofs):
+    """
+    Invert a sparse matrix that is block diagonal with respect to elements.
+
+    The array element_dofs contains in each row the dofs of one block.
+    """
+    from scipy.sparse import coo_matrix
+
+    nblocks, block_size = element_dofs.shape
+    mat = mat.tocsr()
+
+    rows = _np.repeat(element_dofs, block_size, axis=1).ravel()
+    cols = _np.tile(element_dofs, (1, block_size)).ravel()
+
+    blocks = _np.asarray(mat[rows, cols]).reshape(nblocks, block_size, block_size)
+    inverse_blocks = _np.linalg.inv(blocks)
+
+    return coo_matrix(
+        (inverse_blocks.ravel(), (rows, cols)), shape=mat.shape, dtype=mat.dtype
+    ).tocsr()
+
+
+def _copy_space_to_grid(space, grid):
+    """Create a copy of a space on a grid with the same topology."""
+    new_space = FunctionSpace.__new__(FunctionSpace)
+    new_space.__init__(
+        grid,
+        space.codomain_dimension,
+        space.order,
+        space.shapeset.identifier,
+        space.local2global,
+        space._global2local_map,
+        space.local_multipliers,
+        space.identifier,
+        space._localised_space is space,
+        space.support,
+        space.normal_multipliers,
+        space.requires_dof_transformation,
+        space.is_barycentric,
+        space._barycentric_representation_factory,
+        space.dof_transformation,
+        space.numba_evaluate,
+        space._numba_surface_gradient,
+        space.collocation_points,
+    )
+    _copy_coloring(space, new_space)
+    return new_space
+
+
+def _copy_coloring(space, new_space):
+    """Reuse the element coloring of a space for a space with the same dofs."""
+    new_space._color_map = space._color_map
+    new_space._sorted_indices = space._sorted_indices
+    new_space._indexptr = space._indexptr
+
+
 def make_localised_space(space):
     """Return the associated localised space."""
     number_of_elements = space.grid.number_of_elements
@@ -136,12 +136,10 @@ def get_mass_matrix(domain, dual_to_range):
     space in order to allow quick caching.
 
     """
-    from bempp.api.operators.boundary.sparse import identity
-
     if domain == dual_to_range:
         return domain.mass_matrix()
     else:
-        return identity(domain, domain, dual_to_range).weak_form()
+        return domain.mass_matrix(dual_to_range)
 
 
 def get_inverse_mass_matrix(domain, dual_to_range):
@@ -151,13 +149,7 @@ def get_inverse_mass_matrix(domain, dual_to_range):
     Uses the cached version from a function space if
     possible.
     """
-    from bempp.api.assembly.discrete_boundary_operator import (
-        InverseSparseDiscreteBoundaryOperator,
-    )
-
     if domain == dual_to_range:
         return domain.inverse_mass_matrix()
     else:
-        return InverseSparseDiscreteBoundaryOperator(
-            get_mass_matrix(domain, dual_to_range)
-        )
+        return domain.inverse_mass_matrix(dual_to_range)
@@ -0,0 +1,378 @@
+"""
+Structured instrumentation of Bempp runs.
+
+Inside a recording, Bempp opens nested spans for the phases of its
+computations (assembly, singular rule setup, kernel builds, uploads,
+kernel runs, scatters, ...) and increments counters such as the number
+of element pairs, FMM calls or GMRES matrix-vector products. Each span
+records its duration, the counters incremented while it was open, the
+peak resident memory of the process while it was open and the device
+memory allocated within it.
+
+Example
+-------
+>>> from bempp.api.utils import instrumentation
+>>> with instrumentation.record() as profile:
+...     op.weak_form()
+>>> profile.total_time("assembly")
+>>> profile.counters["element pairs"]
+>>> profile.to_chrome_trace("trace.json")
+
+Spans are recorded for the thread that opens them. Worker threads attach
+their spans and counters to a span of the thread that started them by
+opening them inside attach(current_span()). Work done in worker
+processes of a Bempp pool is not recorded. Outside of a recording all
+instrumentation calls return immediately.
+"""
+
+import contextlib as _contextlib
+import json as _json
+import os as _os
+import threading as _threading
+import time as _time
+
+_PROFILE = None
+_LOCK = _threading.Lock()
+_LOCAL = _threading.local()
+
+
+def resident_memory():
+    """Return the resident memory of this process in bytes (None if unknown)."""
+    try:
+        import psutil
+
+        return psutil.Process(_os.getpid()).memory_info()[0]
+    except ImportError:
+        pass
+    try:
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * _os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError):
+        return None
+
+
+class Span(object):
+    """A timed and nested section of a computation."""
+
+    def __init__(self, name, attributes=None, thread_id=None):
+        """Create a span."""
+        self.name = name
+        self.attributes = attributes if attributes is not None else {}
+        self.thread_id = thread_id
+        self.start = None
+        self.end = None
+        self.children = []
+        self.counters = {}
+        self.start_rss = None
+        self.peak_rss = None
+        self.device_memory = 0
+
+    @property
+    def duration(self):
+        """Return the duration in seconds."""
+        if self.start is None or self.end is None:
+            return None
+        return self.end - self.start
+
+    @property
+    def rss_increase(self):
+        """Return the peak increase of the resident memory in bytes."""
+        if self.start_rss is None or self.peak_rss is None:
+            return None
+        return self.peak_rss - self.start_rss
+
+    def walk(self):
+        """Iterate depth-first through this span and all its descendants."""
+        yield self
+        for child in self.children:
+            yield from child.walk()
+
+    def to_dict(self, origin=0):
+        """Return the span as nested dictionaries with times relative to origin."""
+        return {
+            "name": self.name,
+            "attributes": self.attributes,
+            "start": None if self.start is None else self.start - origin,
+            "duration": self.duration,
+            "counters": self.counters,
+            "peak_rss": self.peak_rss,
+            "rss_increase": self.rss_increase,
+            "device_memory": self.device_memory,
+            "children": [child.to_dict(origin) for child in self.children],
+        }
+
+    def _sample_rss(self, rss):
+        """Update the peak resident memory."""
+        if rss is not None and (self.peak_rss is None or rss > self.peak_rss):
+            self.peak_rss = rss
+
+    def __repr__(self):
+        """String representation."""
+        return f"Span({self.name!r}, duration={self.duration})"
+
+
+class Profile(object):
+    """The spans, counters and memory samples of a recording."""
+
+    def __init__(self):
+        """Create an empty profile."""
+        self.root = Span("profile")
+        self.memory_samples = []
+        self._open_spans = []
+
+    def spans(self, name=None):
+        """Return all spans (with a given name) in depth-first order."""
+        return [
+            span
+            for span in self.root.walk()
+            if span is not self.root and (name is None or span.name == name)
+        ]
+
+    def total_time(self, name):
+        """Return the total duration of all spans with a given name."""
+        return sum(span.duration for span in self.spans(name) if span.duration)
+
+    @property
+    def counters(self):
+        """Return the counters summed over all spans."""
+        totals = {}
+        for span in self.root.walk():
+            for key, value in span.counters.items():
+                totals[key] = totals.get(key, 0) + value
+        return totals
+
+    def to_dict(self):
+        """Return the profile as nested dictionaries."""
+        origin = self.root.start
+        return {
+            "spans": self.root.to_dict(origin),
+            "counters": self.counters,
+            "memory_samples": [
+                [time - origin, rss] for time, rss in self.memory_samples
+            ],
+        }
+
+    def to_json(self, file_name=None):
+        """Return the profile as JSON string or write it to a file."""
+        return _dump(self.to_dict(), file_name)
+
+    def to_chrome_trace(self, file_name=None):
+        """
+        Return the profile in the Chrome trace event format.
+
+        The trace can be opened in chrome://tracing or ui.perfetto.dev.
+        If a file name is given the trace is written to this file.
+        """
+        origin = self.root.start
+        pid = _os.getpid()
+        events = []
+        for span in self.spans():
+            if span.duration is None:
+                continue
+            args = dict(span.attributes)
+            args.update(span.counters)
+            args["peak_rss"] = span.peak_rss
+            args["device_memory"] = span.device_memory
+            events.append(
+                {
+                    "name": span.name,
+                    "ph": "X",
+                    "ts": 1e6 * (span.start - origin),
+                    "dur": 1e6 * span.duration,
+                    "pid": pid,
+                    "tid": span.thread_id,
+                    "args": args,
+                }
+            )
+        for time, rss in self.memory_samples:
+            events.append(
+                {
+                    "name": "resident memory",
+                    "ph": "C",
+                    "ts": 1e6 * (time - origin),
+                    "pid": pid,
+                    "args": {"bytes": rss},
+                }
+            )
+        return _dump({"traceEvents": events}, file_name)
+
+    def _sample(self):
+        """Sample the resident memory for all open spans."""
+        rss = resident_memory()
+        if rss is None:
+            return
+        with _LOCK:
+            self.memory_samples.append((_time.perf_counter(), rss))
+            for span in self._open_spans:
+                span._sample_rss(rss)
+
+
+def _dump(data, file_name):
+    """Return data as JSON string or write it to a file."""
+    if file_name is None:
+        return _json.dumps(data)
+    with open(file_name, "w") as f:
+        _json.dump(data, f)
+
+
+def is_recording():
+    """Return true if a recording is active."""
+    return _PROFILE is not None
+
+
+@_contextlib.contextmanager
+def record(sample_interval=0.01):
+    """
+    Record all instrumented operations and yield the profile.
+
+    The resident memory is sampled every sample_interval seconds and when
+    a span is opened or closed. Recordings cannot be nested.
+    """
+    # pylint: disable=W0603
+    global _PROFILE
+
+    if _PROFILE is not None:
+        raise RuntimeError("A recording is already active.")
+
+    profile = Profile()
+    profile.root.start = _time.perf_counter()
+    profile.root.start_rss = resident_memory()
+    profile.root._sample_rss(profile.root.start_rss)
+    profile._open_spans.append(profile.root)
+
+    stop = _threading.Event()
+
+    def sampler():
+        """Sample the memory until stopped."""
+        while not stop.wait(sample_interval):
+            profile._sample()
+
+    thread = _threading.Thread(target=sampler, daemon=True)
+    _PROFILE = profile
+    thread.start()
+    try:
+        yield profile
+    finally:
+        stop.set()
+        thread.join()
+        _PROFILE = None
+        profile._sample()
+        profile.root.end = _time.perf_counter()
+        profile._open_spans.clear()
+
+
+def _stack():
+    """Return the stack of open spans of the current thread."""
+    if not hasattr(_LOCAL, "stack"):
+        _LOCAL.stack = []
+    return _LOCAL.stack
+
+
+def _current_span():
+    """Return the innermost open span of the current thread."""
+    stack = _stack()
+    if stack:
+        return stack[-1]
+    return _PROFILE.root
+
+
+def current_span():
+    """Return the innermost open span of this thread or None if not recording."""
+    if _PROFILE is None:
+        return None
+    return _current_span()
+
+
+@_contextlib.contextmanager
+def attach(parent):
+    """
+    Make a span the current span of this thread.
+
+    Used by worker threads to open their spans and increment their
+    counters in the span of the thread that started them. Does nothing
+    if parent is None.
+    """
+    if parent is None or _PROFILE is None:
+        yield
+        return
+
+    stack = _stack()
+    stack.append(parent)
+    try:
+        yield
+    finally:
+        stack.pop()
+
+
+@_contextlib.contextmanager
+def span(name, **attributes):
+    """
+    Open a span with a given name as child of the current span.
+
+    Keyword arguments are stored as attributes of the span. Yields the
+    span, or None if no recording is active.
+    """
+    profile = _PROFILE
+    if profile is None:
+        yield None
+        return
+
+    new_span = Span(name, attributes, _threading.get_ident())
+    parent = _current_span()
+    with _LOCK:
+        parent.children.append(new_span)
+        profile._open_spans.append(new_span)
+
+    new_span.start_rss = resident_memory()
+    new_span._sample_rss(new_span.start_rss)
+    stack = _stack()
+    stack.append(new_span)
+    new_span.start = _time.perf_counter()
+    try:
+        yield new_span
+    finally:
+        new_span.end = _time.perf_counter()
+        stack.pop()
+        new_span._sample_rss(resident_memory())
+        with _LOCK:
+            if new_span in profile._open_spans:
+                profile._open_spans.remove(new_span)
+            parent.device_memory += new_span.device_memory
+
+
+def count(name, value=1):
+    """Increment a counter of the current span."""
+    if _PROFILE is None:
+        return
+    counters = _current_span().counters
+    with _LOCK:
+        counters[name] = counters.get(name, 0) + value
+
+
+def add_device_memory(nbytes):
+    """Register nbytes of device memory allocated in the current span."""
+    if _PROFILE is None:
+        return
+    current = _current_span()
+    with _LOCK:
+        current.device_memory += int(nbytes)
+
+
+def counted_operator(operator, name="matvecs"):
+    """
+    Return a linear operator that counts its applications.
+
+    Each matrix-vector product increments the counter with the given
+    name in the span that is open when the product is computed.
+    """
+    from scipy.sparse.linalg import LinearOperator
+
+    if _PROFILE is None:
+        return operator
+
+    def matvec(x):
+        """Apply the operator and count."""
+        count(name)
+        return operator @ x
+
+    return LinearOperator(operator.shape, matvec=matvec, dtype=operator.dtype)
@@ -278,28 +278,159 @@ def evaluate_kernel_on_interpolation_points(
     raise ValueError(f"Unknown kernel: {kernel_type}")
 
 
-@_numba.njit(cache=True)
+@_numba.njit(parallel=True, cache=True)
 def evaluate_laplace_kernel_on_interpolation_points(pointsx, pointsy):
     """Evaluate the Laplace kernel at the given points."""
     values = _np.empty((pointsx.shape[0], pointsy.shape[0]), _np.float64)
-    for i, x in enumerate(pointsx):
-        for j, y in enumerate(pointsy):
-            values[i, j] = 1 / (4 * _np.pi * _np.linalg.norm(x - y))
+    for i in _numba.prange(pointsx.shape[0]):
+        for j in range(pointsy.shape[0]):
+            values[i, j] = 1 / (4 * _np.pi * _np.linalg.norm(pointsx[i] - pointsy[j]))
     return values
 
 
-@_numba.njit(cache=True)
+@_numba.njit(parallel=True, cache=True)
 def evaluate_helmholtz_kernel_on_interpolation_points(pointsx, pointsy, wavenumber):
-    """Evaluate the Laplace kernel at the given points."""
+    """Evaluate the Helmholtz kernel at the given points."""
     values = _np.empty((pointsx.shape[0], pointsy.shape[0]), _np.complex128)
-    for i, x in enumerate(pointsx):
-        for j, y in enumerate(pointsy):
-            values[i, :] = _np.exp(1j * wavenumber * _np.linalg.norm(x - y)) / (
-                4 * _np.pi * _np.linalg.norm(x - y)
-            )
+    for i in _numba.prange(pointsx.shape[0]):
+        for j in range(pointsy.shape[0]):
+            dist = _np.linalg.norm(pointsx[i] - pointsy[j])
+            values[i, j] = _np.exp(1j * wavenumber * dist) / (4 * _np.pi * dist)
+    return values
+
+
+def compressed_kernel_on_interpolation_points(
+    kernel_type,
+    lboundx,
+    uboundx,
+    lboundy,
+    uboundy,
+    nodes,
+    tol=1e-10,
+    max_rank=None,
+    **kwargs,
+):
+    """
+    Return a low-rank approximation of a kernel matrix on Chebychev points.
+
+    This routine computes the same matrix as
+    :func:`evaluate_kernel_on_interpolation_points` in the form
+    U @ V, where U has shape (n, r) and V has shape (r, n) with
+    n = len(nodes)**3. The factors are computed by adaptive cross
+    approximation with partial pivoting, which only evaluates
+    O(r) rows and columns of the kernel matrix. The approximation
+    is accurate if the two boxes are well separated.
+
+    Attributes
+    ----------
+    kernel_type : string
+        Either 'laplace' or 'helmholtz'.
+    lboundx, uboundx, lboundy, uboundy : Numpy array
+        The bounds of the two boxes as in
+        :func:`evaluate_kernel_on_interpolation_points`.
+    nodes : array
+        An array of 1d nodes defined in the interval [-1, 1].
+    tol : float
+        Relative tolerance of the approximation in the
+        Frobenius norm.
+    max_rank : int
+        The maximum rank of the approximation. By default
+        it is the number of tensor points.
+    kwargs : keyword arguments
+        The wavenumber for Helmholtz kernels.
+    """
+    pointsx = chebychev_tensor_points_3d(lboundx, uboundx, nodes)
+    pointsy = chebychev_tensor_points_3d(lboundy, uboundy, nodes)
+
+    if max_rank is None:
+        max_rank = min(len(pointsx), len(pointsy))
+
+    if kernel_type == "laplace":
+        u, v = _aca_partial_pivoting(pointsx, pointsy, 0.0, tol, max_rank)
+        return u.real.copy(), v.real.copy()
+
+    if kernel_type == "helmholtz":
+        return _aca_partial_pivoting(
+            pointsx, pointsy, kwargs["wavenumber"], tol, max_rank
+        )
+
+    raise ValueError(f"Unknown kernel: {kernel_type}")
+
+
+@_numba.njit(cache=True)
+def _kernel_column(pointsx, point, wavenumber):
+    """Evaluate the kernel between a set of points and a single point."""
+    values = _np.empty(pointsx.shape[0], _np.complex128)
+    for i in range(pointsx.shape[0]):
+        dist = _np.sqrt(
+            (pointsx[i, 0] - point[0]) ** 2
+            + (pointsx[i, 1] - point[1]) ** 2
+            + (pointsx[i, 2] - point[2]) ** 2
+        )
+        values[i] = _np.exp(1j * wavenumber * dist) / (4 * _np.pi * dist)
     return values
 
 
+@_numba.njit(cache=True)
+def _aca_partial_pivoting(pointsx, pointsy, wavenumber, tol, max_rank):
+    """Adaptive cross approximation of a kernel matrix."""
+    m = pointsx.shape[0]
+    n = pointsy.shape[0]
+    u = _np.zeros((m, max_rank), _np.complex128)
+    v = _np.zeros((max_rank, n), _np.complex128)
+    used_rows = _np.zeros(m, _np.bool_)
+
+    norm_squared = 0.0
+    rank = 0
+    row = 0
+
+    while rank < max_rank:
+        used_rows[row] = True
+        # Residual of the pivot row.
+        row_values = _kernel_column(pointsy, pointsx[row], wavenumber)
+        for k in range(rank):
+            row_values -= u[row, k] * v[k, :]
+
+        col = _np.argmax(_np.abs(row_values))
+        pivot = row_values[col]
+        if _np.abs(pivot) == 0:
+            # The row is exactly represented. Try another one.
+            remaining = _np.flatnonzero(~used_rows)
+            if len(remaining) == 0:
+                break
+            row = remaining[0]
+            continue
+
+        # Residual of the pivot column.
+        col_values = _kernel_column(pointsx, pointsy[col], wavenumber)
+        for k in range(rank):
+            col_values -= v[k, col] * u[:, k]
+
+        u[:, rank] = col_values
+        v[rank, :] = row_values / pivot
+
+        # Update the Frobenius norm of the approximation.
+        unorm = _np.linalg.norm(u[:, rank])
+        vnorm = _np.linalg.norm(v[rank, :])
+        for k in range(rank):
+            norm_squared += 2 * _np.real(
+                _np.vdot(u[:, k], u[:, rank]) * _np.vdot(v[rank, :], v[k, :])
+            )
+        norm_squared += (unorm * vnorm) ** 2
+        rank += 1
+
+        if unorm * vnorm <= tol * _np.sqrt(norm_squared):
+            break
+
+        col_abs = _np.abs(u[:, rank - 1])
+        col_abs[used_rows] = -1
+        row = _np.argmax(col_abs)
+        if col_abs[row] < 0:
+            break
+
+    return u[:, :rank].copy(), v[:rank, :].copy()
+
+
 @_numba.njit(cache=True)
 def chebychev_tensor_points_3d(lbound, ubound, nodes):
     """Create Chebychev points associated with a 3d tensor grid."""
@@ -320,39 +451,63 @@ def chebychev_tensor_points_3d(lbound, ubound, nodes):
     return tensor_points
 
 
-@_numba.njit(cache=True)
+@_numba.njit(parallel=True, cache=True)
+def lagrange_basis(nodes, weights, points):
+    """
+    Evaluate the Lagrange basis polynomials at given points.
+
+    Returns an array of shape (len(points), len(nodes)) whose
+    row i contains the values of all Lagrange polynomials at
+    points[i], computed with the barycentric formula.
+    """
+    npoints = len(points)
+    nterms = len(nodes)
+
+    basis = _np.zeros((npoints, nterms), _np.float64)
+    for point_index in _numba.prange(npoints):
+        exact_index = -1
+        denominator = 0.0
+        for index in range(nterms):
+            xdiff = points[point_index] - nodes[index]
+            if xdiff == 0.0:
+                exact_index = index
+                break
+            basis[point_index, index] = weights[index] / xdiff
+            denominator += basis[point_index, index]
+        if exact_index > -1:
+            basis[point_index, :] = 0
+            basis[point_index, exact_index] = 1
+        else:
+            basis[point_index, :] /= denominator
+    return basis
+
+
 def evaluate_interp_polynomial(nodes, weights, values, evaluation_points):
     """
     Evaluate an interpolation polynomial.
 
     This function uses barycentric evaluation for
-    stability. The data values are assumed to be real.
+    stability. The data values can be real or complex.
     """
-    npoints = len(evaluation_points)
-    nterms = len(nodes)
-
-    numerator = _np.zeros(npoints, _np.float64)
-    denominator = _np.zeros(npoints, _np.float64)
-    exact = -_np.ones(npoints, _np.int32)
-
-    for index in range(nterms):
-        xdiff = evaluation_points - nodes[index]
-        temp = weights[index] / xdiff
-        numerator += temp * values[index]
-        denominator += temp
-        exact[xdiff == 0] = index
-    result = numerator / denominator
-    indices = _np.where(exact > -1)[0]
-    result[indices] = values[exact[indices]]
-    return result
+    return lagrange_basis(nodes, weights, evaluation_points) @ values
 
 
-def evaluate_tensor_interp_polynomial(nodes, weights, values, evaluation_points):
+def evaluate_tensor_interp_polynomial(
+    nodes,
+    weights,
+    values,
+    evaluation_points,
+    device_interface=None,
+    precision="double",
+):
     """
     Evaluate a tensor interpolation polynomial.
 
     This function evaluates a tensor chebychev basis with
     specified weights at a given set of evaluation points.
+    The 1d basis values in each dimension are computed once
+    per point and the values are then contracted one
+    dimension at a time, starting with the inner most one.
 
     Attributes
     ----------
@@ -365,38 +520,153 @@ def evaluate_tensor_interp_polynomial(nodes, weights, values, evaluation_points)
         The dimensions specify the values along the
         (x, y, z) axis with z being the inner most axis.
         For k interpolation nodes there are k values along
-        each dimension.
+        each dimension. The values can be real or complex.
     evaluation_points : Numpy array
         (N x 3) array of N evaluation points in 3 dimension.
+    device_interface : string
+        Either 'numba' (default) or 'opencl'.
+    precision : string
+        The precision of the OpenCL evaluation. Numba
+        evaluations are always in double precision.
     """
-    npoints = len(evaluation_points)
-    nterms = len(nodes)
+    if device_interface is None:
+        device_interface = "numba"
 
-    output = _np.empty(npoints, _np.float64)
-
-    for point_index, point in enumerate(evaluation_points):
-        local_values = values.copy()
-        for dim in range(2, -1, -1):
-            numerator = _np.zeros(dim * [nterms], _np.float64)
-            exact_index = -1
-            denominator = 0.0
-            for index in range(nterms):
-                xdiff = point[dim] - nodes[index]
-                if xdiff == 0.0:
-                    exact_index = index
-                    break
-                temp = weights[index] / xdiff
-                numerator += temp * local_values[..., index]
-                denominator += temp
-            if exact_index > -1:
-                local_values = local_values[..., exact_index]
-            else:
-                local_values = numerator / denominator
-        output[point_index] = local_values
+    if device_interface == "opencl":
+        return _evaluate_tensor_interp_polynomial_opencl(
+            nodes, weights, values, evaluation_points, precision
+        )
 
+    if device_interface != "numba":
+        raise ValueError("device_interface must be one of 'numba' or 'opencl'.")
+
+    evaluation_points = _np.asarray(evaluation_points, dtype=_np.float64)
+    basis = [
+        lagrange_basis(nodes, weights, evaluation_points[:, dim].copy())
+        for dim in range(3)
+    ]
+
+    if _np.iscomplexobj(values):
+        values = _np.ascontiguousarray(values, dtype=_np.complex128)
+    else:
+        values = _np.ascontiguousarray(values, dtype=_np.float64)
+
+    return _tensor_contraction(basis[0], basis[1], basis[2], values)
+
+
+@_numba.njit(parallel=True, cache=True)
+def _tensor_contraction(basis_x, basis_y, basis_z, values):
+    """Contract a tensor of values with the 1d basis values of each point."""
+    npoints, nterms = basis_x.shape
+    output = _np.zeros(npoints, values.dtype)
+    for point_index in _numba.prange(npoints):
+        result = output[point_index]
+        for i in range(nterms):
+            partial_y = 0 * result
+            for j in range(nterms):
+                partial_z = 0 * result
+                for k in range(nterms):
+                    partial_z += basis_z[point_index, k] * values[i, j, k]
+                partial_y += basis_y[point_index, j] * partial_z
+            result += basis_x[point_index, i] * partial_y
+        output[point_index] = result
     return output
 
 
+def evaluate_tensor_interp_polynomial_on_grid(nodes, weights, values, x, y, z):
+    """
+    Evaluate a tensor interpolation polynomial on a tensor grid.
+
+    Returns an array of shape (len(x), len(y), len(z)) with the
+    values of the polynomial at all points (x[i], y[j], z[k]).
+    The evaluation is done with three successive 1d contractions.
+    For p interpolation nodes and p points in each dimension
+    this requires O(p^4) operations instead of the O(p^6)
+    operations of a pointwise evaluation.
+
+    Attributes
+    ----------
+    nodes : Numpy array
+        1d array of interpolation points
+    weights : Numpy array
+        Associated array of barycentric weights
+    values : Numpy array
+        3d array of values at interpolation points
+        with the same layout as in
+        :func:`evaluate_tensor_interp_polynomial`.
+    x, y, z : Numpy array
+        The 1d coordinates of the grid in each dimension.
+    """
+    basis_x = lagrange_basis(nodes, weights, _np.asarray(x, dtype=_np.float64))
+    basis_y = lagrange_basis(nodes, weights, _np.asarray(y, dtype=_np.float64))
+    basis_z = lagrange_basis(nodes, weights, _np.asarray(z, dtype=_np.float64))
+
+    result = _np.tensordot(values, basis_z, axes=([2], [1]))
+    result = _np.tensordot(result, basis_y, axes=([1], [1]))
+    result = _np.tensordot(result, basis_x, axes=([0], [1]))
+
+    # The contractions leave the axes in the order (z, y, x).
+    return result.transpose(2, 1, 0).copy()
+
+
+def _evaluate_tensor_interp_polynomial_opencl(
+    nodes, weights, values, evaluation_points, precision
+):
+    """Evaluate a tensor interpolation polynomial with OpenCL."""
+    import pyopencl as _cl
+    from bempp.api.utils.helpers import get_type
+    from bempp.core.opencl_kernels import build_program
+    from bempp.core.opencl_kernels import default_context, default_device
+
+    mf = _cl.mem_flags
+    ctx = default_context()
+    device = default_device()
+
+    real_type = get_type(precision).real
+    npoints = len(evaluation_points)
+    is_complex = _np.iscomplexobj(values)
+
+    options = {"NUMBER_OF_NODES": len(nodes)}
+    if is_complex:
+        options["COMPLEX_VALUES"] = None
+        result = _np.empty(npoints, dtype=get_type(precision).complex)
+        values = _np.ascontiguousarray(values, dtype=get_type(precision).complex)
+    else:
+        result = _np.empty(npoints, dtype=real_type)
+        values = _np.ascontiguousarray(values, dtype=real_type)
+
+    kernel = build_program("evaluate_tensor_interp_polynomial", options, precision)
+
+    nodes_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=nodes.astype(real_type)
+    )
+    weights_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=weights.astype(real_type)
+    )
+    values_buffer = _cl.Buffer(ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=values)
+    points_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=_np.ascontiguousarray(evaluation_points, dtype=real_type),
+    )
+    result_buffer = _cl.Buffer(ctx, mf.WRITE_ONLY, size=result.nbytes)
+
+    with _cl.CommandQueue(ctx, device=device) as queue:
+        kernel(
+            queue,
+            (npoints,),
+            None,
+            nodes_buffer,
+            weights_buffer,
+            values_buffer,
+            points_buffer,
+            result_buffer,
+        )
+        _cl.enqueue_copy(queue, result, result_buffer)
+
+    return result
+
+
 def chebychev_differentiation_matrix(nodes, weights):
     """Return a Chebychev differentiation matrix."""
     nterms = len(nodes)
@@ -17,6 +17,8 @@ import numba as _numba
         ("_level_nodes", _numba.uint32[:]),
         ("_level_nodes_index_ptr", _numba.uint32[:]),
         ("_near_field_nodes", _numba.int32[:]),
+        ("_interaction_list", _numba.int32[:]),
+        ("_interaction_list_ptr", _numba.uint32[:]),
     ]
 )
 class Octree(object):
@@ -46,6 +48,7 @@ class Octree(object):
         self._vertices = vertices
         self._assign_nodes(vertices)
         self._compute_nearfields()
+        self._compute_interaction_list()
 
     @property
     def diameter(self):
@@ -130,6 +133,23 @@ class Octree(object):
         """
         return _np.uint32(27) * self._level_nodes_index_ptr
 
+    @property
+    def interaction_list(self):
+        """Return the interaction lists of all non-empty nodes."""
+        return self._interaction_list
+
+    @property
+    def interaction_list_ptr(self):
+        """
+        Return an index ptr to the interaction lists.
+
+        Returns an array index_ptr, such that
+        self.interaction_list[index_ptr[j]:index_ptr[j+1]]
+        contains the Morton indices of the nodes in the interaction
+        list of the jth node in the array non_empty_nodes_by_level.
+        """
+        return self._interaction_list_ptr
+
     def parent(self, node_index):
         """Return the parent index of a node."""
         return node_index >> 3
@@ -179,108 +199,288 @@ class Octree(object):
 
     def node_diameter(self, level):
         """Return node diameter in a given level."""
-        return self.diameter / (1.0 * self.nodes_per_side(self.maximum_level))
+        return self.diameter / (1.0 * self.nodes_per_side(level))
 
     def _assign_nodes(self, vertices):
         """Compute leaf-nodes and parents."""
-        nvertices = vertices.shape[1]
-        node_indices = _np.empty(nvertices, dtype=_np.uint32)
+        node_indices = _leaf_indices(
+            vertices, self._lbound, self._diameter, self._maximum_level
+        )
+        self._sorted_indices, sorted_nodes = _radix_argsort(
+            node_indices, 3 * self._maximum_level
+        )
+        self._leaf_nodes, self._leaf_nodes_index_ptr = _unique_sorted(sorted_nodes)
+        self._level_nodes, self._level_nodes_index_ptr = _level_nodes(
+            self._leaf_nodes, self._maximum_level
+        )
 
-        for index in range(nvertices):
-            node_indices[index] = self.leaf_containing_point(vertices[:, index])
+    def _compute_nearfields(self):
+        """
+        Compute near fields of all non empty nodes.
 
-        self._sorted_indices = _np.argsort(node_indices).astype(_np.uint32)
-        index_ptr = []
-        nodes = []
+        Each node can have at most 27 near field nodes (including
+        the node itself). If a near field node does not exist or is empty
+        then the value -1 is stored, otherwise the node number.
+        """
+        self._near_field_nodes = _near_fields(
+            self._level_nodes, self._level_nodes_index_ptr, self._maximum_level
+        )
 
-        tmp = -1
+    def _compute_interaction_list(self):
+        """
+        Compute the interaction list for each non empty node.
 
-        for i, index in enumerate(self._sorted_indices):
-            if tmp != node_indices[index]:
-                index_ptr.append(i)
-                nodes.append(node_indices[index])
-                tmp = node_indices[index]
+        The interaction list of a node consists of the non-empty children
+        of the near field nodes of its parent that are not adjacent to
+        the node itself. It has at most 189 entries.
+        """
+        self._interaction_list, self._interaction_list_ptr = _interaction_lists(
+            self._level_nodes,
+            self._level_nodes_index_ptr,
+            self._near_field_nodes,
+            self._maximum_level,
+        )
 
-        index_ptr.append(len(self._sorted_indices))
-        self._leaf_nodes = _np.array(nodes, dtype=_np.uint32)
-        self._leaf_nodes_index_ptr = _np.array(index_ptr, dtype=_np.uint32)
 
-        # Now compute the parents
+@_numba.njit(cache=True)
+def _leaf_index(coordinate, lbound, diameter, leaf_size):
+    """Return the index of the leaf containing a coordinate along one axis."""
+    fraction = ((coordinate - lbound) / diameter) * leaf_size
+    return min(int(max(0.0, fraction)), leaf_size - 1)
 
-        self._level_nodes = self._leaf_nodes
-        self._level_nodes_index_ptr = _np.zeros(self.maximum_level + 2, _np.uint32)
-        nnodes = _np.empty(1 + self._maximum_level, _np.uint32)
-        nnodes[self.maximum_level] = len(self._leaf_nodes)
-        current_level = self._leaf_nodes
-        current_nodes = []
 
-        for index in range(1, self.maximum_level + 1):
-            current_nodes.clear()
-            for node_index in current_level:
-                current_nodes.append(self.parent(node_index))
-            current_level = _make_unique(_np.array(current_nodes, dtype=_np.uint32))
-            self._level_nodes = _np.concatenate((current_level, self._level_nodes))
-            nnodes[self.maximum_level - index] = len(current_level)
+@_numba.njit(parallel=True, cache=True)
+def _leaf_indices(vertices, lbound, diameter, maximum_level):
+    """Return the Morton indices of the leaves containing the vertices."""
+    leaf_size = 1 << maximum_level
+    nvertices = vertices.shape[1]
+    node_indices = _np.empty(nvertices, dtype=_np.uint32)
 
-        tmp = 0
+    for index in _numba.prange(nvertices):
+        ind1 = _leaf_index(vertices[0, index], lbound[0], diameter[0], leaf_size)
+        ind2 = _leaf_index(vertices[1, index], lbound[1], diameter[1], leaf_size)
+        ind3 = _leaf_index(vertices[2, index], lbound[2], diameter[2], leaf_size)
+        node_indices[index] = morton((ind1, ind2, ind3))
 
-        for index in range(0, 1 + self.maximum_level):
-            self._level_nodes_index_ptr[index] = tmp
-            tmp += nnodes[index]
-        self._level_nodes_index_ptr[1 + self.maximum_level] = tmp
+    return node_indices
 
-    def _compute_nearfields(self):
-        """
-        Compute near fields of all non empty nodes.
 
-        Each node can have at most 27 near field nodes (including
-        the node itself). If a near field node does not exist or is empty
-        then the value -1 is stored, otherwise the node number.
-        """
-        self._near_field_nodes = _np.empty(27 * len(self._level_nodes), _np.int32)
-
-        count = 0
-
-        for level_index in range(self.maximum_level + 1):
-            sides = 1 << level_index
-            level_nodes = self.non_empty_nodes_by_level[
-                self.non_empty_nodes_ptr[level_index] : self.non_empty_nodes_ptr[
-                    level_index + 1
-                ]
-            ]
-            for node_index in level_nodes:
-                ind1, ind2, ind3 = de_morton(node_index)
-
-                for i in range(-1, 2):
-                    for j in range(-1, 2):
-                        for k in range(-1, 2):
-                            if _in_range(ind1 + i, ind2 + j, ind3 + k, sides):
-                                morton_index = morton((ind1 + i, ind2 + j, ind3 + k))
-                                if _np.any(level_nodes == morton_index):
-                                    self._near_field_nodes[count] = morton_index
-                                else:
-                                    self._near_field_nodes[count] = -1
-                            else:
-                                self._near_field_nodes[count] = -1
-                            count += 1
+@_numba.njit(parallel=True, cache=True)
+def _radix_argsort(keys, nbits):
+    """
+    Stable sort of unsigned integer keys with nbits significant bits.
 
-    def _compute_interaction_list(self):
-        """Compute the interaction list for each non empty node."""
-        pass
+    Returns a tuple (permutation, sorted_keys). The LSD radix sort
+    processes 8 bits per pass. In each pass the digit histograms and
+    the scatter are computed in parallel over contiguous chunks of
+    the keys.
+    """
+    nkeys = len(keys)
+    nchunks = max(1, min(_numba.get_num_threads(), nkeys // 1024))
+    chunk_size = (nkeys + nchunks - 1) // nchunks
+
+    current_keys = keys.copy()
+    current_perm = _np.arange(nkeys).astype(_np.uint32)
+    buffer_keys = _np.empty_like(current_keys)
+    buffer_perm = _np.empty_like(current_perm)
+
+    shift = 0
+    while shift < nbits:
+        counts = _np.zeros((nchunks, 256), dtype=_np.int64)
+        for chunk in _numba.prange(nchunks):
+            for index in range(
+                chunk * chunk_size, min(nkeys, (chunk + 1) * chunk_size)
+            ):
+                counts[chunk, (current_keys[index] >> shift) & 255] += 1
+
+        offsets = _np.empty((nchunks, 256), dtype=_np.int64)
+        total = 0
+        for digit in range(256):
+            for chunk in range(nchunks):
+                offsets[chunk, digit] = total
+                total += counts[chunk, digit]
+
+        for chunk in _numba.prange(nchunks):
+            positions = offsets[chunk].copy()
+            for index in range(
+                chunk * chunk_size, min(nkeys, (chunk + 1) * chunk_size)
+            ):
+                digit = (current_keys[index] >> shift) & 255
+                buffer_keys[positions[digit]] = current_keys[index]
+                buffer_perm[positions[digit]] = current_perm[index]
+                positions[digit] += 1
+
+        current_keys, buffer_keys = buffer_keys, current_keys
+        current_perm, buffer_perm = buffer_perm, current_perm
+        shift += 8
+
+    return current_perm, current_keys
 
 
-@_numba.njit
-def _make_unique(ar):
-    """Find unique elements.
+@_numba.njit(cache=True)
+def _unique_sorted(sorted_keys):
+    """
+    Find the unique elements of a sorted array.
+
+    Returns a tuple (unique, index_ptr) such that the elements
+    sorted_keys[index_ptr[j]:index_ptr[j+1]] are equal to unique[j].
+    """
+    nkeys = len(sorted_keys)
+    nunique = 0
+    for index in range(nkeys):
+        if index == 0 or sorted_keys[index] != sorted_keys[index - 1]:
+            nunique += 1
+
+    unique = _np.empty(nunique, dtype=sorted_keys.dtype)
+    index_ptr = _np.empty(nunique + 1, dtype=_np.uint32)
+    count = 0
+    for index in range(nkeys):
+        if index == 0 or sorted_keys[index] != sorted_keys[index - 1]:
+            unique[count] = sorted_keys[index]
+            index_ptr[count] = index
+            count += 1
+    index_ptr[nunique] = nkeys
+    return unique, index_ptr
+
+
+@_numba.njit(cache=True)
+def _level_nodes(leaf_nodes, maximum_level):
+    """
+    Compute the non-empty nodes on all levels from the leaf nodes.
+
+    The parents of a sorted array of Morton indices are again
+    sorted, so that each level is obtained in linear time.
+    """
+    levels = [leaf_nodes]
+    for _ in range(maximum_level):
+        parents, _ = _unique_sorted(levels[-1] >> 3)
+        levels.append(parents.astype(_np.uint32))
+
+    index_ptr = _np.zeros(maximum_level + 2, dtype=_np.uint32)
+    for level in range(maximum_level + 1):
+        index_ptr[level + 1] = index_ptr[level] + len(levels[maximum_level - level])
+
+    level_nodes = _np.empty(index_ptr[-1], dtype=_np.uint32)
+    for level in range(maximum_level + 1):
+        level_nodes[index_ptr[level] : index_ptr[level + 1]] = levels[
+            maximum_level - level
+        ]
+    return level_nodes, index_ptr
+
+
+@_numba.njit(cache=True)
+def _contains(sorted_nodes, node_index):
+    """Check by binary search if a sorted array contains a node."""
+    position = _np.searchsorted(sorted_nodes, node_index)
+    return position < len(sorted_nodes) and sorted_nodes[position] == node_index
+
+
+@_numba.njit(parallel=True, cache=True)
+def _near_fields(level_nodes, level_ptr, maximum_level):
+    """Compute the 27 near field entries of all non-empty nodes."""
+    near_field_nodes = _np.empty(27 * len(level_nodes), _np.int32)
+
+    for level_index in range(maximum_level + 1):
+        sides = 1 << level_index
+        nodes = level_nodes[level_ptr[level_index] : level_ptr[level_index + 1]]
+        for node_position in _numba.prange(len(nodes)):
+            ind1, ind2, ind3 = de_morton(nodes[node_position])
+            count = 27 * (level_ptr[level_index] + node_position)
+            for i in range(-1, 2):
+                for j in range(-1, 2):
+                    for k in range(-1, 2):
+                        near_field_nodes[count] = -1
+                        if _in_range(ind1 + i, ind2 + j, ind3 + k, sides):
+                            morton_index = _np.uint32(
+                                morton((ind1 + i, ind2 + j, ind3 + k))
+                            )
+                            if _contains(nodes, morton_index):
+                                near_field_nodes[count] = morton_index
+                        count += 1
+
+    return near_field_nodes
+
+
+@_numba.njit(cache=True)
+def _is_adjacent(node1, node2):
+    """Check if two nodes on the same level are adjacent or identical."""
+    ind1, ind2, ind3 = de_morton(node1)
+    other1, other2, other3 = de_morton(node2)
+    return (
+        abs(ind1 - other1) <= 1 and abs(ind2 - other2) <= 1 and abs(ind3 - other3) <= 1
+    )
+
+
+@_numba.njit(cache=True)
+def _node_interactions(
+    node_index, nodes, parent_near_field, interaction_list, offset, fill
+):
+    """Count (and store if fill is true) the interaction list of a node."""
+    count = 0
+    for parent_neighbor in parent_near_field:
+        if parent_neighbor == -1:
+            continue
+        for child in range(8):
+            candidate = _np.uint32((parent_neighbor << 3) + child)
+            if _is_adjacent(node_index, candidate) or not _contains(nodes, candidate):
+                continue
+            if fill:
+                interaction_list[offset + count] = candidate
+            count += 1
+    return count
+
+
+@_numba.njit(parallel=True, cache=True)
+def _interaction_lists(level_nodes, level_ptr, near_field_nodes, maximum_level):
+    """
+    Compute the interaction lists of all non-empty nodes in CSR format.
 
-    An implementation of Numpy unique for Numba.
+    Returns a tuple (interaction_list, index_ptr) with the nodes
+    ordered as in level_nodes.
     """
-    sorted_ar = _np.sort(ar)
-    unique_lst = [sorted_ar[0]]
-    for elem in sorted_ar:
-        if elem != unique_lst[-1]:
-            unique_lst.append(elem)
-    return _np.array(unique_lst, dtype=ar.dtype)
+    nnodes = len(level_nodes)
+    counts = _np.zeros(nnodes, dtype=_np.uint32)
+    dummy = _np.empty(0, dtype=_np.int32)
+
+    for level_index in range(2, maximum_level + 1):
+        nodes = level_nodes[level_ptr[level_index] : level_ptr[level_index + 1]]
+        parents = level_nodes[level_ptr[level_index - 1] : level_ptr[level_index]]
+        for node_position in _numba.prange(len(nodes)):
+            global_position = level_ptr[level_index] + node_position
+            parent_position = level_ptr[level_index - 1] + _np.searchsorted(
+                parents, nodes[node_position] >> 3
+            )
+            counts[global_position] = _node_interactions(
+                nodes[node_position],
+                nodes,
+                near_field_nodes[27 * parent_position : 27 * parent_position + 27],
+                dummy,
+                0,
+                False,
+            )
+
+    index_ptr = _np.zeros(nnodes + 1, dtype=_np.uint32)
+    index_ptr[1:] = _np.cumsum(counts)
+    interaction_list = _np.empty(index_ptr[-1], dtype=_np.int32)
+
+    for level_index in range(2, maximum_level + 1):
+        nodes = level_nodes[level_ptr[level_index] : level_ptr[level_index + 1]]
+        parents = level_nodes[level_ptr[level_index - 1] : level_ptr[level_index]]
+        for node_position in _numba.prange(len(nodes)):
+            global_position = level_ptr[level_index] + node_position
+            parent_position = level_ptr[level_index - 1] + _np.searchsorted(
+                parents, nodes[node_position] >> 3
+            )
+            _node_interactions(
+                nodes[node_position],
+                nodes,
+                near_field_nodes[27 * parent_position : 27 * parent_position + 27],
+                interaction_list,
+                index_ptr[global_position],
+                True,
+            )
+
+    return interaction_list, index_ptr
 
 
 @_numba.njit(cache=True)
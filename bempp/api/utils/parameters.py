@@ -26,6 +26,23 @@ class _Quadrature(object):
         """Iniitalize quadrature parameters."""
         self.regular = 4
         self.singular = 4
+        self.higher_order_increment = 2
+
+    def adapted_order(self, mode, *spaces):
+        """
+        Return the quadrature order for a given mode and given spaces.
+
+        The order for mode ("regular" or "singular") is increased by
+        higher_order_increment for each polynomial degree of the
+        shapesets above one. On curved grids the order is increased by
+        a further higher_order_increment, since the integration elements
+        and normals vary over the elements.
+        """
+        degree = max(space.shapeset.degree for space in spaces)
+        increment = max(0, degree - 1)
+        if any(space.grid.is_curved for space in spaces):
+            increment += 1
+        return getattr(self, mode) + self.higher_order_increment * increment
 
 
 class _Fmm(object):
@@ -41,12 +58,58 @@ class _Fmm(object):
         self.dense_evaluation = False
 
 
+class _Octree(object):
+    """Octree potential evaluation options."""
+
+    def __init__(self):
+        """Initialize octree parameters."""
+        self.interpolation_order = 6
+        self.theta = 0.5
+        self.ncrit = 32
+        self.near_field_quadrature_order = 12
+        self.near_field_distance = 1.0
+        self.batch_size = 128
+
+
+class _FarField(object):
+    """Far-field evaluation options."""
+
+    def __init__(self):
+        """Initialize far-field parameters."""
+        self.interpolation = False
+        self.interpolation_digits = 10
+
+
 class _DenseAssembly(object):
     """Dense assembly options."""
 
     def __init__(self):
         """Iniitalize dense assembly parameters."""
         self.workgroup_size_multiple = 2
+        # Precision in which dense weak forms are stored ('single' or
+        # 'double'). None stores them in the precision of the operator.
+        self.storage_precision = None
+
+
+class _SparseAssembly(object):
+    """Sparse assembly options."""
+
+    def __init__(self):
+        """Initialize sparse assembly parameters."""
+        # Device interface for sparse operators. OpenCL ('opencl') is
+        # opt-in and only supports the L2 identity on flat grids.
+        self.device_interface = "numba"
+
+
+class _MomentAssembly(object):
+    """Options for the assembly from single-layer moments."""
+
+    def __init__(self):
+        """Initialize moment assembly parameters."""
+        # Directory for memory-mapped moment files (None keeps them in memory).
+        self.cache_directory = None
+        # Maximum number of cached moment matrices.
+        self.cache_size = 2
 
 
 class _Assembly(object):
@@ -55,6 +118,8 @@ class _Assembly(object):
     def __init__(self):
         """Iniitalize assembly parameters."""
         self.dense = _DenseAssembly()
+        self.sparse = _SparseAssembly()
+        self.moments = _MomentAssembly()
         self.always_promote_to_double = False
         self.discretization_type = "galerkin"
 
@@ -69,3 +134,5 @@ class DefaultParameters(object):
         self.quadrature = _Quadrature()
         self.assembly = _Assembly()
         self.fmm = _Fmm()
+        self.octree = _Octree()
+        self.far_field = _FarField()
@@ -310,11 +310,11 @@ def create_device_pool(
 
     """
     import bempp.api
-    from bempp.core.cl_helpers import get_context_by_name
+    from bempp.core.opencl_kernels import get_context_by_name
 
     ctx, _ = get_context_by_name(identifier)
 
-    bempp.api.log(f"Creating pool for Platform: {ctx.platform_name}")
+    bempp.api.log(f"Creating pool for Platform: {ctx.devices[0].platform.name}")
 
     if precision not in [None, "single", "double"]:
         raise ValueError(
@@ -396,15 +396,29 @@ def _remove_key_worker(key):
 
 def _init_device_worker(identifier, precision):
     """Worker to initialise device."""
+    import pyopencl as cl
     import bempp.api
     from bempp.api.utils.pool import get_id
-    from bempp.core.cl_helpers import get_context_by_name
+    from bempp.core.opencl_kernels import get_context_by_name
+    from bempp.core.opencl_kernels import set_default_cpu_device
+    from bempp.core.opencl_kernels import set_default_gpu_device
 
     ctx, platform_index = get_context_by_name(identifier)
-    bempp.api.set_default_device(platform_index, get_id())
-    if precision is not None:
-        bempp.api.DEVICE_PRECISION_CPU = precision
-        bempp.api.DEVICE_PRECISION_GPU = precision
+    device = ctx.devices[get_id()]
+    device_index = ctx.devices[0].platform.get_devices().index(device)
+
+    # Each worker assembles all operators on its own device.
+    bempp.api.DEFAULT_DEVICE_INTERFACE = "opencl"
+    if device.type & cl.device_type.GPU:
+        set_default_gpu_device(platform_index, device_index)
+        bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE = "gpu"
+        bempp.api.POTENTIAL_OPERATOR_DEVICE_TYPE = "gpu"
+        bempp.api.DEFAULT_PRECISION = "single" if precision is None else precision
+    else:
+        set_default_cpu_device(platform_index, device_index)
+        bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE = "cpu"
+        bempp.api.POTENTIAL_OPERATOR_DEVICE_TYPE = "cpu"
+        bempp.api.DEFAULT_PRECISION = "double" if precision is None else precision
 
 
 def _clear_data_worker():
@@ -13,12 +13,15 @@ def timeit(message):
             """Time something."""
             from bempp.api import GLOBAL_PARAMETERS
             from bempp.api import log
+            from bempp.api.utils import instrumentation
 
             if not GLOBAL_PARAMETERS.verbosity.extended_verbosity:
-                return fun(*args, **kwargs)
+                with instrumentation.span(message):
+                    return fun(*args, **kwargs)
 
             start_time = _time.time()
-            res = fun(*args, **kwargs)
+            with instrumentation.span(message):
+                res = fun(*args, **kwargs)
             end_time = _time.time()
             log(message + " : {0:.3e}s".format(end_time - start_time))
             return res
@@ -0,0 +1,347 @@
+"""
+Cost model for the automatic selection of the device interface.
+
+If an operator is assembled with the device interface "auto", the dense
+assembler estimates the assembly time of each available backend and uses
+the fastest one. The backends are "numba", "opencl" and "opencl_novec",
+the latter running the OpenCL kernels without explicit vectorization.
+
+The estimate for a backend is
+
+    overhead + factor * pair_cost * work + compile_time,
+
+where work is the number of element pairs times the number of pairs of
+regular quadrature points. The compile time is only added if the kernels
+for the operator type and shapesets have not yet been compiled in this
+process. The overhead, pair cost and compile time of each backend are
+calibrated with a Laplace single layer operator on first use. The factor
+accounts for the relative cost of an operator type and is updated after
+each assembly with the device interface "auto". Assemblies with an
+explicit device interface do not change the model. Calibrations are
+stored per machine in the file cost_model.json in the directory given by
+the environment variable BEMPP_CACHE_DIR (default: ~/.cache/bempp).
+Updated factors are stored after every _SAVE_INTERVAL automatic
+assemblies and at exit.
+"""
+
+import json as _json
+import os as _os
+
+_MODEL = None
+
+# Number of factor updates since the model was last stored.
+_UNSAVED_UPDATES = 0
+
+# Number of factor updates after which the model is stored.
+_SAVE_INTERVAL = 20
+
+_ATEXIT_REGISTERED = False
+
+# (backend, kernel key) pairs whose kernels were compiled in this process.
+_COMPILED = set()
+
+# Weight of a new measurement when updating an operator factor.
+_FACTOR_UPDATE_WEIGHT = 0.5
+
+
+def cache_file():
+    """Return the file in which the calibrations are stored."""
+    cache_dir = _os.environ.get("BEMPP_CACHE_DIR")
+    if cache_dir is None:
+        cache_dir = _os.path.join(
+            _os.environ.get(
+                "XDG_CACHE_HOME", _os.path.join(_os.path.expanduser("~"), ".cache")
+            ),
+            "bempp",
+        )
+    return _os.path.join(cache_dir, "cost_model.json")
+
+
+def opencl_available():
+    """Return true if the OpenCL backend can be used for boundary operators."""
+    import bempp.api
+
+    if bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE == "gpu":
+        return bempp.api.GPU_OPENCL_DRIVER_FOUND
+    return bempp.api.CPU_OPENCL_DRIVER_FOUND
+
+
+def available_backends(precision):
+    """Return the backends that the cost model chooses from for a precision."""
+    import bempp.api
+
+    backends = ["numba"]
+    if opencl_available():
+        backends.append("opencl")
+        if bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE == "cpu":
+            from bempp.core.opencl_kernels import get_vector_width
+
+            if get_vector_width(precision) > 1:
+                backends.append("opencl_novec")
+    return backends
+
+
+def machine_key():
+    """Return a key that identifies the machine and its configuration."""
+    import platform
+    import numba
+    import bempp.api
+
+    key = [
+        platform.node(),
+        platform.machine(),
+        str(_os.cpu_count()),
+        str(numba.config.NUMBA_NUM_THREADS),
+    ]
+    if opencl_available():
+        from bempp.core.opencl_kernels import default_device
+
+        key.append(default_device(bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE).name)
+    return "|".join(key)
+
+
+def kernel_key(operator_descriptor, domain, dual_to_range):
+    """Return a key for the kernels that assemble an operator."""
+    return ":".join(
+        [
+            operator_descriptor.kernel_type,
+            operator_descriptor.assembly_type,
+            operator_descriptor.precision,
+            dual_to_range.shapeset.identifier,
+            domain.shapeset.identifier,
+        ]
+    )
+
+
+def assembly_work(domain, dual_to_range, parameters):
+    """Return the number of element and quadrature point pairs."""
+    from bempp.api.integration.triangle_gauss import rule
+
+    _, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", domain, dual_to_range)
+    )
+    return (
+        float(dual_to_range.number_of_support_elements)
+        * domain.number_of_support_elements
+        * len(quad_weights) ** 2
+    )
+
+
+class CostModel(object):
+    """Calibrated assembly cost model of a machine."""
+
+    def __init__(self, data=None):
+        """
+        Create a cost model.
+
+        data is a dictionary that maps each backend to a dictionary with
+        the keys 'overhead', 'pair_cost', 'compile_time' and 'factors'.
+        """
+        self.data = data if data is not None else {}
+
+    @property
+    def backends(self):
+        """Return the calibrated backends."""
+        return list(self.data.keys())
+
+    def factor(self, backend, key):
+        """Return the relative cost of an operator type."""
+        return self.data[backend]["factors"].get(key, 1.0)
+
+    def estimate(self, backend, key, work, compiled=False):
+        """Estimate the time in seconds to assemble a given amount of work."""
+        entry = self.data[backend]
+        time = entry["overhead"] + self.factor(backend, key) * entry["pair_cost"] * work
+        if not compiled:
+            time += entry["compile_time"]
+        return time
+
+    def select(self, key, work, backends=None):
+        """Return the backend with the smallest estimated time."""
+        if backends is None:
+            backends = self.backends
+        return min(
+            backends,
+            key=lambda backend: self.estimate(
+                backend, key, work, (backend, key) in _COMPILED
+            ),
+        )
+
+    def update(self, backend, key, work, time, compiled):
+        """Update the factor of an operator type from a measured time."""
+        entry = self.data[backend]
+        time -= entry["overhead"]
+        if not compiled:
+            time -= entry["compile_time"]
+        if time <= 0 or work == 0:
+            return
+        measured = time / (entry["pair_cost"] * work)
+        entry["factors"][key] = (1 - _FACTOR_UPDATE_WEIGHT) * self.factor(
+            backend, key
+        ) + _FACTOR_UPDATE_WEIGHT * measured
+
+
+def calibrate(backends, refine_levels=(2, 3)):
+    """
+    Calibrate the cost model for given backends.
+
+    A Laplace single layer operator is assembled on two regular spheres.
+    The first assembly on the smaller sphere includes the compilation of
+    the kernels. Its repetition and the assembly on the larger sphere
+    determine overhead and cost per unit of work.
+    """
+    import time
+    import numpy as np
+    import bempp.api
+    from bempp.core.dispatcher import dense_assembler_dispatcher
+
+    parameters = bempp.api.GLOBAL_PARAMETERS
+    spaces = [
+        bempp.api.function_space(bempp.api.shapes.regular_sphere(level), "DP", 0)
+        for level in refine_levels
+    ]
+
+    def run(backend, space):
+        """Return the time of a regular assembly."""
+        descriptor = bempp.api.operators.boundary.laplace.single_layer(
+            space, space, space, assembler="dense", device_interface=backend
+        ).descriptor
+        result = np.zeros((space.global_dof_count, space.global_dof_count))
+        start = time.perf_counter()
+        dense_assembler_dispatcher(
+            backend, descriptor, space, space, parameters, result
+        )
+        _COMPILED.add((backend, kernel_key(descriptor, space, space)))
+        return time.perf_counter() - start
+
+    data = {}
+    for backend in backends:
+        bempp.api.log(f"Calibrating cost model for {backend}.")
+        first = run(backend, spaces[0])
+        small = run(backend, spaces[0])
+        large = run(backend, spaces[1])
+        small_work, large_work = [
+            assembly_work(space, space, parameters) for space in spaces
+        ]
+        pair_cost = max(large - small, 1e-12) / (large_work - small_work)
+        data[backend] = {
+            "overhead": max(small - pair_cost * small_work, 0.0),
+            "pair_cost": pair_cost,
+            "compile_time": max(first - small, 0.0),
+            "factors": {},
+        }
+    return CostModel(data)
+
+
+def load():
+    """Return all stored calibrations."""
+    try:
+        with open(cache_file()) as f:
+            return _json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+
+def save(model):
+    """Store the calibration of this machine."""
+    calibrations = load()
+    calibrations[machine_key()] = model.data
+    file_name = cache_file()
+    _os.makedirs(_os.path.dirname(file_name), exist_ok=True)
+    with open(file_name, "w") as f:
+        _json.dump(calibrations, f, indent=2)
+
+
+def get_cost_model(backends):
+    """Return the cost model of this machine and calibrate it if necessary."""
+    # pylint: disable=W0603
+    global _MODEL
+
+    if _MODEL is None:
+        _MODEL = CostModel(load().get(machine_key()))
+
+    missing = [backend for backend in backends if backend not in _MODEL.data]
+    if missing:
+        _MODEL.data.update(calibrate(missing).data)
+        save(_MODEL)
+    return _MODEL
+
+
+def select_device_interface(operator_descriptor, domain, dual_to_range, parameters):
+    """Return the fastest device interface for a dense assembly."""
+    backends = available_backends(operator_descriptor.precision)
+    if len(backends) == 1:
+        return backends[0]
+
+    key = kernel_key(operator_descriptor, domain, dual_to_range)
+    work = assembly_work(domain, dual_to_range, parameters)
+    return get_cost_model(backends).select(key, work, backends)
+
+
+def record_assembly(
+    device_interface,
+    operator_descriptor,
+    domain,
+    dual_to_range,
+    parameters,
+    time,
+    selected=True,
+):
+    """
+    Record a dense assembly.
+
+    The kernels of the operator are marked as compiled for the device
+    interface. If the device interface was selected by the cost model,
+    the factor of the operator type is updated with the measured time.
+    """
+    # pylint: disable=W0603
+    global _UNSAVED_UPDATES
+    global _ATEXIT_REGISTERED
+
+    key = kernel_key(operator_descriptor, domain, dual_to_range)
+    compiled = (device_interface, key) in _COMPILED
+    _COMPILED.add((device_interface, key))
+
+    if not selected or _MODEL is None or device_interface not in _MODEL.data:
+        return
+    _MODEL.update(
+        device_interface,
+        key,
+        assembly_work(domain, dual_to_range, parameters),
+        time,
+        compiled,
+    )
+
+    if not _ATEXIT_REGISTERED:
+        import atexit
+
+        atexit.register(flush)
+        _ATEXIT_REGISTERED = True
+
+    _UNSAVED_UPDATES += 1
+    if _UNSAVED_UPDATES >= _SAVE_INTERVAL:
+        flush()
+
+
+def flush():
+    """Store the updated factors of the cost model."""
+    # pylint: disable=W0603
+    global _UNSAVED_UPDATES
+
+    if _UNSAVED_UPDATES and _MODEL is not None:
+        save(_MODEL)
+    _UNSAVED_UPDATES = 0
+
+
+def resolve_device_interface(device_interface):
+    """
+    Resolve the device interface 'auto' for assemblers without cost model.
+
+    Returns 'opencl' if an OpenCL driver is available and 'numba' otherwise.
+    Other device interfaces are returned unchanged.
+    """
+    if device_interface != "auto":
+        return device_interface
+    if opencl_available():
+        return "opencl"
+    return "numba"
@@ -19,7 +19,6 @@ class DenseAssembler(_assembler.AssemblerBase):
         from bempp.api.assembly.discrete_boundary_operator import (
             DenseDiscreteBoundaryOperator,
         )
-        from bempp.api.utils.helpers import promote_to_double_precision
 
         if (
             self.domain.requires_dof_transformation
@@ -39,28 +38,103 @@ class DenseAssembler(_assembler.AssemblerBase):
         # numba_kernel_function_singular,
         # ) = select_numba_kernels(operator_descriptor, mode="singular")
 
-        mat = assemble_dense(
+        if "previous_weak_form" in kwargs:
+            mat = reassemble_dense(
+                kwargs["previous_weak_form"],
+                kwargs["changed_elements"],
+                self.domain,
+                self.dual_to_range,
+                self.parameters,
+                operator_descriptor,
+                device_interface,
+            )
+        else:
+            mat = assemble_dense(
+                self.domain,
+                self.dual_to_range,
+                self.parameters,
+                operator_descriptor,
+                device_interface,
+            )
+
+        if self.parameters.assembly.always_promote_to_double:
+            dtype = _np.promote_types(mat.dtype, "float64")
+        else:
+            dtype = mat.dtype
+
+        storage_precision = self.parameters.assembly.dense.storage_precision
+        if storage_precision is None:
+            return DenseDiscreteBoundaryOperator(mat.astype(dtype, copy=False))
+        return DenseDiscreteBoundaryOperator(mat, dtype).with_storage_precision(
+            storage_precision
+        )
+
+    def result_type(self, operator_descriptor, precision):
+        """Return the dtype of the assembled weak form."""
+        from bempp.api.utils.helpers import get_type
+
+        if self.parameters.assembly.always_promote_to_double:
+            precision = "double"
+        else:
+            precision = operator_descriptor.precision
+
+        if operator_descriptor.is_complex:
+            return _np.dtype(get_type(precision).complex)
+        return _np.dtype(get_type(precision).real)
+
+    def accumulate(
+        self, operator_descriptor, device_interface, precision, result, alpha
+    ):
+        """Add alpha times the weak form to the dense array result in place."""
+        if (
+            self.domain.requires_dof_transformation
+            or self.dual_to_range.requires_dof_transformation
+        ):
+            raise ValueError(
+                "Spaces that require dof transformations not supported for dense assembly."
+            )
+
+        # The assemblers sum into the result. Other coefficients require a
+        # separate array for the contribution, which is scaled in place.
+        if alpha == 1:
+            contribution = result
+        else:
+            contribution = _np.zeros_like(result)
+
+        assemble_dense(
             self.domain,
             self.dual_to_range,
             self.parameters,
             operator_descriptor,
             device_interface,
+            result=contribution,
         )
 
-        if self.parameters.assembly.always_promote_to_double:
-            mat = promote_to_double_precision(mat)
-
-        return DenseDiscreteBoundaryOperator(mat)
+        if contribution is not result:
+            contribution *= alpha
+            result += contribution
 
 
 def assemble_dense(
-    domain, dual_to_range, parameters, operator_descriptor, device_interface
+    domain,
+    dual_to_range,
+    parameters,
+    operator_descriptor,
+    device_interface,
+    result=None,
 ):
-    """Assembles the operator and returns a dense matrix."""
+    """
+    Assembles the operator and returns a dense matrix.
+
+    If result is given, the operator is summed into this array.
+    """
+    import time
     import bempp.api
     from bempp.api.utils.helpers import get_type
     from bempp.core.dispatcher import dense_assembler_dispatcher
     from bempp.core.singular_assembler import assemble_singular_part
+    from bempp.core import cost_model
+    from bempp.api.utils import instrumentation
 
     precision = operator_descriptor.precision
 
@@ -72,8 +146,16 @@ def assemble_dense(
     else:
         result_type = get_type(precision).real
 
-    result = _np.zeros((rows, cols), dtype=result_type)
+    if result is None:
+        result = _np.zeros((rows, cols), dtype=result_type)
 
+    selected = device_interface == "auto"
+    if selected:
+        device_interface = cost_model.select_device_interface(
+            operator_descriptor, domain, dual_to_range, parameters
+        )
+
+    start = time.perf_counter()
     with bempp.api.Timer(
         message=f"Regular assembler:{operator_descriptor.identifier}:{device_interface}"
     ):
@@ -85,6 +167,19 @@ def assemble_dense(
             parameters,
             result,
         )
+    cost_model.record_assembly(
+        device_interface,
+        operator_descriptor,
+        domain,
+        dual_to_range,
+        parameters,
+        time.perf_counter() - start,
+        selected,
+    )
+    instrumentation.count(
+        "element pairs",
+        dual_to_range.number_of_support_elements * domain.number_of_support_elements,
+    )
 
     grids_identical = domain.grid == dual_to_range.grid
 
@@ -111,11 +206,171 @@ def assemble_dense(
             * test_multipliers[singular_rows]
         )
 
-        _np.add.at(result, (rows, cols), values)
+        with instrumentation.span("scatter"):
+            _np.add.at(result, (rows, cols), values)
 
     return result
 
 
+def reassemble_dense(
+    previous,
+    changed_elements,
+    domain,
+    dual_to_range,
+    parameters,
+    operator_descriptor,
+    device_interface,
+):
+    """
+    Update a dense matrix after the geometry of some elements changed.
+
+    The matrix previous must have been assembled for the same operator
+    on a grid with the same topology. Only the rows and columns
+    associated with dofs of the changed elements are recomputed. All
+    other entries are copied from previous.
+    """
+    import bempp.api
+
+    if device_interface.split("_")[0] != "numba" or domain.grid != dual_to_range.grid:
+        # Restricted assembly is only implemented for Numba on identical grids.
+        return assemble_dense(
+            domain, dual_to_range, parameters, operator_descriptor, device_interface
+        )
+
+    result = _np.array(previous, copy=True)
+
+    changed = _np.zeros(domain.grid.number_of_elements, dtype=_np.bool_)
+    changed[changed_elements] = True
+
+    changed_rows = _np.unique(
+        dual_to_range.local2global[changed & dual_to_range.support]
+    )
+    changed_cols = _np.unique(domain.local2global[changed & domain.support])
+
+    with bempp.api.Timer(
+        message=(
+            f"Incremental assembler:{operator_descriptor.identifier}:"
+            + f"{len(changed_rows)} rows, {len(changed_cols)} columns"
+        )
+    ):
+        if len(changed_rows) > 0:
+            # Rows belonging to changed dofs, assembled against all columns.
+            row_map = _compressed_dof_map(changed_rows, dual_to_range.grid_dof_count)
+            block = _assemble_block(
+                domain,
+                dual_to_range,
+                parameters,
+                operator_descriptor,
+                device_interface,
+                row_map,
+                _np.arange(domain.grid_dof_count, dtype="uint32"),
+                (len(changed_rows) + 1, domain.grid_dof_count),
+                result.dtype,
+                test_mask=_elements_with_dofs(dual_to_range, changed_rows),
+            )
+            result[changed_rows, :] = block[:-1, :]
+
+        if len(changed_cols) > 0:
+            # Columns belonging to changed dofs, assembled against the remaining rows.
+            row_map = _np.arange(dual_to_range.grid_dof_count, dtype="uint32")
+            row_map[changed_rows] = dual_to_range.grid_dof_count
+            col_map = _compressed_dof_map(changed_cols, domain.grid_dof_count)
+            block = _assemble_block(
+                domain,
+                dual_to_range,
+                parameters,
+                operator_descriptor,
+                device_interface,
+                row_map,
+                col_map,
+                (dual_to_range.grid_dof_count + 1, len(changed_cols) + 1),
+                result.dtype,
+                trial_mask=_elements_with_dofs(domain, changed_cols),
+            )
+            unchanged_rows = _np.flatnonzero(row_map < dual_to_range.grid_dof_count)
+            result[_np.ix_(unchanged_rows, changed_cols)] = block[unchanged_rows, :-1]
+
+    return result
+
+
+def _elements_with_dofs(space, dofs):
+    """Return a boolean array of the support elements that have one of the dofs."""
+    return space.support & _np.any(_np.isin(space.local2global, dofs), axis=1)
+
+
+def _compressed_dof_map(dofs, dof_count):
+    """Map the given dofs to 0, 1, ... and all other dofs to len(dofs)."""
+    dof_map = _np.full(dof_count, len(dofs), dtype="uint32")
+    dof_map[dofs] = _np.arange(len(dofs), dtype="uint32")
+    return dof_map
+
+
+def _assemble_block(
+    domain,
+    dual_to_range,
+    parameters,
+    operator_descriptor,
+    device_interface,
+    row_map,
+    col_map,
+    shape,
+    dtype,
+    test_mask=None,
+    trial_mask=None,
+):
+    """
+    Assemble the operator into a compressed block.
+
+    The dof maps row_map and col_map give the row and column of each
+    dof in the block. Dofs outside of the block are mapped to the last
+    row or column, which must be discarded. The boolean arrays test_mask
+    and trial_mask restrict the assembly to elements that contribute to
+    the block.
+    """
+    from bempp.core.numba_assemblers import dense_assembler
+    from bempp.core.singular_assembler import assemble_singular_part
+
+    test_local2global = row_map[dual_to_range.local2global]
+    trial_local2global = col_map[domain.local2global]
+
+    block = _np.zeros(shape, dtype=dtype)
+
+    dense_assembler(
+        device_interface,
+        operator_descriptor,
+        domain,
+        dual_to_range,
+        parameters,
+        block,
+        test_mask=test_mask,
+        trial_mask=trial_mask,
+        test_local2global=test_local2global,
+        trial_local2global=trial_local2global,
+    )
+
+    singular_rows, singular_cols, singular_values = assemble_singular_part(
+        domain.localised_space,
+        dual_to_range.localised_space,
+        parameters,
+        operator_descriptor,
+        device_interface,
+        test_support=test_mask,
+        trial_support=trial_mask,
+    )
+
+    rows = test_local2global.ravel()[singular_rows]
+    cols = trial_local2global.ravel()[singular_cols]
+    values = (
+        singular_values
+        * domain.local_multipliers.ravel()[singular_cols]
+        * dual_to_range.local_multipliers.ravel()[singular_rows]
+    )
+
+    _np.add.at(block, (rows, cols), values)
+
+    return block
+
+
 # @_timeit
 # def assemble_dense(
 # domain,
@@ -0,0 +1,389 @@
+"""Far-field evaluation on tensor product grids of directions."""
+
+import numba as _numba
+import numpy as _np
+
+from bempp.core.numba_kernels import get_piola_transform
+from bempp.core.numba_kernels import get_edge_lengths
+
+M_INV_4PI = 1.0 / (4 * _np.pi)
+
+# Far-field operators that can be evaluated on a direction grid. The far
+# field is assembled from a scalar and a vector moment sum over all surface
+# quadrature points. The second and third entry specify which of the two
+# sums is required.
+_FAR_FIELD_TYPES = {
+    ("helmholtz_far_field_single_layer", "default_scalar"): (
+        "helmholtz_single_layer",
+        True,
+        False,
+    ),
+    ("helmholtz_far_field_double_layer", "default_scalar"): (
+        "helmholtz_double_layer",
+        False,
+        True,
+    ),
+    ("helmholtz_far_field_single_layer", "maxwell_electric_far_field"): (
+        "maxwell_electric_field",
+        True,
+        True,
+    ),
+    ("helmholtz_far_field_single_layer", "maxwell_magnetic_far_field"): (
+        "maxwell_magnetic_field",
+        False,
+        True,
+    ),
+}
+
+
+def direction_grid_points(theta, phi):
+    """
+    Return the directions of a tensor product grid of angles.
+
+    The direction with index i * len(phi) + j is the unit vector with
+    polar angle theta[i] and azimuthal angle phi[j].
+    """
+    theta = _np.asarray(theta, dtype=_np.float64)
+    phi = _np.asarray(phi, dtype=_np.float64)
+    sin_theta = _np.sin(theta)
+
+    return _np.vstack(
+        [
+            _np.outer(sin_theta, _np.cos(phi)).ravel(),
+            _np.outer(sin_theta, _np.sin(phi)).ravel(),
+            _np.outer(_np.cos(theta), _np.ones_like(phi)).ravel(),
+        ]
+    )
+
+
+class DirectionGridFarFieldAssembler(object):
+    """
+    Far-field assembler for tensor product grids of directions.
+
+    The phase exp(-ik d.y) of the far-field kernel is factorised into a
+    polar part exp(-ik cos(theta) y3), which is computed once for each
+    polar angle and reused along the azimuthal direction, and an azimuthal
+    part. Optionally, the far field is only computed on a coarse grid
+    that resolves the band limit of the far-field pattern and then
+    interpolated exactly with a double Fourier series onto the requested
+    directions.
+    """
+
+    def __init__(
+        self, space, operator_descriptor, directions, device_interface, parameters
+    ):
+        """Create a direction grid far-field assembler."""
+        from bempp.api.integration.triangle_gauss import rule
+
+        key = (operator_descriptor.kernel_type, operator_descriptor.assembly_type)
+        if key not in _FAR_FIELD_TYPES:
+            raise ValueError(
+                "Direction grid evaluation is not supported for "
+                + f"{operator_descriptor.identifier}."
+            )
+
+        (
+            self._far_field_type,
+            self._scalar_moments,
+            self._vector_moments,
+        ) = _FAR_FIELD_TYPES[key]
+
+        theta, phi = directions
+        self._theta = _np.ascontiguousarray(theta, dtype=_np.float64)
+        self._phi = _np.ascontiguousarray(phi, dtype=_np.float64)
+
+        self.space = space
+        self.points = direction_grid_points(self._theta, self._phi)
+
+        self._options = parameters.far_field
+        self._wavenumber = (
+            operator_descriptor.options[0] + 1j * operator_descriptor.options[1]
+        )
+
+        self._localised_space = space.localised_space
+        self._grid_data = self._localised_space.grid.data("double")
+        self._support_elements = self._localised_space.support_elements
+        self._quad_points, self._quad_weights = rule(parameters.quadrature.regular)
+
+        self._sources = _global_quad_points(
+            self._grid_data, self._support_elements, self._quad_points
+        )
+
+        # Shift the sources to their center to minimize the band limit of
+        # the far-field pattern.
+        self._center = 0.5 * (
+            _np.min(self._sources, axis=1) + _np.max(self._sources, axis=1)
+        )
+        self._sources -= self._center[:, None]
+        self._radius = _np.max(_np.linalg.norm(self._sources, axis=0))
+
+    def evaluate(self, x):
+        """Evaluate the far field."""
+        x_transformed = self.space.map_to_full_grid @ (
+            self.space.dof_transformation @ x
+        )
+        x_transformed = x_transformed.astype(_np.complex128)
+
+        scalar_weights, vector_weights = self._source_weights(x_transformed)
+
+        ntheta = len(self._theta)
+        nphi = len(self._phi)
+        coarse_ntheta, coarse_nphi = self._coarse_grid_size()
+
+        if self._options.interpolation and coarse_ntheta * coarse_nphi < ntheta * nphi:
+            coarse_theta = (_np.arange(coarse_ntheta) + 0.5) * _np.pi / coarse_ntheta
+            coarse_phi = 2 * _np.pi * _np.arange(coarse_nphi) / coarse_nphi
+            moments = _interpolate(
+                self._moment_sums(
+                    coarse_theta, coarse_phi, scalar_weights, vector_weights
+                ),
+                self._theta,
+                self._phi,
+            )
+        else:
+            moments = self._moment_sums(
+                self._theta, self._phi, scalar_weights, vector_weights
+            )
+
+        scalar_sum = moments[0].ravel()
+        vector_sum = moments[1:].reshape(3, -1)
+
+        directions = self.points
+        phase = M_INV_4PI * _np.exp(
+            -1j * _np.real(self._wavenumber) * (self._center @ directions)
+        )
+
+        if self._far_field_type == "helmholtz_single_layer":
+            result = scalar_sum.reshape(1, -1)
+        elif self._far_field_type == "helmholtz_double_layer":
+            result = (
+                -1j
+                * _np.real(self._wavenumber)
+                * _np.sum(directions * vector_sum, axis=0).reshape(1, -1)
+            )
+        elif self._far_field_type == "maxwell_electric_field":
+            result = 1j * self._wavenumber * vector_sum - directions * scalar_sum
+        else:
+            result = _np.cross(directions, 1j * self._wavenumber * vector_sum, axis=0)
+
+        return result * phase
+
+    def _coarse_grid_size(self):
+        """Return the size of a grid that resolves the far-field pattern."""
+        kr = abs(_np.real(self._wavenumber)) * self._radius
+        digits = self._options.interpolation_digits
+        bandwidth = int(_np.ceil(kr + 1.8 * digits ** (2.0 / 3) * kr ** (1.0 / 3)))
+        return bandwidth + 2, 2 * (bandwidth + 2)
+
+    def _source_weights(self, x):
+        """Return the scalar and vector weights of the surface quadrature points."""
+        if self._far_field_type in ["helmholtz_single_layer", "helmholtz_double_layer"]:
+            fun_values = self._localised_space.shapeset.evaluate(self._quad_points)[0]
+            return _scalar_source_weights(
+                self._grid_data,
+                self._support_elements,
+                self._localised_space.normal_multipliers,
+                self._quad_weights,
+                fun_values,
+                x,
+            )
+        else:
+            return _maxwell_source_weights(
+                self._grid_data,
+                self._support_elements,
+                self._quad_points,
+                self._quad_weights,
+                x,
+            )
+
+    def _moment_sums(self, theta, phi, scalar_weights, vector_weights):
+        """Compute the moment sums on a tensor grid of directions."""
+        return _direction_grid_sums(
+            theta,
+            phi,
+            _np.real(self._wavenumber),
+            self._sources,
+            scalar_weights,
+            vector_weights,
+            self._scalar_moments,
+            self._vector_moments,
+        )
+
+
+def _interpolate(values, theta, phi):
+    """
+    Interpolate values from a coarse grid onto a tensor grid of angles.
+
+    The coarse grid consists of the polar angles (i + 1/2) * pi / ntheta
+    and the azimuthal angles 2 * pi * j / nphi with an even number nphi.
+    Extending the values to polar angles in [pi, 2 * pi) gives a periodic
+    function in both angles that is interpolated by a double Fourier
+    series.
+    """
+    ntheta, nphi = values.shape[-2:]
+
+    extended = _np.concatenate(
+        [values, _np.roll(values[..., ::-1, :], -(nphi // 2), axis=-1)], axis=-2
+    )
+    coefficients = _np.fft.fft2(extended) / (2 * ntheta * nphi)
+
+    # Remove the Nyquist frequencies which cannot be interpolated.
+    coefficients[..., ntheta, :] = 0
+    coefficients[..., :, nphi // 2] = 0
+
+    theta_frequencies = _np.fft.fftfreq(2 * ntheta, 1.0 / (2 * ntheta))
+    phi_frequencies = _np.fft.fftfreq(nphi, 1.0 / nphi)
+
+    theta_basis = _np.exp(
+        1j * _np.outer(theta - 0.5 * _np.pi / ntheta, theta_frequencies)
+    )
+    phi_basis = _np.exp(1j * _np.outer(phi_frequencies, phi))
+
+    return theta_basis @ coefficients @ phi_basis
+
+
+@_numba.njit
+def _global_quad_points(grid_data, support_elements, quad_points):
+    """Return the global quadrature points of the support elements."""
+    nelements = len(support_elements)
+    nquad_points = quad_points.shape[1]
+    global_points = _np.empty((3, nelements * nquad_points), dtype=_np.float64)
+    for index in range(nelements):
+        global_points[
+            :, nquad_points * index : nquad_points * (index + 1)
+        ] = grid_data.local2global(support_elements[index], quad_points)
+    return global_points
+
+
+@_numba.njit
+def _scalar_source_weights(
+    grid_data, support_elements, normal_multipliers, quad_weights, fun_values, x
+):
+    """Return the weights of the quadrature points for scalar spaces."""
+    nelements = len(support_elements)
+    nshape_funs = fun_values.shape[0]
+    nquad_points = len(quad_weights)
+    scalar_weights = _np.zeros(nelements * nquad_points, dtype=_np.complex128)
+    vector_weights = _np.zeros((3, nelements * nquad_points), dtype=_np.complex128)
+    for index in range(nelements):
+        element = support_elements[index]
+        for quad_index in range(nquad_points):
+            source_index = nquad_points * index + quad_index
+            for fun_index in range(nshape_funs):
+                scalar_weights[source_index] += (
+                    grid_data.integration_elements[element]
+                    * quad_weights[quad_index]
+                    * fun_values[fun_index, quad_index]
+                    * x[nshape_funs * element + fun_index]
+                )
+            for dim in range(3):
+                vector_weights[dim, source_index] = (
+                    scalar_weights[source_index]
+                    * grid_data.normals[element, dim]
+                    * normal_multipliers[element]
+                )
+    return scalar_weights, vector_weights
+
+
+@_numba.njit
+def _maxwell_source_weights(grid_data, support_elements, quad_points, quad_weights, x):
+    """Return the weights of the quadrature points for div-conforming spaces."""
+    nelements = len(support_elements)
+    nquad_points = len(quad_weights)
+    basis_functions = get_piola_transform(grid_data, support_elements, quad_points)
+    edge_lengths = get_edge_lengths(grid_data, support_elements)
+
+    scalar_weights = _np.zeros(nelements * nquad_points, dtype=_np.complex128)
+    vector_weights = _np.zeros((3, nelements * nquad_points), dtype=_np.complex128)
+    for index in range(nelements):
+        element = support_elements[index]
+        for quad_index in range(nquad_points):
+            source_index = nquad_points * index + quad_index
+            for fun_index in range(3):
+                factor = (
+                    quad_weights[quad_index]
+                    * x[3 * element + fun_index]
+                    * edge_lengths[index, fun_index]
+                )
+                for dim in range(3):
+                    vector_weights[dim, source_index] += (
+                        factor
+                        * basis_functions[index, fun_index, dim, quad_index]
+                        * grid_data.integration_elements[element]
+                    )
+                scalar_weights[source_index] += 2 * factor
+    return scalar_weights, vector_weights
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _direction_grid_sums(
+    theta,
+    phi,
+    wavenumber,
+    sources,
+    scalar_weights,
+    vector_weights,
+    compute_scalar,
+    compute_vector,
+):
+    """
+    Compute the moment sums on a tensor grid of directions.
+
+    Returns an array of shape (4, len(theta), len(phi)) whose first row
+    contains the sum of the scalar weights times exp(-ik d.y) and whose
+    remaining rows contain the corresponding sums of the vector weights.
+    """
+    ntheta = len(theta)
+    nphi = len(phi)
+    nsources = sources.shape[1]
+
+    result = _np.zeros((4, ntheta, nphi), dtype=_np.complex128)
+
+    cos_phi = _np.cos(phi)
+    sin_phi = _np.sin(phi)
+
+    for theta_index in _numba.prange(ntheta):
+        sin_theta = _np.sin(theta[theta_index])
+        cos_theta = _np.cos(theta[theta_index])
+
+        # Apply the polar part of the phase once for all azimuthal angles.
+        polar_scalar = _np.zeros(nsources, dtype=_np.complex128)
+        polar_vector = _np.zeros((3, nsources), dtype=_np.complex128)
+        for source_index in range(nsources):
+            arg = wavenumber * cos_theta * sources[2, source_index]
+            polar = _np.cos(arg) - 1j * _np.sin(arg)
+            if compute_scalar:
+                polar_scalar[source_index] = polar * scalar_weights[source_index]
+            if compute_vector:
+                for dim in range(3):
+                    polar_vector[dim, source_index] = (
+                        polar * vector_weights[dim, source_index]
+                    )
+
+        for phi_index in range(nphi):
+            factor1 = wavenumber * sin_theta * cos_phi[phi_index]
+            factor2 = wavenumber * sin_theta * sin_phi[phi_index]
+            scalar_sum = 0j
+            vector_sum0 = 0j
+            vector_sum1 = 0j
+            vector_sum2 = 0j
+            for source_index in range(nsources):
+                arg = (
+                    factor1 * sources[0, source_index]
+                    + factor2 * sources[1, source_index]
+                )
+                azimuthal = _np.cos(arg) - 1j * _np.sin(arg)
+                if compute_scalar:
+                    scalar_sum += azimuthal * polar_scalar[source_index]
+                if compute_vector:
+                    vector_sum0 += azimuthal * polar_vector[0, source_index]
+                    vector_sum1 += azimuthal * polar_vector[1, source_index]
+                    vector_sum2 += azimuthal * polar_vector[2, source_index]
+            result[0, theta_index, phi_index] = scalar_sum
+            result[1, theta_index, phi_index] = vector_sum0
+            result[2, theta_index, phi_index] = vector_sum1
+            result[3, theta_index, phi_index] = vector_sum2
+
+    return result
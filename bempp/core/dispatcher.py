@@ -1,9 +1,33 @@
 """Dispatch kernel calls to different implementations."""
 
+from bempp.core.cost_model import resolve_device_interface
+
+# Assembly types that evaluate the geometry at each quadrature point
+# and hence support curved grids.
+CURVED_GRID_ASSEMBLY_TYPES = ["default_scalar", "fused_scalar", "default_sparse"]
+
+
+def check_curved_grid_support(operator_descriptor, *spaces):
+    """
+    Check that an operator can be assembled on the grids of given spaces.
+
+    Curved grids are supported for scalar operators with scalar spaces.
+    """
+    if not any(space.grid.is_curved for space in spaces):
+        return
+
+    if operator_descriptor.assembly_type not in CURVED_GRID_ASSEMBLY_TYPES or any(
+        space.codomain_dimension != 1 for space in spaces
+    ):
+        raise ValueError(
+            f"Operator {operator_descriptor.identifier} does not support curved grids."
+        )
+
 
 def singular_assembler_dispatcher(device_interface, *args):
     """Dispatch the singular assembler to the different implementations."""
-    interface_type = device_interface.split("_")[0]
+    interface_type = resolve_device_interface(device_interface).split("_")[0]
+    check_curved_grid_support(args[0], args[2], args[3])
 
     if interface_type == "opencl":
         from bempp.core.opencl_assemblers import singular_assembler
@@ -21,7 +45,8 @@ def singular_assembler_dispatcher(device_interface, *args):
 
 def dense_assembler_dispatcher(device_interface, *args):
     """Dispatcher for dense assemblers."""
-    interface_type = device_interface.split("_")[0]
+    interface_type = resolve_device_interface(device_interface).split("_")[0]
+    check_curved_grid_support(*args[:3])
 
     if interface_type == "opencl":
         from bempp.core.opencl_assemblers import dense_assembler
@@ -37,9 +62,41 @@ def dense_assembler_dispatcher(device_interface, *args):
         raise ValueError("Unknown assembler.")
 
 
+def sparse_csr_assembler_dispatcher(device_interface, *args):
+    """Dispatcher for the CSR data of sparse operators."""
+    interface_type = resolve_device_interface(device_interface).split("_")[0]
+    check_curved_grid_support(*args[:3])
+
+    if interface_type == "opencl":
+        from bempp.core.opencl_kernels import select_cl_sparse_kernel
+
+        # The OpenCL identity kernels assume flat triangles and only exist
+        # for some pairs of spaces.
+        if args[1].grid.is_curved or select_cl_sparse_kernel(*args[:3]) is None:
+            interface_type = "numba"
+
+    if interface_type == "opencl":
+        from bempp.core.opencl_assemblers import sparse_csr_assembler
+
+        sparse_csr_assembler(device_interface, *args)
+
+    elif interface_type == "numba":
+        from bempp.core.numba_assemblers import sparse_csr_assembler
+
+        sparse_csr_assembler(device_interface, *args)
+
+    else:
+        raise ValueError("Unknown assembler.")
+
+
 def potential_dispatcher(device_interface, *args):
     """Potential assembler dispatcher."""
-    interface_type = device_interface.split("_")[0]
+    interface_type = resolve_device_interface(device_interface).split("_")[0]
+    check_curved_grid_support(args[1], args[0])
+
+    # The OpenCL potential kernels assume flat triangles.
+    if interface_type == "opencl" and args[0].grid.is_curved:
+        interface_type = "numba"
 
     if interface_type == "numba":
         from bempp.core.numba_assemblers import potential_assembler
@@ -0,0 +1,353 @@
+"""
+Assembly of boundary operators from single-layer moments.
+
+The moments of the single-layer kernel G of an operator on a grid are
+
+    M[3 * i + a, 3 * j + b] = int_{T_i} int_{T_j} G(x, y) l_a(x) l_b(y) dy dx,
+
+where l_a are the barycentric coordinates (the P1 shape functions) on the
+elements T_i and T_j. They are the weak form of the single layer operator
+on the localised discontinuous P1 space and are assembled once with the
+dense assembler, including the singular quadrature of adjacent elements.
+
+On flat triangles the following operators are linear combinations of the
+moments with elementwise constant weights, so that they are obtained by
+sparse-dense products without evaluating the kernel again:
+
+- single layer operators on piecewise constant and linear spaces,
+- Laplace, Helmholtz and modified Helmholtz hypersingular operators,
+  whose integration by parts formula only contains the elementwise
+  constant surface curls and normals,
+- the Maxwell electric field operator, since RWG functions are linear
+  in the barycentric coordinates and have constant divergence.
+
+The moments are cached per grid, kernel and quadrature order. They need
+nine times the memory of a dense matrix over the grid elements. If
+parameters.assembly.moments.cache_directory is set, they are stored in
+memory-mapped files in this directory instead of in memory. At most
+parameters.assembly.moments.cache_size moments are kept. The least
+recently used moments and their files are removed first.
+"""
+
+import collections as _collections
+import numpy as _np
+from bempp.api.assembly import assembler as _assembler
+
+_MOMENTS = _collections.OrderedDict()
+
+# Barycentric coefficients of the supported scalar shapesets.
+_BARYCENTRIC_COEFFICIENTS = {
+    "p0_discontinuous": _np.ones((1, 3)),
+    "p1_discontinuous": _np.eye(3),
+}
+
+# Gradients of the P1 shape functions on the reference element.
+_REFERENCE_GRADIENT = _np.array([[-1.0, 1.0, 0.0], [-1.0, 0.0, 1.0]])
+
+
+class MomentAssembler(_assembler.AssemblerBase):
+    """Assembler for integral operators from cached single-layer moments."""
+
+    # pylint: disable=useless-super-delegation
+    def __init__(self, domain, dual_to_range, parameters=None):
+        """Create a moment assembler instance."""
+        super().__init__(domain, dual_to_range, parameters)
+
+    def assemble(
+        self, operator_descriptor, device_interface, precision, *args, **kwargs
+    ):
+        """Assemble the integral operator from the moments."""
+        from bempp.api.assembly.discrete_boundary_operator import (
+            DenseDiscreteBoundaryOperator,
+        )
+        from bempp.api.utils import instrumentation
+
+        domain = self.domain
+        dual_to_range = self.dual_to_range
+
+        if domain.grid != dual_to_range.grid:
+            raise ValueError("The moment assembler requires spaces on the same grid.")
+        if domain.grid.is_curved:
+            raise ValueError("The moment assembler does not support curved grids.")
+        if (
+            domain.requires_dof_transformation
+            or dual_to_range.requires_dof_transformation
+        ):
+            raise ValueError(
+                "Spaces that require dof transformations not supported for moment assembly."
+            )
+
+        assembly_type = operator_descriptor.assembly_type
+        if (
+            assembly_type == "default_scalar"
+            and operator_descriptor.kernel_type.endswith("single_layer")
+        ):
+            combine = _single_layer
+        elif assembly_type.endswith("hypersingular"):
+            combine = _hypersingular
+        elif assembly_type == "maxwell_electric_field":
+            combine = _electric_field
+        else:
+            raise ValueError(
+                f"Operator {operator_descriptor.identifier} not supported by the moment assembler."
+            )
+
+        moments = get_moments(
+            domain.grid, operator_descriptor, device_interface, self.parameters
+        )
+
+        with instrumentation.span("moment combination"):
+            mat = combine(operator_descriptor, domain, dual_to_range, moments)
+
+        return DenseDiscreteBoundaryOperator(
+            _np.ascontiguousarray(
+                mat, dtype=self.result_type(operator_descriptor, precision)
+            )
+        )
+
+    def result_type(self, operator_descriptor, precision):
+        """Return the dtype of the assembled weak form."""
+        from bempp.api.utils.helpers import get_type
+
+        if operator_descriptor.is_complex:
+            return _np.dtype(get_type(operator_descriptor.precision).complex)
+        return _np.dtype(get_type(operator_descriptor.precision).real)
+
+
+def get_moments(grid, operator_descriptor, device_interface, parameters):
+    """Return the single-layer moments for the kernel of an operator."""
+    import os
+    import uuid
+    import bempp.api
+    from bempp.api.operators import OperatorDescriptor
+    from bempp.api.utils.helpers import get_type
+    from bempp.api.utils import instrumentation
+    from bempp.core.dense_assembler import assemble_dense
+
+    space = bempp.api.function_space(grid, "DP", 1).localised_space
+    key = (
+        grid.id,
+        operator_descriptor.kernel_type,
+        tuple(operator_descriptor.options),
+        operator_descriptor.precision,
+        operator_descriptor.is_complex,
+        parameters.quadrature.adapted_order("regular", space),
+        parameters.quadrature.adapted_order("singular", space),
+    )
+    if key in _MOMENTS:
+        _MOMENTS.move_to_end(key)
+        return _MOMENTS[key][0]
+
+    # Make room for the new moments before they are assembled.
+    while _MOMENTS and len(_MOMENTS) >= parameters.assembly.moments.cache_size:
+        _remove_moments(_MOMENTS.popitem(last=False)[1])
+
+    descriptor = OperatorDescriptor(
+        operator_descriptor.kernel_type + "_moments",
+        operator_descriptor.options,
+        operator_descriptor.kernel_type,
+        "default_scalar",
+        operator_descriptor.precision,
+        operator_descriptor.is_complex,
+        None,
+        1,
+    )
+
+    types = get_type(operator_descriptor.precision)
+    dtype = types.complex if operator_descriptor.is_complex else types.real
+    shape = (space.global_dof_count, space.global_dof_count)
+
+    file_name = None
+    result = None
+    cache_directory = parameters.assembly.moments.cache_directory
+    if cache_directory is not None:
+        os.makedirs(cache_directory, exist_ok=True)
+        file_name = os.path.join(cache_directory, f"moments_{uuid.uuid4().hex}.npy")
+        result = _np.lib.format.open_memmap(
+            file_name, mode="w+", dtype=dtype, shape=shape
+        )
+
+    with instrumentation.span("moments", kernel=operator_descriptor.kernel_type):
+        moments = assemble_dense(
+            space, space, parameters, descriptor, device_interface, result
+        )
+
+    _MOMENTS[key] = (moments, file_name)
+    return moments
+
+
+def clear_moment_cache():
+    """Remove all cached moments and their files."""
+    while _MOMENTS:
+        _remove_moments(_MOMENTS.popitem()[1])
+
+
+def _remove_moments(entry):
+    """Remove the file of a cache entry."""
+    import os
+
+    _, file_name = entry
+    if file_name:
+        os.remove(file_name)
+
+
+def _weights(space, values):
+    """
+    Return a sparse matrix that maps the dofs of a space to element values.
+
+    values[k, a, c] is the weight of the local function a on the kth
+    support element for the cth value on this element. The row of this
+    value is ncomponents * element + c.
+    """
+    from scipy.sparse import coo_matrix
+
+    elements = space.support_elements
+    nfunctions, ncomponents = values.shape[1:]
+    shape = (len(elements), nfunctions, ncomponents)
+
+    rows = _np.broadcast_to(
+        ncomponents * elements.astype(_np.int64)[:, None, None]
+        + _np.arange(ncomponents)[None, None, :],
+        shape,
+    )
+    cols = _np.broadcast_to(space.local2global[elements][:, :, None], shape)
+    data = values * space.local_multipliers[elements][:, :, None]
+
+    return coo_matrix(
+        (data.ravel(), (rows.ravel(), cols.ravel())),
+        shape=(ncomponents * space.grid.number_of_elements, space.global_dof_count),
+    ).tocsr()
+
+
+def _combine(test_weights, moments, trial_weights):
+    """Return test_weights.T @ moments @ trial_weights."""
+    return test_weights.T @ (trial_weights.T @ moments.T).T
+
+
+def _element_moments(moments):
+    """Return the moments of the constant function on each element."""
+    nelements = moments.shape[0] // 3
+    return moments.reshape(nelements, 3, nelements, 3).sum(axis=(1, 3))
+
+
+def _barycentric_weights(space):
+    """Return the weights of the shape functions of a scalar space."""
+    identifier = space.shapeset.identifier
+    if identifier not in _BARYCENTRIC_COEFFICIENTS:
+        raise ValueError(
+            f"Shapeset {identifier} not supported by the moment assembler."
+        )
+    coefficients = _BARYCENTRIC_COEFFICIENTS[identifier]
+    return _weights(
+        space,
+        _np.broadcast_to(
+            coefficients, (space.number_of_support_elements,) + coefficients.shape
+        ),
+    )
+
+
+def _surface_curl_weights(space):
+    """Return the weights of the surface curls for each dimension."""
+    grid = space.grid
+    elements = space.support_elements
+    gradients = grid.jacobian_inverse_transposed[elements] @ _REFERENCE_GRADIENT
+    curls = (
+        _np.cross(grid.normals[elements][:, :, None], gradients, axis=1)
+        * space.normal_multipliers[elements][:, None, None]
+    )
+    return [_weights(space, curls[:, dim, :, None]) for dim in range(3)]
+
+
+def _normal_weights(space):
+    """Return the weights of the shape functions times the normal components."""
+    grid = space.grid
+    elements = space.support_elements
+    normals = grid.normals[elements] * space.normal_multipliers[elements][:, None]
+    return [
+        _weights(space, normals[:, dim, None, None] * _np.eye(3)[None, :, :])
+        for dim in range(3)
+    ]
+
+
+def _rwg_weights(space):
+    """
+    Return the weights of the RWG functions and of their divergences.
+
+    On an element with corners X_0, X_1, X_2 the local function a is
+    l_a / |J| (x - X_{2 - a}) = sum_c l_c(x) l_a / |J| (X_c - X_{2 - a}),
+    where l_a is the length of the edge opposite to X_{2 - a}. Its
+    divergence is 2 l_a / |J|.
+    """
+    grid = space.grid
+    elements = space.support_elements
+    corners = grid.vertices[:, grid.elements[:, elements]].transpose(2, 1, 0)
+    integration_elements = grid.integration_elements[elements]
+
+    opposite = corners[:, ::-1, :]
+    edge_lengths = _np.linalg.norm(
+        corners[:, [0, 2, 1], :] - corners[:, [1, 0, 2], :], axis=2
+    )
+    scale = edge_lengths / integration_elements[:, None]
+
+    # values[k, a, c, dim] = l_a / |J| (X_c - X_{2 - a})[dim]
+    values = (corners[:, None, :, :] - opposite[:, :, None, :]) * scale[
+        :, :, None, None
+    ]
+    return (
+        [_weights(space, values[:, :, :, dim]) for dim in range(3)],
+        _weights(space, 2 * scale[:, :, None]),
+    )
+
+
+def _single_layer(operator_descriptor, domain, dual_to_range, moments):
+    """Single layer operator from the moments."""
+    return _combine(
+        _barycentric_weights(dual_to_range), moments, _barycentric_weights(domain)
+    )
+
+
+def _hypersingular(operator_descriptor, domain, dual_to_range, moments):
+    """Hypersingular operator from the moments by integration by parts."""
+    for space in [domain, dual_to_range]:
+        if space.shapeset.identifier != "p1_discontinuous":
+            raise ValueError("Shapesets must be of type 'p1_discontinuous'.")
+
+    element_moments = _element_moments(moments)
+    result = sum(
+        _combine(test, element_moments, trial)
+        for test, trial in zip(
+            _surface_curl_weights(dual_to_range), _surface_curl_weights(domain)
+        )
+    )
+
+    options = operator_descriptor.options
+    if operator_descriptor.assembly_type == "helmholtz_hypersingular":
+        factor = -((options[0] + 1j * options[1]) ** 2)
+    elif operator_descriptor.assembly_type == "modified_helmholtz_hypersingular":
+        factor = options[0] ** 2
+    else:
+        return result
+
+    return result + factor * sum(
+        _combine(test, moments, trial)
+        for test, trial in zip(_normal_weights(dual_to_range), _normal_weights(domain))
+    )
+
+
+def _electric_field(operator_descriptor, domain, dual_to_range, moments):
+    """Maxwell electric field operator from the moments."""
+    wavenumber = operator_descriptor.options[0] + 1j * operator_descriptor.options[1]
+    test_values, test_divergences = _rwg_weights(dual_to_range)
+    trial_values, trial_divergences = _rwg_weights(domain)
+
+    result = (
+        -1j
+        * wavenumber
+        * sum(
+            _combine(test, moments, trial)
+            for test, trial in zip(test_values, trial_values)
+        )
+    )
+    return result - _combine(
+        test_divergences, _element_moments(moments), trial_divergences
+    ) / (1j * wavenumber)
@@ -8,21 +8,19 @@ def singular_assembler(
     grid,
     domain,
     dual_to_range,
-    test_points,
-    trial_points,
-    quad_weights,
-    test_elements,
-    trial_elements,
-    test_offsets,
-    trial_offsets,
-    weights_offsets,
-    number_of_quad_points,
+    rule,
     kernel_options,
     result,
 ):
-    """Numba assembler for the singular part of integral operators."""
+    """
+    Numba assembler for the singular part of integral operators.
+
+    The Numba kernels take the concatenated rules with explicit offsets
+    for each element pair, see rule.get_arrays.
+    """
     from bempp.api.utils.helpers import get_type
     from bempp.core.numba_kernels import select_numba_kernels
+    from bempp.api.utils import instrumentation
 
     numba_assembly_function, numba_kernel_function = select_numba_kernels(
         operator_descriptor, mode="singular"
@@ -33,43 +31,53 @@ def singular_assembler(
     precision = "double"
     dtype = get_type(precision).real
 
-    numba_assembly_function(
-        grid.data(precision),
-        test_points,
-        trial_points,
-        quad_weights,
-        test_elements,
-        trial_elements,
-        test_offsets,
-        trial_offsets,
-        weights_offsets,
-        number_of_quad_points,
-        dual_to_range.normal_multipliers,
-        domain.normal_multipliers,
-        dual_to_range.number_of_shape_functions,
-        domain.number_of_shape_functions,
-        dual_to_range.shapeset.evaluate,
-        domain.shapeset.evaluate,
-        numba_kernel_function,
-        _np.array(kernel_options, dtype=dtype),
-        result,
-    )
+    with instrumentation.span("kernel run"):
+        numba_assembly_function(
+            grid.data(precision),
+            *rule.get_arrays(),
+            dual_to_range.normal_multipliers,
+            domain.normal_multipliers,
+            dual_to_range.number_of_shape_functions,
+            domain.number_of_shape_functions,
+            dual_to_range.shapeset.evaluate,
+            domain.shapeset.evaluate,
+            numba_kernel_function,
+            _np.array(kernel_options, dtype=dtype),
+            result,
+        )
 
 
 def dense_assembler(
-    device_interface, operator_descriptor, domain, dual_to_range, parameters, result
+    device_interface,
+    operator_descriptor,
+    domain,
+    dual_to_range,
+    parameters,
+    result,
+    test_mask=None,
+    trial_mask=None,
+    test_local2global=None,
+    trial_local2global=None,
 ):
-    """Numba based dense assembler."""
+    """
+    Numba based dense assembler.
+
+    The optional boolean arrays test_mask and trial_mask restrict the
+    assembly to a subset of the test and trial elements. The optional
+    local2global maps replace those of the spaces to sum the element
+    contributions into a compressed result array.
+    """
     from bempp.core.numba_kernels import select_numba_kernels
     from bempp.api.utils.helpers import get_type
     from bempp.api.integration.triangle_gauss import rule
+    from bempp.api.utils import instrumentation
 
     (
         numba_assembly_function_regular,
         numba_kernel_function_regular,
     ) = select_numba_kernels(operator_descriptor, mode="regular")
 
-    order = parameters.quadrature.regular
+    order = parameters.quadrature.adapted_order("regular", domain, dual_to_range)
     quad_points, quad_weights = rule(order)
 
     # Perform Numba assembly always in double precision
@@ -81,6 +89,15 @@ def dense_assembler(
     test_indices, test_color_indexptr = dual_to_range.get_elements_by_color()
     trial_indices, trial_color_indexptr = domain.get_elements_by_color()
     number_of_test_colors = len(test_color_indexptr) - 1
+
+    if trial_mask is not None:
+        trial_indices = trial_indices[trial_mask[trial_indices]]
+
+    if test_local2global is None:
+        test_local2global = dual_to_range.local2global
+
+    if trial_local2global is None:
+        trial_local2global = domain.local2global
     # number_of_trial_colors = len(trial_color_indexptr) - 1
 
     # rows = dual_to_range.global_dof_count
@@ -90,33 +107,112 @@ def dense_assembler(
     nshape_trial = domain.number_of_shape_functions
     grids_identical = domain.grid == dual_to_range.grid
 
-    for test_color_index in range(number_of_test_colors):
-        numba_assembly_function_regular(
-            dual_to_range.grid.data(precision),
-            domain.grid.data(precision),
-            nshape_test,
-            nshape_trial,
-            test_indices[
+    with instrumentation.span("kernel run"):
+        for test_color_index in range(number_of_test_colors):
+            color_indices = test_indices[
                 test_color_indexptr[test_color_index] : test_color_indexptr[
                     1 + test_color_index
                 ]
-            ],
-            trial_indices,
-            dual_to_range.local_multipliers.astype(data_type),
-            domain.local_multipliers.astype(data_type),
-            dual_to_range.local2global,
-            domain.local2global,
-            dual_to_range.normal_multipliers,
-            domain.normal_multipliers,
-            quad_points.astype(data_type),
-            quad_weights.astype(data_type),
-            numba_kernel_function_regular,
-            _np.array(operator_descriptor.options, dtype=data_type),
-            grids_identical,
-            dual_to_range.shapeset.evaluate,
-            domain.shapeset.evaluate,
-            result,
-        )
+            ]
+            if test_mask is not None:
+                color_indices = color_indices[test_mask[color_indices]]
+            if len(color_indices) == 0 or len(trial_indices) == 0:
+                continue
+            numba_assembly_function_regular(
+                dual_to_range.grid.data(precision),
+                domain.grid.data(precision),
+                nshape_test,
+                nshape_trial,
+                color_indices,
+                trial_indices,
+                dual_to_range.local_multipliers.astype(data_type),
+                domain.local_multipliers.astype(data_type),
+                test_local2global,
+                trial_local2global,
+                dual_to_range.normal_multipliers,
+                domain.normal_multipliers,
+                quad_points.astype(data_type),
+                quad_weights.astype(data_type),
+                numba_kernel_function_regular,
+                _np.array(operator_descriptor.options, dtype=data_type),
+                grids_identical,
+                dual_to_range.shapeset.evaluate,
+                domain.shapeset.evaluate,
+                result,
+            )
+
+
+def _sparse_element_matrices(
+    device_interface,
+    operator_descriptor,
+    domain,
+    dual_to_range,
+    parameters,
+    elements,
+    result,
+):
+    """Numba assembler for the element matrices of sparse operators."""
+    from bempp.core.numba_kernels import select_numba_kernels
+    from bempp.api.integration.triangle_gauss import rule
+
+    numba_assembly_function, numba_kernel_function = select_numba_kernels(
+        operator_descriptor, mode="sparse"
+    )
+
+    quad_points, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", domain, dual_to_range)
+    )
+
+    # Perform Numba assembly always in double precision
+    precision = "double"
+
+    numba_assembly_function(
+        domain.grid.data(precision),
+        dual_to_range.number_of_shape_functions,
+        domain.number_of_shape_functions,
+        elements,
+        quad_points,
+        quad_weights,
+        dual_to_range.normal_multipliers,
+        domain.normal_multipliers,
+        dual_to_range.local_multipliers,
+        domain.local_multipliers,
+        dual_to_range.shapeset.evaluate,
+        domain.shapeset.evaluate,
+        dual_to_range.numba_evaluate,
+        domain.numba_evaluate,
+        numba_kernel_function,
+        result,
+    )
+
+
+def sparse_csr_assembler(
+    device_interface,
+    operator_descriptor,
+    domain,
+    dual_to_range,
+    parameters,
+    elements,
+    pattern,
+    data,
+):
+    """Numba assembler for the CSR data of sparse operators."""
+    nshape_test = dual_to_range.number_of_shape_functions
+    nshape_trial = domain.number_of_shape_functions
+
+    values = _np.zeros(nshape_test * nshape_trial * len(elements), dtype=data.dtype)
+
+    _sparse_element_matrices(
+        device_interface,
+        operator_descriptor,
+        domain,
+        dual_to_range,
+        parameters,
+        elements,
+        values,
+    )
+
+    data[:] = pattern.scatter(values)
 
 
 def potential_assembler(
@@ -131,7 +227,9 @@ def potential_assembler(
         operator_descriptor, mode="potential"
     )
 
-    quad_points, quad_weights = rule(parameters.quadrature.regular)
+    quad_points, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", space)
+    )
 
     # Perform Numba assembly always in double precision
     # precision = operator_descriptor.precision
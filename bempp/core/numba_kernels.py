@@ -15,6 +15,7 @@ def select_numba_kernels(operator_descriptor, mode="regular"):
         "modified_helmholtz_hypersingular": modified_helmholtz_hypersingular_singular,
         "maxwell_electric_field": maxwell_efield_singular,
         "maxwell_magnetic_field": maxwell_mfield_singular,
+        "maxwell_combined_field": maxwell_cfield_singular,
     }
 
     assembly_functions_regular = {
@@ -24,6 +25,7 @@ def select_numba_kernels(operator_descriptor, mode="regular"):
         "modified_helmholtz_hypersingular": modified_helmholtz_hypersingular_regular,
         "maxwell_electric_field": maxwell_efield_regular_assembler,
         "maxwell_magnetic_field": maxwell_mfield_regular_assembler,
+        "maxwell_combined_field": maxwell_cfield_regular_assembler,
     }
     assembly_function_potential = {
         "default_scalar": default_scalar_potential_kernel,
@@ -31,6 +33,8 @@ def select_numba_kernels(operator_descriptor, mode="regular"):
         "maxwell_magnetic_field": maxwell_mfield_potential,
         "maxwell_magnetic_far_field": maxwell_mfield_far_field,
         "maxwell_electric_far_field": maxwell_efield_far_field,
+        "fused_scalar": default_scalar_potential_kernel,
+        "fused_maxwell": fused_maxwell_potential,
     }
 
     assembly_functions_sparse = {"default_sparse": default_sparse_kernel}
@@ -47,6 +51,9 @@ def select_numba_kernels(operator_descriptor, mode="regular"):
         "modified_helmholtz_single_layer": modified_helmholtz_single_layer_regular,
         "modified_helmholtz_double_layer": modified_helmholtz_double_layer_regular,
         "modified_helmholtz_adjoint_double_layer": modified_helmholtz_adjoint_double_layer_regular,
+        "laplace_single_and_double_layer": laplace_single_and_double_layer_regular,
+        "helmholtz_single_and_double_layer": helmholtz_single_and_double_layer_regular,
+        "modified_helmholtz_single_and_double_layer": modified_helmholtz_single_and_double_layer_regular,
     }
 
     kernel_functions_singular = {
@@ -163,6 +170,38 @@ def get_normals(grid_data, nrepetitions, elements, multipliers):
     return output
 
 
+@_numba.jit(
+    nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
+)
+def get_geometry(grid_data, elements, local_points, multipliers):
+    """
+    Get global points, normals and integration elements.
+
+    The values are stored consecutively for each element. The normals
+    are multiplied with the normal multipliers of the elements.
+    """
+    npoints = local_points.shape[1]
+    nelements = len(elements)
+    dtype = grid_data.vertices.dtype
+    global_points = _np.empty((3, nelements * npoints), dtype=dtype)
+    normals = _np.empty((3, nelements * npoints), dtype=dtype)
+    integration_elements = _np.empty(nelements * npoints, dtype=dtype)
+    for index, element in enumerate(elements):
+        (
+            element_points,
+            element_normals,
+            element_integration_elements,
+        ) = grid_data.geometry(element, local_points)
+        global_points[:, npoints * index : npoints * (1 + index)] = element_points
+        normals[:, npoints * index : npoints * (1 + index)] = (
+            element_normals * multipliers[element]
+        )
+        integration_elements[
+            npoints * index : npoints * (1 + index)
+        ] = element_integration_elements
+    return global_points, normals, integration_elements
+
+
 @_numba.jit(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
@@ -258,7 +297,7 @@ def laplace_adjoint_double_layer_regular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def laplace_single_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Laplace single layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -277,7 +316,7 @@ def laplace_single_layer_singular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def laplace_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Laplace double layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -294,7 +333,7 @@ def laplace_double_layer_singular(
         dist[j] = _np.sqrt(dist[j])
     for i in range(3):
         for j in range(npoints):
-            output[j] += diff[i, j] * trial_normal[i]
+            output[j] += diff[i, j] * trial_normals[i, j]
     for j in range(npoints):
         output[j] *= -m_inv_4pi / (dist[j] * dist[j] * dist[j])
     return output
@@ -304,7 +343,7 @@ def laplace_double_layer_singular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def laplace_adjoint_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Laplace adjoint double layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -321,7 +360,7 @@ def laplace_adjoint_double_layer_singular(
         dist[j] = _np.sqrt(dist[j])
     for i in range(3):
         for j in range(npoints):
-            output[j] += diff[i, j] * test_normal[i]
+            output[j] += diff[i, j] * test_normals[i, j]
     for j in range(npoints):
         output[j] *= m_inv_4pi / (dist[j] * dist[j] * dist[j])
     return output
@@ -520,7 +559,7 @@ def helmholtz_far_field_double_layer(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def helmholtz_single_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Helmholtz single layer for regular kernels."""
     wavenumber_real = kernel_parameters[0]
@@ -550,7 +589,7 @@ def helmholtz_single_layer_singular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def helmholtz_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Helmholtz double layer for singular kernels."""
     wavenumber_real = kernel_parameters[0]
@@ -573,7 +612,7 @@ def helmholtz_double_layer_singular(
         dist[j] = _np.sqrt(dist[j])
     for i in range(3):
         for j in range(npoints):
-            laplace_grad[j] += diff[i, j] * trial_normal[i]
+            laplace_grad[j] += diff[i, j] * trial_normals[i, j]
     for j in range(npoints):
         laplace_grad[j] *= m_inv_4pi / (dist[j] * dist[j] * dist[j])
         factor_real[j] = _np.cos(wavenumber_real * dist[j]) * laplace_grad[j]
@@ -596,7 +635,7 @@ def helmholtz_double_layer_singular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def helmholtz_adjoint_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Helmholtz adjoint double layer for singular kernels."""
     wavenumber_real = kernel_parameters[0]
@@ -619,7 +658,7 @@ def helmholtz_adjoint_double_layer_singular(
         dist[j] = _np.sqrt(dist[j])
     for i in range(3):
         for j in range(npoints):
-            laplace_grad[j] += diff[i, j] * test_normal[i]
+            laplace_grad[j] += diff[i, j] * test_normals[i, j]
     for j in range(npoints):
         laplace_grad[j] *= m_inv_4pi / (dist[j] * dist[j] * dist[j])
         factor_real[j] = _np.cos(wavenumber_real * dist[j]) * laplace_grad[j]
@@ -667,7 +706,7 @@ def modified_helmholtz_single_layer_regular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def modified_helmholtz_single_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Modified Helmholtz single layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -729,7 +768,7 @@ def modified_helmholtz_double_layer_regular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def modified_helmholtz_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Modified Helmholtz double layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -751,7 +790,7 @@ def modified_helmholtz_double_layer_singular(
         ewr[j] = _np.exp(-kernel_parameters[0] * dist[j])
     for i in range(3):
         for j in range(npoints):
-            output[j] += diff[i, j] * trial_normal[i]
+            output[j] += diff[i, j] * trial_normals[i, j]
     for j in range(npoints):
         output[j] *= (
             (-kernel_parameters[0] * dist[j] - 1)
@@ -803,7 +842,7 @@ def modified_helmholtz_adjoint_double_layer_regular(
     nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
 )
 def modified_helmholtz_adjoint_double_layer_singular(
-    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+    test_points, trial_points, test_normals, trial_normals, kernel_parameters
 ):
     """Evaluate Modified Helmholtz adjoint double layer for singular kernels."""
     npoints = trial_points.shape[1]
@@ -825,7 +864,7 @@ def modified_helmholtz_adjoint_double_layer_singular(
         ewr[j] = _np.exp(-kernel_parameters[0] * dist[j])
     for i in range(3):
         for j in range(npoints):
-            output[j] += diff[i, j] * test_normal[i]
+            output[j] += diff[i, j] * test_normals[i, j]
     for j in range(npoints):
         output[j] *= (
             (kernel_parameters[0] * dist[j] + 1)
@@ -880,7 +919,7 @@ def l2_identity_kernel(
     nshape = nshape_test * nshape_trial
     dimension = local_test_fun_values.shape[0]
     n_quad_points = local_test_fun_values.shape[2]
-    integration_element = grid_data.integration_elements[element]
+    integration_elements = grid_data.geometry(element, quad_points)[2]
 
     for test_index in range(nshape_test):
         for trial_index in range(nshape_trial):
@@ -892,7 +931,7 @@ def l2_identity_kernel(
                         local_test_fun_values[dim_index, test_index, quad_index]
                         * local_trial_fun_values[dim_index, trial_index, quad_index]
                         * quad_weights[quad_index]
-                        * integration_element
+                        * integration_elements[quad_index]
                     )
 
 
@@ -977,11 +1016,8 @@ def default_scalar_regular_kernel(
 
     local_test_fun_values = test_shapeset(quad_points)
     local_trial_fun_values = trial_shapeset(quad_points)
-    trial_normals = get_normals(
-        trial_grid_data, n_quad_points, trial_elements, trial_normal_multipliers
-    )
-    trial_global_points = get_global_points(
-        trial_grid_data, trial_elements, quad_points
+    trial_global_points, trial_normals, trial_integration_elements = get_geometry(
+        trial_grid_data, trial_elements, quad_points, trial_normal_multipliers
     )
 
     factors = _np.empty(
@@ -991,8 +1027,8 @@ def default_scalar_regular_kernel(
         for trial_point_index in range(n_quad_points):
             factors[n_quad_points * trial_element_index + trial_point_index] = (
                 quad_weights[trial_point_index]
-                * trial_grid_data.integration_elements[
-                    trial_elements[trial_element_index]
+                * trial_integration_elements[
+                    n_quad_points * trial_element_index + trial_point_index
                 ]
             )
 
@@ -1001,13 +1037,12 @@ def default_scalar_regular_kernel(
         local_result = _np.zeros(
             (n_trial_elements, nshape_test, nshape_trial), dtype=result_type
         )
-        test_global_points = test_grid_data.local2global(test_element, quad_points)
-        test_normal = (
-            test_grid_data.normals[test_element] * test_normal_multipliers[test_element]
-        )
-        local_factors = _np.empty(
-            n_trial_elements * n_quad_points, dtype=test_global_points.dtype
-        )
+        (
+            test_global_points,
+            test_normals,
+            test_integration_elements,
+        ) = test_grid_data.geometry(test_element, quad_points)
+        test_normal_multiplier = test_normal_multipliers[test_element]
         tmp = _np.empty(n_trial_elements * n_quad_points, dtype=result_type)
         is_adjacent = _np.zeros(n_trial_elements, dtype=_np.bool_)
 
@@ -1018,12 +1053,13 @@ def default_scalar_regular_kernel(
             ):
                 is_adjacent[trial_element_index] = True
 
-        for index in range(n_trial_elements * n_quad_points):
-            local_factors[index] = (
-                factors[index] * test_grid_data.integration_elements[test_element]
-            )
         for test_point_index in range(n_quad_points):
             test_global_point = test_global_points[:, test_point_index]
+            test_normal = test_normals[:, test_point_index] * test_normal_multiplier
+            test_factor = (
+                quad_weights[test_point_index]
+                * test_integration_elements[test_point_index]
+            )
             kernel_values = kernel_evaluator(
                 test_global_point,
                 trial_global_points,
@@ -1032,9 +1068,7 @@ def default_scalar_regular_kernel(
                 kernel_parameters,
             )
             for index in range(n_trial_elements * n_quad_points):
-                tmp[index] = kernel_values[index] * (
-                    local_factors[index] * quad_weights[test_point_index]
-                )
+                tmp[index] = kernel_values[index] * (factors[index] * test_factor)
 
             for trial_element_index in range(n_trial_elements):
                 if is_adjacent[trial_element_index]:
@@ -1629,8 +1663,16 @@ def default_scalar_singular_kernel(
         npoints = number_of_quad_points[index]
         test_local_points = test_points[:, test_offset : test_offset + npoints]
         trial_local_points = trial_points[:, trial_offset : trial_offset + npoints]
-        test_global_points = grid_data.local2global(test_element, test_local_points)
-        trial_global_points = grid_data.local2global(trial_element, trial_local_points)
+        (
+            test_global_points,
+            test_normals,
+            test_integration_elements,
+        ) = grid_data.geometry(test_element, test_local_points)
+        (
+            trial_global_points,
+            trial_normals,
+            trial_integration_elements,
+        ) = grid_data.geometry(trial_element, trial_local_points)
         test_fun_values = test_shapeset(
             test_points[:, test_offset : test_offset + npoints]
         )
@@ -1640,10 +1682,16 @@ def default_scalar_singular_kernel(
         kernel_values = kernel_evaluator(
             test_global_points,
             trial_global_points,
-            grid_data.normals[test_element] * test_normal_multipliers[test_element],
-            grid_data.normals[trial_element] * trial_normal_multipliers[trial_element],
+            test_normals * test_normal_multipliers[test_element],
+            trial_normals * trial_normal_multipliers[trial_element],
             kernel_parameters,
         )
+        for point_index in range(npoints):
+            kernel_values[point_index] *= (
+                quad_weights[weights_offset + point_index]
+                * test_integration_elements[point_index]
+                * trial_integration_elements[point_index]
+            )
         for test_fun_index in range(nshape_test):
             for trial_fun_index in range(nshape_trial):
                 for point_index in range(npoints):
@@ -1653,18 +1701,9 @@ def default_scalar_singular_kernel(
                         + trial_fun_index
                     ] += (
                         kernel_values[point_index]
-                        * quad_weights[weights_offset + point_index]
                         * test_fun_values[0, test_fun_index, point_index]
                         * trial_fun_values[0, trial_fun_index, point_index]
                     )
-                result[
-                    nshape_trial * nshape_test * index
-                    + test_fun_index * nshape_trial
-                    + trial_fun_index
-                ] *= (
-                    grid_data.integration_elements[test_element]
-                    * grid_data.integration_elements[trial_element]
-                )
 
 
 @_numba.jit(
@@ -2002,6 +2041,115 @@ def modified_helmholtz_hypersingular_singular(
                 )
 
 
+@_numba.jit(
+    nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
+)
+def laplace_single_and_double_layer_regular(
+    test_point, trial_points, test_normal, trial_normals, kernel_parameters
+):
+    """Evaluate Laplace single and double layer in one pass."""
+    npoints = trial_points.shape[1]
+    dtype = trial_points.dtype
+    output = _np.zeros((2, npoints), dtype=dtype)
+    diff = _np.empty((3, npoints), dtype=dtype)
+    dist = _np.zeros(npoints, dtype=dtype)
+    m_inv_4pi = dtype.type(M_INV_4PI)
+    for i in range(3):
+        for j in range(npoints):
+            diff[i, j] = trial_points[i, j] - test_point[i]
+            dist[j] += diff[i, j] * diff[i, j]
+    for j in range(npoints):
+        dist[j] = _np.sqrt(dist[j])
+    for i in range(3):
+        for j in range(npoints):
+            output[1, j] += diff[i, j] * trial_normals[i, j]
+    for j in range(npoints):
+        output[0, j] = m_inv_4pi / dist[j]
+        output[1, j] *= -output[0, j] / (dist[j] * dist[j])
+    return output
+
+
+@_numba.jit(
+    nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
+)
+def helmholtz_single_and_double_layer_regular(
+    test_point, trial_points, test_normal, trial_normals, kernel_parameters
+):
+    """Evaluate Helmholtz single and double layer in one pass."""
+    wavenumber_real = kernel_parameters[0]
+    wavenumber_imag = kernel_parameters[1]
+    npoints = trial_points.shape[1]
+    dtype = trial_points.dtype
+    single_real = _np.empty(npoints, dtype=dtype)
+    single_imag = _np.empty(npoints, dtype=dtype)
+    double_real = _np.empty(npoints, dtype=dtype)
+    double_imag = _np.empty(npoints, dtype=dtype)
+    diff = _np.empty((3, npoints), dtype=dtype)
+    dist = _np.zeros(npoints, dtype=dtype)
+    inner = _np.zeros(npoints, dtype=dtype)
+    m_inv_4pi = dtype.type(M_INV_4PI)
+    for i in range(3):
+        for j in range(npoints):
+            diff[i, j] = trial_points[i, j] - test_point[i]
+            dist[j] += diff[i, j] * diff[i, j]
+    for j in range(npoints):
+        dist[j] = _np.sqrt(dist[j])
+    for i in range(3):
+        for j in range(npoints):
+            inner[j] += diff[i, j] * trial_normals[i, j]
+    for j in range(npoints):
+        single_real[j] = _np.cos(wavenumber_real * dist[j]) * m_inv_4pi / dist[j]
+        single_imag[j] = _np.sin(wavenumber_real * dist[j]) * m_inv_4pi / dist[j]
+    if wavenumber_imag != 0:
+        for j in range(npoints):
+            single_real[j] *= _np.exp(-wavenumber_imag * dist[j])
+            single_imag[j] *= _np.exp(-wavenumber_imag * dist[j])
+    for j in range(npoints):
+        inner[j] /= dist[j] * dist[j]
+        double_real[j] = (
+            (-1 - wavenumber_imag * dist[j]) * single_real[j]
+            - wavenumber_real * dist[j] * single_imag[j]
+        ) * inner[j]
+        double_imag[j] = (
+            wavenumber_real * dist[j] * single_real[j]
+            + (-1 - wavenumber_imag * dist[j]) * single_imag[j]
+        ) * inner[j]
+    output = _np.empty((2, npoints), dtype=_np.complex128)
+    output[0, :] = single_real + 1j * single_imag
+    output[1, :] = double_real + 1j * double_imag
+    return output
+
+
+@_numba.jit(
+    nopython=True, parallel=False, error_model="numpy", fastmath=True, boundscheck=False
+)
+def modified_helmholtz_single_and_double_layer_regular(
+    test_points, trial_points, test_normal, trial_normal, kernel_parameters
+):
+    """Evaluate Modified Helmholtz single and double layer in one pass."""
+    npoints = trial_points.shape[1]
+    dtype = trial_points.dtype
+    diff = _np.zeros((3, npoints), dtype=dtype)
+    dist = _np.zeros(npoints, dtype=dtype)
+    output = _np.zeros((2, npoints), dtype=dtype)
+    m_inv_4pi = dtype.type(M_INV_4PI)
+    for i in range(3):
+        for j in range(npoints):
+            diff[i, j] = trial_points[i, j] - test_points[i]
+            dist[j] += diff[i, j] ** 2
+    for j in range(npoints):
+        dist[j] = _np.sqrt(dist[j])
+    for i in range(3):
+        for j in range(npoints):
+            output[1, j] += diff[i, j] * trial_normal[i, j]
+    for j in range(npoints):
+        output[0, j] = m_inv_4pi * _np.exp(-kernel_parameters[0] * dist[j]) / dist[j]
+        output[1, j] *= (
+            (-kernel_parameters[0] * dist[j] - 1) * output[0, j] / (dist[j] * dist[j])
+        )
+    return output
+
+
 @_numba.jit(
     nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
 )
@@ -2027,22 +2175,10 @@ def default_scalar_potential_kernel(
     number_of_quad_points = len(quad_weights)
     number_of_points = points.shape[1]
 
-    global_points = _np.zeros(
-        (3, number_of_quad_points * n_support_elements), dtype=dtype
-    )
-
     tmp = _np.zeros(number_of_quad_points * n_support_elements, dtype=result_type)
 
-    for element_index, element in enumerate(support_elements):
-        global_points[
-            :,
-            number_of_quad_points
-            * element_index : number_of_quad_points
-            * (1 + element_index),
-        ] = grid_data.local2global(element, quad_points)
-
-    normals = get_normals(
-        grid_data, number_of_quad_points, support_elements, normal_multipliers
+    global_points, normals, integration_elements = get_geometry(
+        grid_data, support_elements, quad_points, normal_multipliers
     )
 
     fun_values = shapeset_evaluate(quad_points)
@@ -2055,7 +2191,9 @@ def default_scalar_potential_kernel(
         for quad_point_index in range(number_of_quad_points):
             for fun_index in range(number_of_shape_functions):
                 tmp[number_of_quad_points * element_index + quad_point_index] += (
-                    grid_data.integration_elements[element]
+                    integration_elements[
+                        number_of_quad_points * element_index + quad_point_index
+                    ]
                     * quad_weights[quad_point_index]
                     * fun_values[0, fun_index, quad_point_index]
                     * x[number_of_shape_functions * element + fun_index]
@@ -2601,6 +2739,318 @@ def maxwell_mfield_regular_assembler(
                     )
 
 
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def maxwell_cfield_regular_assembler(
+    test_grid_data,
+    trial_grid_data,
+    nshape_test,
+    nshape_trial,
+    test_elements,
+    trial_elements,
+    test_multipliers,
+    trial_multipliers,
+    test_global_dofs,
+    trial_global_dofs,
+    test_normal_multipliers,
+    trial_normal_multipliers,
+    quad_points,
+    quad_weights,
+    kernel_evaluator,
+    kernel_parameters,
+    grids_identical,
+    test_shapeset,
+    trial_shapeset,
+    result,
+):
+    """
+    Evaluate a weighted sum of the Maxwell electric and magnetic field kernels.
+
+    The Green's function, the distances and the Piola transforms are
+    computed once for each pair of quadrature points and used for both
+    operators. The weights of the electric and magnetic field operators
+    are stored in kernel_parameters[2:4] and kernel_parameters[4:6].
+    """
+    wavenumber = kernel_parameters[0] + 1j * kernel_parameters[1]
+    electric_weight = kernel_parameters[2] + 1j * kernel_parameters[3]
+    magnetic_weight = kernel_parameters[4] + 1j * kernel_parameters[5]
+    dtype = test_grid_data.vertices.dtype
+    result_type = result.dtype
+    n_quad_points = len(quad_weights)
+    n_test_elements = len(test_elements)
+    n_trial_elements = len(trial_elements)
+
+    trial_global_points = get_global_points(
+        trial_grid_data, trial_elements, quad_points
+    )
+
+    test_basis_functions = get_piola_transform(
+        test_grid_data, test_elements, quad_points
+    )
+    trial_basis_functions = get_piola_transform(
+        trial_grid_data, trial_elements, quad_points
+    )
+
+    test_edge_lengths = get_edge_lengths(test_grid_data, test_elements)
+    trial_edge_lengths = get_edge_lengths(trial_grid_data, trial_elements)
+
+    factors = _np.empty(
+        n_quad_points * n_trial_elements, dtype=trial_global_points.dtype
+    )
+    for trial_element_index in range(n_trial_elements):
+        for trial_point_index in range(n_quad_points):
+            factors[n_quad_points * trial_element_index + trial_point_index] = (
+                quad_weights[trial_point_index]
+                * trial_grid_data.integration_elements[
+                    trial_elements[trial_element_index]
+                ]
+            )
+
+    for i in _numba.prange(n_test_elements):
+        test_element = test_elements[i]
+        local_result = _np.zeros(
+            (n_trial_elements, nshape_test, nshape_trial), dtype=result_type
+        )
+        test_global_points = test_grid_data.local2global(test_element, quad_points)
+        local_factors = _np.empty(
+            n_trial_elements * n_quad_points, dtype=test_global_points.dtype
+        )
+        tmp = _np.empty(n_trial_elements * n_quad_points, dtype=result_type)
+        electric_sum = _np.empty((nshape_trial, 3), dtype=result_type)
+        magnetic_sum = _np.empty((nshape_trial, 3), dtype=result_type)
+        is_adjacent = _np.zeros(n_trial_elements, dtype=_np.bool_)
+
+        for trial_element_index in range(n_trial_elements):
+            trial_element = trial_elements[trial_element_index]
+            if grids_identical and elements_adjacent(
+                test_grid_data.elements, test_element, trial_element
+            ):
+                is_adjacent[trial_element_index] = True
+
+        for index in range(n_trial_elements * n_quad_points):
+            local_factors[index] = (
+                factors[index] * test_grid_data.integration_elements[test_element]
+            )
+
+        for test_point_index in range(n_quad_points):
+            test_global_point = test_global_points[:, test_point_index].copy()
+            kernel_values = kernel_evaluator(
+                test_global_point,
+                trial_global_points,
+                None,
+                None,
+                kernel_parameters,
+            )
+
+            diff = test_global_point.reshape(3, 1) - trial_global_points
+            dist = _np.zeros(n_trial_elements * n_quad_points, dtype=dtype)
+
+            for dim in range(3):
+                for col in range(n_trial_elements * n_quad_points):
+                    dist[col] += diff[dim, col] * diff[dim, col]
+            dist = _np.sqrt(dist)
+
+            for index in range(n_trial_elements * n_quad_points):
+                tmp[index] = kernel_values[index] * (
+                    local_factors[index] * quad_weights[test_point_index]
+                )
+
+            for trial_element_index in range(n_trial_elements):
+                if is_adjacent[trial_element_index]:
+                    continue
+                trial_element = trial_elements[trial_element_index]
+
+                divergence_product = 4 / (
+                    test_grid_data.integration_elements[test_element]
+                    * trial_grid_data.integration_elements[trial_element]
+                )
+                offset = trial_element_index * n_quad_points
+
+                # Sum up the quadrature over the trial element first, so that
+                # the kernel is only used once for all pairs of shape
+                # functions. The magnetic part uses the identity
+                # diff . (u x v) = u . (v x diff).
+                kernel_sum = 0 * electric_weight
+                electric_sum[:, :] = 0
+                magnetic_sum[:, :] = 0
+                for quad_point_index in range(n_quad_points):
+                    index = offset + quad_point_index
+                    # The distance is only nonzero for non-adjacent elements.
+                    gradient_factor = (
+                        magnetic_weight
+                        * tmp[index]
+                        * (1j * wavenumber * dist[index] - 1)
+                        / (dist[index] * dist[index])
+                    )
+                    kernel_sum += tmp[index]
+                    for trial_fun_index in range(nshape_trial):
+                        trial_fun = trial_basis_functions[
+                            trial_element_index, trial_fun_index, :, quad_point_index
+                        ]
+                        for dim in range(3):
+                            electric_sum[trial_fun_index, dim] += (
+                                tmp[index] * trial_fun[dim]
+                            )
+                            magnetic_sum[trial_fun_index, dim] += gradient_factor * (
+                                trial_fun[(dim + 1) % 3] * diff[(dim + 2) % 3, index]
+                                - trial_fun[(dim + 2) % 3] * diff[(dim + 1) % 3, index]
+                            )
+
+                for test_fun_index in range(nshape_test):
+                    test_fun = test_basis_functions[
+                        i, test_fun_index, :, test_point_index
+                    ]
+                    for trial_fun_index in range(nshape_trial):
+                        electric_value = (
+                            -1j
+                            * wavenumber
+                            * (
+                                test_fun[0] * electric_sum[trial_fun_index, 0]
+                                + test_fun[1] * electric_sum[trial_fun_index, 1]
+                                + test_fun[2] * electric_sum[trial_fun_index, 2]
+                            )
+                            - divergence_product / (1j * wavenumber) * kernel_sum
+                        )
+                        magnetic_value = (
+                            test_fun[0] * magnetic_sum[trial_fun_index, 0]
+                            + test_fun[1] * magnetic_sum[trial_fun_index, 1]
+                            + test_fun[2] * magnetic_sum[trial_fun_index, 2]
+                        )
+                        local_result[
+                            trial_element_index, test_fun_index, trial_fun_index
+                        ] += (electric_weight * electric_value + magnetic_value)
+
+        for trial_element_index in range(n_trial_elements):
+            trial_element = trial_elements[trial_element_index]
+            for test_fun_index in range(nshape_test):
+                for trial_fun_index in range(nshape_trial):
+                    result[
+                        test_global_dofs[test_element, test_fun_index],
+                        trial_global_dofs[trial_element, trial_fun_index],
+                    ] += (
+                        local_result[
+                            trial_element_index, test_fun_index, trial_fun_index
+                        ]
+                        * test_multipliers[test_element, test_fun_index]
+                        * trial_multipliers[trial_element, trial_fun_index]
+                        * test_edge_lengths[i, test_fun_index]
+                        * trial_edge_lengths[trial_element_index, trial_fun_index]
+                    )
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def maxwell_cfield_singular(
+    grid_data,
+    test_points,
+    trial_points,
+    quad_weights,
+    test_elements,
+    trial_elements,
+    test_offsets,
+    trial_offsets,
+    weights_offsets,
+    number_of_quad_points,
+    test_normal_multipliers,
+    trial_normal_multipliers,
+    nshape_test,
+    nshape_trial,
+    test_shapeset,
+    trial_shapeset,
+    kernel_evaluator,
+    kernel_parameters,
+    result,
+):
+    """Singular evaluator for the combined electric and magnetic field kernel."""
+    nelements = len(test_elements)
+
+    test_edge_lengths = get_edge_lengths(grid_data, test_elements)
+    trial_edge_lengths = get_edge_lengths(grid_data, trial_elements)
+
+    for index in _numba.prange(nelements):
+        wavenumber = kernel_parameters[0] + 1j * kernel_parameters[1]
+        electric_weight = kernel_parameters[2] + 1j * kernel_parameters[3]
+        magnetic_weight = kernel_parameters[4] + 1j * kernel_parameters[5]
+        test_element = test_elements[index]
+        trial_element = trial_elements[index]
+        test_offset = test_offsets[index]
+        trial_offset = trial_offsets[index]
+        weights_offset = weights_offsets[index]
+        npoints = number_of_quad_points[index]
+        test_local_points = test_points[:, test_offset : test_offset + npoints]
+        trial_local_points = trial_points[:, trial_offset : trial_offset + npoints]
+        test_global_points = grid_data.local2global(test_element, test_local_points)
+        trial_global_points = grid_data.local2global(trial_element, trial_local_points)
+
+        test_fun_values = get_piola_transform(
+            grid_data,
+            [test_element],
+            test_local_points,
+        )[0]
+        trial_fun_values = get_piola_transform(
+            grid_data,
+            [trial_element],
+            trial_local_points,
+        )[0]
+
+        kernel_values = kernel_evaluator(
+            test_global_points,
+            trial_global_points,
+            None,
+            None,
+            kernel_parameters,
+        )
+
+        divergence_product = 4 / (
+            grid_data.integration_elements[test_element]
+            * grid_data.integration_elements[trial_element]
+        )
+
+        for test_fun_index in range(nshape_test):
+            for trial_fun_index in range(nshape_trial):
+                for point_index in range(npoints):
+                    diff = (
+                        test_global_points[:, point_index]
+                        - trial_global_points[:, point_index]
+                    )
+                    dist = _np.sqrt(
+                        diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2]
+                    )
+                    test_fun = test_fun_values[test_fun_index, :, point_index]
+                    trial_fun = trial_fun_values[trial_fun_index, :, point_index]
+                    result[
+                        nshape_trial * nshape_test * index
+                        + test_fun_index * nshape_trial
+                        + trial_fun_index
+                    ] += (
+                        kernel_values[point_index]
+                        * (
+                            electric_weight
+                            * (
+                                -1j * wavenumber * test_fun.dot(trial_fun)
+                                - divergence_product / (1j * wavenumber)
+                            )
+                            + magnetic_weight
+                            * (1j * wavenumber * dist - 1)
+                            / (dist * dist)
+                            * diff.dot(_np.cross(test_fun, trial_fun))
+                        )
+                        * quad_weights[weights_offset + point_index]
+                        * test_edge_lengths[index, test_fun_index]
+                        * trial_edge_lengths[index, trial_fun_index]
+                    )
+                result[
+                    nshape_trial * nshape_test * index
+                    + test_fun_index * nshape_trial
+                    + trial_fun_index
+                ] *= (
+                    grid_data.integration_elements[test_element]
+                    * grid_data.integration_elements[trial_element]
+                )
+
+
 @_numba.jit(
     nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
 )
@@ -2786,6 +3236,114 @@ def maxwell_mfield_potential(
     return result
 
 
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def fused_maxwell_potential(
+    dtype,
+    result_type,
+    kernel_dimension,
+    points,
+    x,
+    grid_data,
+    quad_points,
+    quad_weights,
+    number_of_shape_functions,
+    shapeset_evaluate,
+    kernel_function,
+    kernel_parameters,
+    normal_multipliers,
+    support_elements,
+):
+    """
+    Implement the Maxwell electric and magnetic field potential in one pass.
+
+    The first three rows of the result contain the electric field
+    potential and the last three rows the magnetic field potential.
+    """
+    wavenumber = kernel_parameters[0] + 1j * kernel_parameters[1]
+    dtype = grid_data.vertices.dtype
+    result = _np.zeros((kernel_dimension, points.shape[1]), dtype=result_type)
+    n_support_elements = len(support_elements)
+    number_of_quad_points = len(quad_weights)
+    number_of_points = points.shape[1]
+
+    global_points = _np.zeros(
+        (3, number_of_quad_points * n_support_elements), dtype=dtype
+    )
+
+    basis_functions = get_piola_transform(grid_data, support_elements, quad_points)
+
+    edge_lengths = get_edge_lengths(grid_data, support_elements)
+
+    tmp1 = _np.zeros((3, number_of_quad_points * n_support_elements), dtype=result_type)
+    tmp2 = _np.zeros(number_of_quad_points * n_support_elements, dtype=result_type)
+
+    for element_index, element in enumerate(support_elements):
+        global_points[
+            :,
+            number_of_quad_points
+            * element_index : number_of_quad_points
+            * (1 + element_index),
+        ] = grid_data.local2global(element, quad_points)
+
+    for element_index, element in enumerate(support_elements):
+        for quad_point_index in range(number_of_quad_points):
+            for fun_index in range(number_of_shape_functions):
+                factor = (
+                    quad_weights[quad_point_index]
+                    * x[number_of_shape_functions * element + fun_index]
+                    * edge_lengths[element_index, fun_index]
+                )
+                tmp1[:, number_of_quad_points * element_index + quad_point_index] += (
+                    factor
+                    * basis_functions[element_index, fun_index, :, quad_point_index]
+                    * grid_data.integration_elements[element]
+                )
+                tmp2[number_of_quad_points * element_index + quad_point_index] += (
+                    2 * factor
+                )
+
+    for point_index in _numba.prange(number_of_points):
+        test_point = points[:, point_index].copy()
+
+        kernel_values = kernel_function(
+            test_point, global_points, None, None, kernel_parameters
+        )
+        diff = test_point.reshape(3, 1) - global_points
+        dist = _np.zeros(number_of_quad_points * n_support_elements, dtype=dtype)
+        for dim in range(3):
+            for index in range(number_of_quad_points * n_support_elements):
+                dist[index] += diff[dim, index] * diff[dim, index]
+        dist = _np.sqrt(dist)
+
+        for trial_index in range(number_of_quad_points * n_support_elements):
+            ldist = dist[trial_index]
+            grad_factor = kernel_values[trial_index] * (1j * wavenumber * ldist - 1)
+            for dim in range(3):
+                result[dim, point_index] += 1j * wavenumber * kernel_values[
+                    trial_index
+                ] * tmp1[dim, trial_index] - diff[
+                    dim, trial_index
+                ] * grad_factor * tmp2[
+                    trial_index
+                ] / (
+                    1j * wavenumber * ldist * ldist
+                )
+            val = grad_factor * tmp1[:, trial_index] / (ldist * ldist)
+            result[3, point_index] += (
+                diff[1, trial_index] * val[2] - diff[2, trial_index] * val[1]
+            )
+            result[4, point_index] += (
+                diff[2, trial_index] * val[0] - diff[0, trial_index] * val[2]
+            )
+            result[5, point_index] += (
+                diff[0, trial_index] * val[1] - diff[1, trial_index] * val[0]
+            )
+
+    return result
+
+
 @_numba.jit(
     nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
 )
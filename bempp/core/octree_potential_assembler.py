@@ -0,0 +1,661 @@
+"""Octree accelerated evaluation of potentials."""
+
+import numba as _numba
+import numpy as _np
+
+from bempp.api.utils.octree import morton as _morton
+
+# Kernels used to evaluate far-field interactions from the Chebychev
+# interpolation nodes of a node of the octree. The second entry
+# specifies if the interpolation weights are formed from the normal
+# derivative of the interpolation polynomials (double layer potentials).
+_PROXY_KERNELS = {
+    "laplace_single_layer": ("laplace_single_layer", False),
+    "laplace_double_layer": ("laplace_single_layer", True),
+    "helmholtz_single_layer": ("helmholtz_single_layer", False),
+    "helmholtz_double_layer": ("helmholtz_single_layer", True),
+    "modified_helmholtz_single_layer": ("modified_helmholtz_single_layer", False),
+    "modified_helmholtz_double_layer": ("modified_helmholtz_single_layer", True),
+}
+
+# Morton indices are stored with 10 bits per dimension.
+_MAXIMUM_LEVEL = 10
+
+
+class OctreePotentialAssembler(object):
+    """
+    Potential assembler based on an octree over the surface elements.
+
+    Interactions between an evaluation point and an octree node that is
+    sufficiently far away are evaluated from a Chebychev interpolation of
+    the kernel on the bounding box of the node. Only interactions with
+    elements in nearby leaf nodes are computed by direct quadrature, using
+    a higher order rule for elements very close to the evaluation point.
+    Evaluation points are processed in batches in Morton order.
+    """
+
+    def __init__(
+        self, space, operator_descriptor, points, device_interface, parameters
+    ):
+        """Create an octree potential assembler."""
+        from bempp.api.integration.triangle_gauss import rule
+        from bempp.api.utils.helpers import get_type
+        from bempp.api.utils.interpolation import ChebychevInterpolation
+        from bempp.core.numba_kernels import select_numba_kernels
+
+        if (
+            operator_descriptor.assembly_type != "default_scalar"
+            or operator_descriptor.kernel_type not in _PROXY_KERNELS
+        ):
+            raise ValueError(
+                "Octree evaluation is not supported for "
+                + f"{operator_descriptor.identifier}."
+            )
+
+        options = parameters.octree
+
+        proxy_kernel_type, self._normal_derivative = _PROXY_KERNELS[
+            operator_descriptor.kernel_type
+        ]
+
+        _, self._kernel_function = select_numba_kernels(
+            operator_descriptor, mode="potential"
+        )
+        _, self._proxy_kernel_function = select_numba_kernels(
+            operator_descriptor._replace(kernel_type=proxy_kernel_type),
+            mode="potential",
+        )
+
+        # Numba evaluation is always performed in double precision.
+        self._dtype = _np.dtype("float64")
+        if operator_descriptor.is_complex:
+            self._result_type = _np.dtype(get_type("double").complex)
+        else:
+            self._result_type = self._dtype
+
+        self.space = space
+        self._localised_space = space.localised_space
+        self._grid_data = self._localised_space.grid.data("double")
+        self._support_elements = self._localised_space.support_elements
+        self._points = _np.ascontiguousarray(points, dtype=self._dtype)
+        self._kernel_parameters = _np.array(
+            operator_descriptor.options, dtype=self._dtype
+        )
+        self._options = options
+
+        self._quad_points, self._quad_weights = rule(parameters.quadrature.regular)
+        self._near_quad_points, self._near_quad_weights = rule(
+            options.near_field_quadrature_order
+        )
+
+        shapeset_evaluate = self._localised_space.shapeset.evaluate
+        self._fun_values = shapeset_evaluate(self._quad_points)[0]
+        self._near_fun_values = shapeset_evaluate(self._near_quad_points)[0]
+
+        self._global_quad_points, self._normals = _element_quadrature_data(
+            self._grid_data,
+            self._support_elements,
+            self._quad_points,
+            self._localised_space.normal_multipliers,
+        )
+
+        interpolation = ChebychevInterpolation(options.interpolation_order)
+        self._nodes = interpolation.nodes
+        self._weights = interpolation.weights
+        self._differentiation_matrix = interpolation.differentiation_matrix
+
+        self._build_tree(options.ncrit)
+
+        self._target_order = _morton_order(self._points)
+
+    def _build_tree(self, ncrit):
+        """Build the octree over the element centroids."""
+        from bempp.api.utils.octree import Octree
+        from bempp.api.utils.interpolation import chebychev_tensor_points_3d
+
+        centroids = _np.ascontiguousarray(
+            self._grid_data.centroids[self._support_elements].T
+        )
+        lbound = _np.min(centroids, axis=1)
+        ubound = _np.max(centroids, axis=1)
+        # Make sure that the bounding box is a non-degenerate cube.
+        diameter = max(_np.max(ubound - lbound), 1e-12) * (1 + 1e-10)
+        ubound = lbound + diameter
+
+        level = _tree_depth(centroids, lbound, ubound, ncrit)
+
+        octree = Octree(lbound, ubound, level, centroids)
+
+        level_nodes = octree.non_empty_nodes_by_level
+        level_ptr = octree.non_empty_nodes_ptr.astype(_np.int64)
+
+        self._level = level
+        self._level_ptr = level_ptr
+        self._leaf_ptr = octree.leaf_nodes_ptr.astype(_np.int64)
+        self._sorted_elements = octree.sorted_indices.astype(_np.int64)
+
+        self._children_ptr = _children_ptr(level_nodes, level_ptr)
+
+        self._node_lbound, self._node_ubound = _node_bounds(
+            self._global_quad_points,
+            self._sorted_elements,
+            self._leaf_ptr,
+            self._children_ptr,
+            level_ptr,
+        )
+
+        self._node_centers = 0.5 * (self._node_lbound + self._node_ubound)
+        self._node_radii = 0.5 * _np.linalg.norm(
+            self._node_ubound - self._node_lbound, axis=1
+        )
+
+        nnodes = len(level_nodes)
+        nproxies = len(self._nodes) ** 3
+        self._proxy_points = _np.empty((nnodes, 3, nproxies), dtype=self._dtype)
+        for node in range(nnodes):
+            self._proxy_points[node] = chebychev_tensor_points_3d(
+                self._node_lbound[node], self._node_ubound[node], self._nodes
+            ).T
+
+    def evaluate(self, x):
+        """Evaluate the potential."""
+        x_transformed = self.space.map_to_full_grid @ (
+            self.space.dof_transformation @ x
+        )
+        x_transformed = x_transformed.astype(self._result_type)
+
+        source_weights = _source_weights(
+            self._grid_data,
+            self._support_elements,
+            self._quad_weights,
+            self._fun_values,
+            x_transformed,
+            self._result_type,
+        )
+
+        proxy_weights = _upward_pass(
+            self._global_quad_points,
+            self._normals,
+            source_weights,
+            self._normal_derivative,
+            self._sorted_elements,
+            self._leaf_ptr,
+            self._children_ptr,
+            self._level_ptr,
+            self._node_lbound,
+            self._node_ubound,
+            self._proxy_points,
+            self._nodes,
+            self._weights,
+            self._differentiation_matrix,
+            self._result_type,
+        )
+
+        result = _evaluate_targets(
+            self._points,
+            self._target_order,
+            self._options.batch_size,
+            self._options.theta,
+            self._options.near_field_distance,
+            self._grid_data,
+            self._support_elements,
+            self._localised_space.normal_multipliers,
+            x_transformed,
+            self._global_quad_points,
+            self._normals,
+            source_weights,
+            self._near_quad_points,
+            self._near_quad_weights,
+            self._near_fun_values,
+            self._sorted_elements,
+            self._leaf_ptr,
+            self._children_ptr,
+            self._level_ptr,
+            self._level,
+            self._node_centers,
+            self._node_radii,
+            self._proxy_points,
+            proxy_weights,
+            self._kernel_function,
+            self._proxy_kernel_function,
+            self._kernel_parameters,
+            self._result_type,
+        )
+
+        return result.reshape(1, -1)
+
+
+def _tree_depth(centroids, lbound, ubound, ncrit):
+    """Return the smallest depth with at most ncrit elements per leaf."""
+    level = 1
+    while level < _MAXIMUM_LEVEL:
+        codes = _morton_codes(centroids, lbound, ubound - lbound, level)
+        _, counts = _np.unique(codes, return_counts=True)
+        if _np.max(counts) <= ncrit:
+            break
+        level += 1
+    return level
+
+
+def _morton_order(points):
+    """Return the permutation that sorts points in Morton order."""
+    lbound = _np.min(points, axis=1)
+    diameter = max(_np.max(_np.max(points, axis=1) - lbound), 1e-12)
+    codes = _morton_codes(
+        points, lbound, diameter * _np.ones(3, dtype=_np.float64), _MAXIMUM_LEVEL
+    )
+    return _np.argsort(codes, kind="stable")
+
+
+@_numba.njit(cache=True)
+def _morton_codes(points, lbound, diameter, level):
+    """Return the Morton indices of the leaf nodes containing the points."""
+    nodes_per_side = 1 << level
+    npoints = points.shape[1]
+    codes = _np.empty(npoints, dtype=_np.int64)
+    indices = _np.empty(3, dtype=_np.int64)
+    for point_index in range(npoints):
+        for dim in range(3):
+            indices[dim] = min(
+                max(
+                    int(
+                        (points[dim, point_index] - lbound[dim])
+                        / diameter[dim]
+                        * nodes_per_side
+                    ),
+                    0,
+                ),
+                nodes_per_side - 1,
+            )
+        codes[point_index] = _morton((indices[0], indices[1], indices[2]))
+    return codes
+
+
+@_numba.njit(cache=True)
+def _children_ptr(level_nodes, level_ptr):
+    """
+    Return for each node the positions of its first and last child.
+
+    Nodes are numbered by their position in the array of non-empty nodes
+    sorted by level. The children of node j are the nodes
+    children_ptr[j, 0], ..., children_ptr[j, 1] - 1.
+    """
+    nnodes = len(level_nodes)
+    nlevels = len(level_ptr) - 1
+    children_ptr = _np.zeros((nnodes, 2), dtype=_np.int64)
+    for level in range(nlevels - 1):
+        children = level_nodes[level_ptr[level + 1] : level_ptr[level + 2]]
+        parents = children >> 3
+        for node in range(level_ptr[level], level_ptr[level + 1]):
+            children_ptr[node, 0] = level_ptr[level + 1] + _np.searchsorted(
+                parents, level_nodes[node], side="left"
+            )
+            children_ptr[node, 1] = level_ptr[level + 1] + _np.searchsorted(
+                parents, level_nodes[node], side="right"
+            )
+    return children_ptr
+
+
+@_numba.njit(cache=True)
+def _node_bounds(
+    global_quad_points, sorted_elements, leaf_ptr, children_ptr, level_ptr
+):
+    """Compute bounding boxes of the quadrature points in each node."""
+    nnodes = len(children_ptr)
+    nlevels = len(level_ptr) - 1
+    lbound = _np.empty((nnodes, 3), dtype=_np.float64)
+    ubound = _np.empty((nnodes, 3), dtype=_np.float64)
+
+    leaf_offset = level_ptr[nlevels - 1]
+    for leaf in range(len(leaf_ptr) - 1):
+        node = leaf_offset + leaf
+        lbound[node, :] = _np.inf
+        ubound[node, :] = -_np.inf
+        for index in range(leaf_ptr[leaf], leaf_ptr[leaf + 1]):
+            element_points = global_quad_points[sorted_elements[index]]
+            for dim in range(3):
+                lbound[node, dim] = min(lbound[node, dim], _np.min(element_points[dim]))
+                ubound[node, dim] = max(ubound[node, dim], _np.max(element_points[dim]))
+
+    for level in range(nlevels - 2, -1, -1):
+        for node in range(level_ptr[level], level_ptr[level + 1]):
+            lbound[node, :] = _np.inf
+            ubound[node, :] = -_np.inf
+            for child in range(children_ptr[node, 0], children_ptr[node, 1]):
+                for dim in range(3):
+                    lbound[node, dim] = min(lbound[node, dim], lbound[child, dim])
+                    ubound[node, dim] = max(ubound[node, dim], ubound[child, dim])
+
+    # Avoid degenerate boxes (e.g. for flat surfaces).
+    for node in range(nnodes):
+        pad = max(1e-2 * _np.max(ubound[node] - lbound[node]), 1e-12)
+        for dim in range(3):
+            if ubound[node, dim] - lbound[node, dim] < pad:
+                lbound[node, dim] -= 0.5 * pad
+                ubound[node, dim] += 0.5 * pad
+
+    return lbound, ubound
+
+
+@_numba.njit
+def _element_quadrature_data(
+    grid_data, support_elements, quad_points, normal_multipliers
+):
+    """Return global quadrature points and normals for each support element."""
+    nelements = len(support_elements)
+    nquad_points = quad_points.shape[1]
+    global_points = _np.empty((nelements, 3, nquad_points), dtype=_np.float64)
+    normals = _np.empty((nelements, 3, nquad_points), dtype=_np.float64)
+    for index in range(nelements):
+        element = support_elements[index]
+        global_points[index] = grid_data.local2global(element, quad_points)
+        for dim in range(3):
+            normals[index, dim, :] = (
+                grid_data.normals[element, dim] * normal_multipliers[element]
+            )
+    return global_points, normals
+
+
+@_numba.njit
+def _source_weights(
+    grid_data, support_elements, quad_weights, fun_values, x, result_type
+):
+    """Multiply coefficients with basis functions and quadrature weights."""
+    nelements = len(support_elements)
+    nshape_funs = fun_values.shape[0]
+    nquad_points = len(quad_weights)
+    weights = _np.zeros((nelements, nquad_points), dtype=result_type)
+    for index in range(nelements):
+        element = support_elements[index]
+        for quad_index in range(nquad_points):
+            for fun_index in range(nshape_funs):
+                weights[index, quad_index] += (
+                    grid_data.integration_elements[element]
+                    * quad_weights[quad_index]
+                    * fun_values[fun_index, quad_index]
+                    * x[nshape_funs * element + fun_index]
+                )
+    return weights
+
+
+@_numba.njit(cache=True)
+def _lagrange_basis(nodes, weights, differentiation_matrix, t, values, derivatives):
+    """
+    Evaluate the Lagrange basis on Chebychev nodes and its derivative at t.
+
+    The basis is evaluated by barycentric interpolation. The derivatives
+    are obtained from the Chebychev differentiation matrix.
+    """
+    nterms = len(nodes)
+    exact = -1
+    denominator = 0.0
+    for index in range(nterms):
+        diff = t - nodes[index]
+        if diff == 0:
+            exact = index
+            break
+        values[index] = weights[index] / diff
+        denominator += values[index]
+    if exact > -1:
+        values[:] = 0
+        values[exact] = 1
+    else:
+        values /= denominator
+    derivatives[:] = 0
+    for i in range(nterms):
+        for j in range(nterms):
+            derivatives[j] += values[i] * differentiation_matrix[i, j]
+
+
+@_numba.njit(cache=True)
+def _anterpolate(
+    point,
+    normal,
+    weight,
+    normal_derivative,
+    lbound,
+    ubound,
+    nodes,
+    weights,
+    differentiation_matrix,
+    result,
+):
+    """Add the contribution of a weighted source point to interpolation weights."""
+    nterms = len(nodes)
+    values = _np.empty((3, nterms), dtype=_np.float64)
+    derivatives = _np.empty((3, nterms), dtype=_np.float64)
+    scale = _np.empty(3, dtype=_np.float64)
+    for dim in range(3):
+        scale[dim] = 2.0 / (ubound[dim] - lbound[dim])
+        _lagrange_basis(
+            nodes,
+            weights,
+            differentiation_matrix,
+            (point[dim] - lbound[dim]) * scale[dim] - 1,
+            values[dim],
+            derivatives[dim],
+        )
+    for i in range(nterms):
+        for j in range(nterms):
+            for k in range(nterms):
+                if normal_derivative:
+                    factor = (
+                        normal[0]
+                        * scale[0]
+                        * derivatives[0, i]
+                        * values[1, j]
+                        * values[2, k]
+                        + normal[1]
+                        * scale[1]
+                        * values[0, i]
+                        * derivatives[1, j]
+                        * values[2, k]
+                        + normal[2]
+                        * scale[2]
+                        * values[0, i]
+                        * values[1, j]
+                        * derivatives[2, k]
+                    )
+                else:
+                    factor = values[0, i] * values[1, j] * values[2, k]
+                result[i * nterms * nterms + j * nterms + k] += weight * factor
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _upward_pass(
+    global_quad_points,
+    normals,
+    source_weights,
+    normal_derivative,
+    sorted_elements,
+    leaf_ptr,
+    children_ptr,
+    level_ptr,
+    node_lbound,
+    node_ubound,
+    proxy_points,
+    nodes,
+    weights,
+    differentiation_matrix,
+    result_type,
+):
+    """Compute the interpolation weights for all octree nodes."""
+    nnodes = len(children_ptr)
+    nlevels = len(level_ptr) - 1
+    nproxies = proxy_points.shape[2]
+    nquad_points = global_quad_points.shape[2]
+    proxy_weights = _np.zeros((nnodes, nproxies), dtype=result_type)
+
+    leaf_offset = level_ptr[nlevels - 1]
+    for leaf in _numba.prange(len(leaf_ptr) - 1):
+        node = leaf_offset + leaf
+        for index in range(leaf_ptr[leaf], leaf_ptr[leaf + 1]):
+            element_index = sorted_elements[index]
+            for quad_index in range(nquad_points):
+                _anterpolate(
+                    global_quad_points[element_index, :, quad_index],
+                    normals[element_index, :, quad_index],
+                    source_weights[element_index, quad_index],
+                    normal_derivative,
+                    node_lbound[node],
+                    node_ubound[node],
+                    nodes,
+                    weights,
+                    differentiation_matrix,
+                    proxy_weights[node],
+                )
+
+    for level in range(nlevels - 2, -1, -1):
+        for node in _numba.prange(level_ptr[level], level_ptr[level + 1]):
+            for child in range(children_ptr[node, 0], children_ptr[node, 1]):
+                for proxy_index in range(nproxies):
+                    _anterpolate(
+                        proxy_points[child, :, proxy_index],
+                        proxy_points[child, :, proxy_index],
+                        proxy_weights[child, proxy_index],
+                        False,
+                        node_lbound[node],
+                        node_ubound[node],
+                        nodes,
+                        weights,
+                        differentiation_matrix,
+                        proxy_weights[node],
+                    )
+
+    return proxy_weights
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _evaluate_targets(
+    points,
+    target_order,
+    batch_size,
+    theta,
+    near_field_distance,
+    grid_data,
+    support_elements,
+    normal_multipliers,
+    x,
+    global_quad_points,
+    normals,
+    source_weights,
+    near_quad_points,
+    near_quad_weights,
+    near_fun_values,
+    sorted_elements,
+    leaf_ptr,
+    children_ptr,
+    level_ptr,
+    maximum_level,
+    node_centers,
+    node_radii,
+    proxy_points,
+    proxy_weights,
+    kernel_function,
+    proxy_kernel_function,
+    kernel_parameters,
+    result_type,
+):
+    """Evaluate the potential at all points by traversing the octree."""
+    npoints = points.shape[1]
+    nbatches = (npoints + batch_size - 1) // batch_size
+    nshape_funs = near_fun_values.shape[0]
+    nnear_quad_points = len(near_quad_weights)
+    leaf_offset = level_ptr[maximum_level]
+    result = _np.zeros(npoints, dtype=result_type)
+    dummy = _np.zeros(3, dtype=_np.float64)
+
+    for batch in _numba.prange(nbatches):
+        stack = _np.empty(8 * (maximum_level + 1) + 1, dtype=_np.int64)
+        near_normals = _np.empty((3, nnear_quad_points), dtype=_np.float64)
+        near_weights = _np.empty(nnear_quad_points, dtype=result_type)
+        for order_index in range(
+            batch * batch_size, min((batch + 1) * batch_size, npoints)
+        ):
+            point_index = target_order[order_index]
+            test_point = points[:, point_index].copy()
+            value = result_type.type(0)
+            stack[0] = 0
+            top = 1
+            while top > 0:
+                top -= 1
+                node = stack[top]
+                dist = _np.sqrt(_np.sum((test_point - node_centers[node]) ** 2))
+                if node_radii[node] < theta * dist:
+                    kernel_values = proxy_kernel_function(
+                        test_point,
+                        proxy_points[node],
+                        dummy,
+                        proxy_points[node],
+                        kernel_parameters,
+                    )
+                    for proxy_index in range(proxy_points.shape[2]):
+                        value += (
+                            kernel_values[proxy_index]
+                            * proxy_weights[node, proxy_index]
+                        )
+                elif node >= leaf_offset:
+                    leaf = node - leaf_offset
+                    for index in range(leaf_ptr[leaf], leaf_ptr[leaf + 1]):
+                        element_index = sorted_elements[index]
+                        element = support_elements[element_index]
+                        element_dist = _np.sqrt(
+                            _np.sum((test_point - grid_data.centroids[element]) ** 2)
+                        )
+                        if (
+                            element_dist
+                            < near_field_distance * grid_data.diameters[element]
+                        ):
+                            # Evaluation point close to the element. Use a higher order rule.
+                            near_points = grid_data.local2global(
+                                element, near_quad_points
+                            )
+                            for dim in range(3):
+                                near_normals[dim, :] = (
+                                    grid_data.normals[element, dim]
+                                    * normal_multipliers[element]
+                                )
+                            near_weights[:] = 0
+                            for quad_index in range(nnear_quad_points):
+                                for fun_index in range(nshape_funs):
+                                    near_weights[quad_index] += (
+                                        grid_data.integration_elements[element]
+                                        * near_quad_weights[quad_index]
+                                        * near_fun_values[fun_index, quad_index]
+                                        * x[nshape_funs * element + fun_index]
+                                    )
+                            kernel_values = kernel_function(
+                                test_point,
+                                near_points,
+                                dummy,
+                                near_normals,
+                                kernel_parameters,
+                            )
+                            for quad_index in range(nnear_quad_points):
+                                value += (
+                                    kernel_values[quad_index] * near_weights[quad_index]
+                                )
+                        else:
+                            kernel_values = kernel_function(
+                                test_point,
+                                global_quad_points[element_index],
+                                dummy,
+                                normals[element_index],
+                                kernel_parameters,
+                            )
+                            for quad_index in range(global_quad_points.shape[2]):
+                                value += (
+                                    kernel_values[quad_index]
+                                    * source_weights[element_index, quad_index]
+                                )
+                else:
+                    for child in range(children_ptr[node, 0], children_ptr[node, 1]):
+                        stack[top] = child
+                        top += 1
+            result[point_index] = value
+
+    return result
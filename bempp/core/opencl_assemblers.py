@@ -2,12 +2,29 @@
 Actual implementation of OpenCL assemblers.
 """
 
+import threading as _threading
+
 import numpy as _np
 import pyopencl as _cl
 
 WORKGROUP_SIZE_GALERKIN = 16
 WORKGROUP_SIZE_POTENTIAL = 128
 
+# Number of work blocks per device if work is distributed across several
+# devices. More blocks improve the load balance between devices of
+# different speed.
+BLOCKS_PER_DEVICE = 4
+
+# Number of element pairs that a work group of the singular kernels
+# assembles for each adjacency. The work items of a group are split evenly
+# between its pairs, so that adjacencies with fewer quadrature points use
+# fewer work items per pair. Must divide WORKGROUP_SIZE_GALERKIN.
+SINGULAR_PAIRS_PER_GROUP = {
+    "coincident": 1,
+    "edge_adjacent": 1,
+    "vertex_adjacent": 2,
+}
+
 
 def singular_assembler(
     device_interface,
@@ -15,26 +32,31 @@ def singular_assembler(
     grid,
     domain,
     dual_to_range,
-    test_points,
-    trial_points,
-    quad_weights,
-    test_elements,
-    trial_elements,
-    test_offsets,
-    trial_offsets,
-    weights_offsets,
-    number_of_quad_points,
+    rule,
     kernel_options,
     result,
 ):
-    """Assemble singular part of integral operators with OpenCL."""
+    """
+    Assemble singular part of integral operators with OpenCL.
+
+    The element pairs of each adjacency are assembled with their own
+    kernel, which is compiled with the number of quadrature points and
+    permutations of the adjacency table. Each pair only carries the
+    permutation index into the table of its adjacency. The quadrature
+    points of a pair are split into evenly sized chunks for its work
+    items, whose results are summed with a tree reduction in local
+    memory. Work groups of adjacencies in SINGULAR_PAIRS_PER_GROUP
+    assemble several pairs at once. If several
+    assembly devices are used, the element pairs are split into blocks
+    that are distributed dynamically across the devices.
+    """
+    from bempp.api.utils import instrumentation
     from bempp.api.utils.helpers import get_type
     from bempp.core.opencl_kernels import get_kernel_from_operator_descriptor
-    from bempp.core.opencl_kernels import default_context, default_device
+    from bempp.core.opencl_kernels import assembly_devices
 
     mf = _cl.mem_flags
-    ctx = default_context()
-    device = default_device()
+    ctx, devices = assembly_devices()
 
     precision = operator_descriptor.precision
     dtype = get_type(precision).real
@@ -50,100 +72,163 @@ def singular_assembler(
     if operator_descriptor.is_complex:
         options["COMPLEX_KERNEL"] = None
 
-    kernel = get_kernel_from_operator_descriptor(
-        operator_descriptor, options, "singular"
-    )
+    if grid.is_curved:
+        options["CURVED_GRID"] = None
+        grid_array = grid.curved_as_array
+    else:
+        grid_array = grid.as_array
+
+    batches = rule.adjacency_batches()
+    kernels = []
+    for batch in batches:
+        batch_options = dict(options)
+        batch_options["NUMBER_OF_QUAD_POINTS"] = batch.table.number_of_points
+        batch_options["NUMBER_OF_PERMUTATIONS"] = batch.table.number_of_permutations
+        batch_options["PAIRS_PER_GROUP"] = SINGULAR_PAIRS_PER_GROUP[batch.adjacency]
+        kernels.append(
+            get_kernel_from_operator_descriptor(
+                operator_descriptor, batch_options, "singular", context=ctx
+            )
+        )
 
     # Initialize OpenCL Buffers
 
-    grid_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=grid.as_array.astype(dtype)
-    )
-    test_normals_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=dual_to_range.normal_multipliers
-    )
-    trial_normals_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.normal_multipliers
-    )
-    test_points_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=test_points.astype(dtype)
-    )
-    trial_points_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_points.astype(dtype)
-    )
-    quad_weights_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=quad_weights.astype(dtype)
-    )
-    test_elements_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=test_elements
-    )
-    trial_elements_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_elements
-    )
-    test_offsets_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=test_offsets
-    )
-    trial_offsets_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_offsets
-    )
-    weights_offsets_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=weights_offsets
-    )
-
-    local_quad_points = number_of_quad_points // WORKGROUP_SIZE_GALERKIN
-
-    local_quad_points_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=local_quad_points
-    )
+    with instrumentation.span("upload"):
+        grid_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=grid_array.astype(dtype)
+        )
+        test_normals_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=dual_to_range.normal_multipliers,
+        )
+        trial_normals_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.normal_multipliers
+        )
+        table_buffers = [
+            [
+                _cl.Buffer(
+                    ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=array.astype(dtype)
+                )
+                for array in [
+                    batch.table.test_points,
+                    batch.table.trial_points,
+                    batch.table.weights,
+                ]
+            ]
+            for batch in batches
+        ]
+        if not kernel_options:
+            kernel_options = [0.0]
 
-    result_buffer = _cl.Buffer(ctx, mf.WRITE_ONLY, size=result.nbytes)
+        kernel_options_array = _np.array(kernel_options, dtype=dtype)
 
-    if not kernel_options:
-        kernel_options = [0.0]
+        kernel_options_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=kernel_options_array
+        )
+        instrumentation.add_device_memory(
+            result.nbytes
+            + sum(
+                buffer.size
+                for buffer in [
+                    grid_buffer,
+                    test_normals_buffer,
+                    trial_normals_buffer,
+                    kernel_options_buffer,
+                ]
+                + [buffer for buffers in table_buffers for buffer in buffers]
+            )
+        )
 
-    kernel_options_array = _np.array(kernel_options, dtype=dtype)
+    values_per_pair = len(result) // max(rule.index_count["all"], 1)
 
-    kernel_options_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=kernel_options_array
-    )
+    if len(devices) == 1:
+        number_of_blocks = 1
+    else:
+        number_of_blocks = BLOCKS_PER_DEVICE * len(devices)
 
-    number_of_singular_indices = len(test_elements)
+    tasks = [
+        (batch_index, block)
+        for batch_index, batch in enumerate(batches)
+        for block in _np.array_split(
+            _np.arange(batch.start, batch.end), number_of_blocks
+        )
+        if len(block) > 0
+    ]
+
+    def assemble_block(queue, task):
+        """Assemble the element pairs of a block."""
+        batch_index, block = task
+        start, end = block[0], block[-1] + 1
+        batch = batches[batch_index]
+        pairs_per_group = SINGULAR_PAIRS_PER_GROUP[batch.adjacency]
+        number_of_groups = -(-(end - start) // pairs_per_group)
+        padding = (0, pairs_per_group * number_of_groups - (end - start))
+
+        # The kernel indexes the pair arrays by the work group id,
+        # so each block gets its own copies of these arrays. They are
+        # padded with copies of the last pair to fill the last group.
+        pair_buffers = [
+            _cl.Buffer(
+                ctx,
+                mf.READ_ONLY | mf.COPY_HOST_PTR,
+                hostbuf=_np.pad(array, padding, mode="edge"),
+            )
+            for array in [
+                rule.test_indices[start:end],
+                rule.trial_indices[start:end],
+                batch.permutations[start - batch.start : end - batch.start],
+            ]
+        ]
+        block_result = _np.empty(
+            values_per_pair * pairs_per_group * number_of_groups, dtype=result.dtype
+        )
+        result_buffer = _cl.Buffer(ctx, mf.WRITE_ONLY, size=block_result.nbytes)
 
-    with _cl.CommandQueue(ctx, device=device) as queue:
-        kernel(
+        kernels[batch_index](
             queue,
-            (number_of_singular_indices,),
+            (number_of_groups,),
             (WORKGROUP_SIZE_GALERKIN,),
             grid_buffer,
             test_normals_buffer,
             trial_normals_buffer,
-            test_points_buffer,
-            trial_points_buffer,
-            quad_weights_buffer,
-            test_elements_buffer,
-            trial_elements_buffer,
-            test_offsets_buffer,
-            trial_offsets_buffer,
-            weights_offsets_buffer,
-            local_quad_points_buffer,
+            *table_buffers[batch_index],
+            *pair_buffers,
             result_buffer,
             kernel_options_buffer,
             g_times_l=True,
         )
-        _cl.enqueue_copy(queue, result, result_buffer)
+        _cl.enqueue_copy(queue, block_result, result_buffer)
+        result[start * values_per_pair : end * values_per_pair] = block_result[
+            : (end - start) * values_per_pair
+        ]
+
+    with instrumentation.span("kernel run", devices=len(devices)):
+        _distribute(ctx, devices, tasks, assemble_block)
 
 
 def dense_assembler(
     device_interface, operator_descriptor, domain, dual_to_range, parameters, result
 ):
-    """Assemble dense with OpenCL."""
+    """
+    Assemble dense with OpenCL.
+
+    If several assembly devices are used (NUMA sub-devices or devices set
+    with set_assembly_devices), the test elements are split into
+    contiguous blocks that are distributed dynamically across the devices.
+    Each block is assembled into its own result tile, which is allocated
+    and zeroed by the device that assembles it, and then summed into the
+    result. With a single block the result is assembled in place if it
+    has the type of the kernel output. The weak form is always added to
+    the existing entries of result.
+    """
     import bempp.api
+    from bempp.api.utils import instrumentation
     from bempp.api.integration.triangle_gauss import rule
     from bempp.api.utils.helpers import get_type
     from bempp.core.opencl_kernels import get_kernel_from_operator_descriptor
     from bempp.core.opencl_kernels import (
-        default_context,
-        default_device,
+        assembly_devices,
         get_vector_width,
     )
 
@@ -157,19 +242,23 @@ def dense_assembler(
         )
 
     mf = _cl.mem_flags
-    ctx = default_context(device_type)
-    device = default_device(device_type)
+    ctx, devices = assembly_devices(device_type)
 
     precision = operator_descriptor.precision
     dtype = get_type(precision).real
+    if operator_descriptor.is_complex:
+        tile_type = get_type(precision).complex
+    else:
+        tile_type = dtype
     kernel_options = operator_descriptor.options
 
-    quad_points, quad_weights = rule(parameters.quadrature.regular)
+    quad_points, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", domain, dual_to_range)
+    )
 
     test_indices, test_color_indexptr = dual_to_range.get_elements_by_color()
     trial_indices, trial_color_indexptr = domain.get_elements_by_color()
 
-    number_of_test_colors = len(test_color_indexptr) - 1
     number_of_trial_colors = len(trial_color_indexptr) - 1
 
     options = {
@@ -185,8 +274,26 @@ def dense_assembler(
     if operator_descriptor.is_complex:
         options["COMPLEX_KERNEL"] = None
 
+    # Curved grids are only supported by the non-vectorized kernel, which
+    # evaluates the geometry at each quadrature point.
+    curved = domain.grid.is_curved or dual_to_range.grid.is_curved
+    force_novec = curved or device_interface == "opencl_novec"
+
+    if curved:
+        options["CURVED_GRID"] = None
+        test_grid_array = dual_to_range.grid.curved_as_array
+        trial_grid_array = domain.grid.curved_as_array
+    else:
+        test_grid_array = dual_to_range.grid.as_array
+        trial_grid_array = domain.grid.as_array
+
     main_kernel = get_kernel_from_operator_descriptor(
-        operator_descriptor, options, "regular", device_type=device_type
+        operator_descriptor,
+        options,
+        "regular",
+        force_novec=force_novec,
+        device_type=device_type,
+        context=ctx,
     )
     remainder_kernel = get_kernel_from_operator_descriptor(
         operator_descriptor,
@@ -194,87 +301,121 @@ def dense_assembler(
         "regular",
         force_novec=True,
         device_type=device_type,
+        context=ctx,
     )
 
-    test_indices_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=test_indices
-    )
-    trial_indices_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_indices
+    if len(devices) == 1:
+        number_of_blocks = 1
+    else:
+        number_of_blocks = BLOCKS_PER_DEVICE * len(devices)
+
+    partitions = _partition_test_elements(
+        number_of_blocks,
+        test_indices,
+        test_color_indexptr,
+        dual_to_range.local2global,
+        dual_to_range.global_dof_count,
     )
 
-    test_normals_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=dual_to_range.normal_multipliers
-    )
-    trial_normals_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.normal_multipliers
-    )
-    test_grid_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=dual_to_range.grid.as_array.astype(dtype),
-    )
-    trial_grid_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.grid.as_array.astype(dtype)
-    )
+    with instrumentation.span("upload"):
+        trial_indices_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_indices
+        )
 
-    test_elements_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=dual_to_range.grid.elements.ravel(order="F"),
-    )
+        test_normals_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=dual_to_range.normal_multipliers,
+        )
+        trial_normals_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.normal_multipliers
+        )
+        test_grid_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=test_grid_array.astype(dtype),
+        )
+        trial_grid_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=trial_grid_array.astype(dtype)
+        )
 
-    trial_elements_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=domain.grid.elements.ravel(order="F"),
-    )
+        test_elements_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=dual_to_range.grid.elements.ravel(order="F"),
+        )
 
-    test_local2global_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=dual_to_range.local2global
-    )
+        trial_elements_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=domain.grid.elements.ravel(order="F"),
+        )
 
-    trial_local2global_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.local2global
-    )
+        trial_local2global_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.local2global
+        )
 
-    test_multipliers_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=dual_to_range.local_multipliers.astype(dtype),
-    )
+        test_multipliers_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=dual_to_range.local_multipliers.astype(dtype),
+        )
 
-    trial_multipliers_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=domain.local_multipliers.astype(dtype),
-    )
+        trial_multipliers_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=domain.local_multipliers.astype(dtype),
+        )
 
-    quad_points_buffer = _cl.Buffer(
-        ctx,
-        mf.READ_ONLY | mf.COPY_HOST_PTR,
-        hostbuf=quad_points.ravel(order="F").astype(dtype),
-    )
+        quad_points_buffer = _cl.Buffer(
+            ctx,
+            mf.READ_ONLY | mf.COPY_HOST_PTR,
+            hostbuf=quad_points.ravel(order="F").astype(dtype),
+        )
 
-    quad_weights_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=quad_weights.astype(dtype)
-    )
+        quad_weights_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=quad_weights.astype(dtype)
+        )
 
-    result_buffer = _cl.Buffer(ctx, mf.READ_WRITE, size=result.nbytes)
+        if not kernel_options:
+            kernel_options = [0.0]
 
-    if not kernel_options:
-        kernel_options = [0.0]
+        kernel_options_array = _np.array(kernel_options, dtype=dtype)
 
-    kernel_options_array = _np.array(kernel_options, dtype=dtype)
+        kernel_options_buffer = _cl.Buffer(
+            ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=kernel_options_array
+        )
 
-    kernel_options_buffer = _cl.Buffer(
-        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=kernel_options_array
-    )
+        instrumentation.add_device_memory(
+            result.nbytes
+            + sum(
+                buffer.size
+                for buffer in [
+                    trial_indices_buffer,
+                    test_normals_buffer,
+                    trial_normals_buffer,
+                    test_grid_buffer,
+                    trial_grid_buffer,
+                    test_elements_buffer,
+                    trial_elements_buffer,
+                    trial_local2global_buffer,
+                    test_multipliers_buffer,
+                    trial_multipliers_buffer,
+                    quad_points_buffer,
+                    quad_weights_buffer,
+                    kernel_options_buffer,
+                ]
+            )
+        )
 
-    vector_width = get_vector_width(precision, device_type=device_type)
+    if force_novec:
+        vector_width = 1
+    else:
+        vector_width = get_vector_width(precision, device_type=device_type)
 
     def kernel_runner(
         queue,
+        buffers,
         test_offset,
         trial_offset,
         test_number_of_indices,
@@ -284,28 +425,6 @@ def dense_assembler(
         remainder_size = trial_number_of_indices % vector_width
         main_size = trial_number_of_indices - remainder_size
 
-        buffers = [
-            test_indices_buffer,
-            trial_indices_buffer,
-            test_normals_buffer,
-            trial_normals_buffer,
-            test_grid_buffer,
-            trial_grid_buffer,
-            test_elements_buffer,
-            trial_elements_buffer,
-            test_local2global_buffer,
-            trial_local2global_buffer,
-            test_multipliers_buffer,
-            trial_multipliers_buffer,
-            quad_points_buffer,
-            quad_weights_buffer,
-            result_buffer,
-            kernel_options_buffer,
-            _np.int32(dual_to_range.global_dof_count),
-            _np.int32(domain.global_dof_count),
-            _np.uint8(domain.grid != dual_to_range.grid),
-        ]
-
         if main_size > 0:
             main_kernel(
                 queue,
@@ -324,13 +443,67 @@ def dense_assembler(
                 global_offset=(test_offset, trial_offset + main_size),
             )
 
-    with _cl.CommandQueue(ctx, device=device) as queue:
-        _cl.enqueue_fill_buffer(queue, result_buffer, _np.uint8(0), 0, result.nbytes)
-        for test_index in range(number_of_test_colors):
-            test_offset = test_color_indexptr[test_index]
-            n_test_indices = (
-                test_color_indexptr[1 + test_index] - test_color_indexptr[test_index]
+    result_lock = _threading.Lock()
+
+    # A single partition covers all rows and can be assembled in place if
+    # the result has the type of the kernel output.
+    direct = (
+        len(partitions) == 1 and result.dtype == tile_type and result.flags.c_contiguous
+    )
+
+    def assemble_partition(queue, partition):
+        """Assemble the rows of a partition and add them to the result."""
+        if len(partition.test_indices) == 0:
+            return
+
+        if direct:
+            # The kernels add to the uploaded result, which is then
+            # copied back in place.
+            tile = result
+            tile_buffer = _cl.Buffer(
+                ctx, mf.READ_WRITE | mf.COPY_HOST_PTR, hostbuf=result
             )
+        else:
+            # The result tile is created without host pointer and zeroed by
+            # the queue of the device that assembles it, so that its memory
+            # is first touched by this device.
+            tile = _np.empty((len(partition.rows), result.shape[1]), dtype=tile_type)
+            tile_buffer = _cl.Buffer(ctx, mf.READ_WRITE, size=tile.nbytes)
+            _cl.enqueue_fill_buffer(queue, tile_buffer, _np.uint8(0), 0, tile.nbytes)
+
+        buffers = [
+            _cl.Buffer(
+                ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=partition.test_indices
+            ),
+            trial_indices_buffer,
+            test_normals_buffer,
+            trial_normals_buffer,
+            test_grid_buffer,
+            trial_grid_buffer,
+            test_elements_buffer,
+            trial_elements_buffer,
+            _cl.Buffer(
+                ctx,
+                mf.READ_ONLY | mf.COPY_HOST_PTR,
+                hostbuf=partition.test_local2global,
+            ),
+            trial_local2global_buffer,
+            test_multipliers_buffer,
+            trial_multipliers_buffer,
+            quad_points_buffer,
+            quad_weights_buffer,
+            tile_buffer,
+            kernel_options_buffer,
+            _np.int32(len(partition.rows)),
+            _np.int32(domain.global_dof_count),
+            _np.uint8(domain.grid != dual_to_range.grid),
+        ]
+
+        for test_index in range(len(partition.test_color_indexptr) - 1):
+            test_offset = partition.test_color_indexptr[test_index]
+            n_test_indices = partition.test_color_indexptr[1 + test_index] - test_offset
+            if n_test_indices == 0:
+                continue
             for trial_index in range(number_of_trial_colors):
                 n_trial_indices = (
                     trial_color_indexptr[1 + trial_index]
@@ -338,25 +511,308 @@ def dense_assembler(
                 )
                 trial_offset = trial_color_indexptr[trial_index]
                 kernel_runner(
-                    queue, test_offset, trial_offset, n_test_indices, n_trial_indices
+                    queue,
+                    buffers,
+                    test_offset,
+                    trial_offset,
+                    n_test_indices,
+                    n_trial_indices,
                 )
-        _cl.enqueue_copy(queue, result, result_buffer)
+        _cl.enqueue_copy(queue, tile, tile_buffer)
+
+        if not direct:
+            with result_lock:
+                result[partition.rows] += tile
+
+    with instrumentation.span("kernel run", devices=len(devices)):
+        _distribute(ctx, devices, partitions, assemble_partition)
+
+
+def _distribute(ctx, devices, tasks, fun):
+    """
+    Process tasks on several devices with dynamic load balancing.
+
+    Each device is driven by a host thread that repeatedly takes the
+    next task from a shared queue and calls fun(queue, task) with a
+    command queue of its device. Devices that finish their tasks early
+    take over the remaining ones. Returns the results in task order.
+    Spans opened by fun are children of the current span of the calling
+    thread.
+    """
+    import queue as _queue
+    from bempp.api.utils import instrumentation
+
+    results = len(tasks) * [None]
+
+    if len(devices) == 1:
+        with _cl.CommandQueue(ctx, device=devices[0]) as queue:
+            for index, task in enumerate(tasks):
+                results[index] = fun(queue, task)
+        return results
+
+    pending = _queue.Queue()
+    for index, task in enumerate(tasks):
+        pending.put((index, task))
+    errors = []
+    parent = instrumentation.current_span()
+
+    def drive(device):
+        """Process tasks on a device until no tasks are left."""
+        with instrumentation.attach(parent), _cl.CommandQueue(
+            ctx, device=device
+        ) as queue:
+            while not errors:
+                try:
+                    index, task = pending.get_nowait()
+                except _queue.Empty:
+                    return
+                try:
+                    results[index] = fun(queue, task)
+                except Exception as error:  # pylint: disable=broad-except
+                    errors.append(error)
+
+    threads = [_threading.Thread(target=drive, args=(device,)) for device in devices]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    if errors:
+        raise errors[0]
+    return results
+
+
+class _TestPartition(object):
+    """Test elements and result rows assembled by one device."""
+
+    def __init__(self, test_indices, test_color_indexptr, test_local2global, rows):
+        """Create a partition."""
+        self.test_indices = test_indices
+        self.test_color_indexptr = test_color_indexptr
+        self.test_local2global = test_local2global
+        self.rows = rows
+
+
+def _partition_test_elements(
+    number_of_partitions, test_indices, test_color_indexptr, local2global, row_count
+):
+    """
+    Split the test elements into contiguous blocks.
+
+    Each partition keeps the color ordering of its elements. Its
+    local2global map is compressed to the rows touched by its elements.
+    A single partition covers all rows.
+    """
+    if number_of_partitions == 1:
+        return [
+            _TestPartition(
+                test_indices,
+                test_color_indexptr,
+                local2global,
+                _np.arange(row_count),
+            )
+        ]
 
+    colors = _np.repeat(
+        _np.arange(len(test_color_indexptr) - 1), _np.diff(test_color_indexptr)
+    )
+    blocks = _np.array_split(_np.sort(test_indices), number_of_partitions)
+
+    partitions = []
+    for block in blocks:
+        in_block = _np.isin(test_indices, block)
+        indices = test_indices[in_block]
+        indexptr = _np.zeros(len(test_color_indexptr), dtype=test_color_indexptr.dtype)
+        indexptr[1:] = _np.cumsum(
+            _np.bincount(colors[in_block], minlength=len(test_color_indexptr) - 1)
+        )
+        rows = _np.unique(local2global[block])
+        compressed = _np.zeros_like(local2global)
+        compressed[block] = _np.searchsorted(rows, local2global[block]).astype(
+            local2global.dtype
+        )
+        partitions.append(_TestPartition(indices, indexptr, compressed, rows))
+    return partitions
 
-def potential_assembler(
-    device_interface, space, operator_descriptor, points, parameters
+
+def sparse_csr_assembler(
+    device_interface,
+    operator_descriptor,
+    domain,
+    dual_to_range,
+    parameters,
+    elements,
+    pattern,
+    data,
 ):
-    """Assemble dense with OpenCL."""
-    import bempp.api
+    """
+    Assemble the CSR data of sparse operators with OpenCL.
+
+    The element matrices remain on the device and are summed into the
+    CSR data array by a gather kernel. Only the CSR data is copied back.
+    """
+    from bempp.api.utils.helpers import get_type
+    from bempp.core.opencl_kernels import build_program
+    from bempp.core.opencl_kernels import default_context, default_device
+
+    mf = _cl.mem_flags
+    ctx = default_context()
+    device = default_device()
+
+    # Always assemble in double precision for sparse ops
+    precision = "double"
+    dtype = get_type(precision).real
+
+    options = {
+        "NUMBER_OF_TEST_SHAPE_FUNCTIONS": dual_to_range.number_of_shape_functions,
+        "NUMBER_OF_TRIAL_SHAPE_FUNCTIONS": domain.number_of_shape_functions,
+    }
+
+    gather_kernel = build_program("csr_gather_novec", options, precision)
+
+    test_multipliers_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=pattern.test_multipliers.astype(dtype),
+    )
+    trial_multipliers_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=pattern.trial_multipliers.astype(dtype),
+    )
+    order_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=pattern.order.astype("uint64")
+    )
+    gather_ptr_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=pattern.gather_ptr.astype("uint64"),
+    )
+
+    csr_data = _np.empty(len(data), dtype=dtype)
+    data_buffer = _cl.Buffer(ctx, mf.WRITE_ONLY, size=csr_data.nbytes)
+
+    with _cl.CommandQueue(ctx, device=device) as queue:
+        values_buffer = _sparse_element_matrices(
+            queue, operator_descriptor, domain, dual_to_range, parameters, elements
+        )
+        if len(csr_data) > 0:
+            gather_kernel(
+                queue,
+                (len(csr_data),),
+                None,
+                values_buffer,
+                test_multipliers_buffer,
+                trial_multipliers_buffer,
+                order_buffer,
+                gather_ptr_buffer,
+                data_buffer,
+            )
+            _cl.enqueue_copy(queue, csr_data, data_buffer)
+
+    data[:] = csr_data
+
+
+def _sparse_element_matrices(
+    queue, operator_descriptor, domain, dual_to_range, parameters, elements
+):
+    """Enqueue the element matrix kernel and return the result buffer."""
     from bempp.api.integration.triangle_gauss import rule
     from bempp.api.utils.helpers import get_type
-    from bempp.core.opencl_kernels import get_kernel_from_name
-    from bempp.core.opencl_kernels import get_kernel_from_operator_descriptor
-    from bempp.core.opencl_kernels import (
-        default_context,
-        default_device,
-        get_vector_width,
+    from bempp.core.opencl_kernels import build_program, select_cl_sparse_kernel
+
+    kernel_name = select_cl_sparse_kernel(operator_descriptor, domain, dual_to_range)
+    if kernel_name is None:
+        raise ValueError(
+            f"No OpenCL sparse kernel for {operator_descriptor.identifier} with "
+            + f"spaces {dual_to_range.identifier} and {domain.identifier}."
+        )
+
+    mf = _cl.mem_flags
+    ctx = queue.context
+
+    # Always assemble in double precision for sparse ops
+    precision = "double"
+    dtype = get_type(precision).real
+
+    quad_points, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", domain, dual_to_range)
+    )
+
+    nshape_test = dual_to_range.number_of_shape_functions
+    nshape_trial = domain.number_of_shape_functions
+
+    options = {
+        "TEST": dual_to_range.shapeset.identifier,
+        "TRIAL": domain.shapeset.identifier,
+        "NUMBER_OF_TEST_SHAPE_FUNCTIONS": nshape_test,
+        "NUMBER_OF_TRIAL_SHAPE_FUNCTIONS": nshape_trial,
+        "NUMBER_OF_QUAD_POINTS": len(quad_weights),
+    }
+
+    kernel = build_program(
+        kernel_name,
+        options,
+        precision,
+        kernel_name="evaluate",
+    )
+
+    nelements = len(elements)
+    nbytes = nshape_test * nshape_trial * nelements * _np.dtype(dtype).itemsize
+
+    grid_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=domain.grid.as_array.astype(dtype),
+    )
+    indices_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=elements.astype("uint32")
+    )
+    test_normals_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=dual_to_range.normal_multipliers
+    )
+    trial_normals_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=domain.normal_multipliers
+    )
+    quad_points_buffer = _cl.Buffer(
+        ctx,
+        mf.READ_ONLY | mf.COPY_HOST_PTR,
+        hostbuf=quad_points.ravel(order="F").astype(dtype),
     )
+    quad_weights_buffer = _cl.Buffer(
+        ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=quad_weights.astype(dtype)
+    )
+    result_buffer = _cl.Buffer(ctx, mf.READ_WRITE, size=max(nbytes, 1))
+
+    if nelements > 0:
+        kernel(
+            queue,
+            (1, nelements),
+            (1, 1),
+            grid_buffer,
+            indices_buffer,
+            test_normals_buffer,
+            trial_normals_buffer,
+            quad_points_buffer,
+            quad_weights_buffer,
+            result_buffer,
+            _np.int32(nelements),
+        )
+
+    return result_buffer
+
+
+def potential_assembler(
+    device_interface, space, operator_descriptor, points, parameters
+):
+    """
+    Assemble dense with OpenCL.
+
+    If several assembly devices are used, the evaluation points are split
+    into batches that are distributed dynamically across the devices.
+    """
+    import bempp.api
+    from bempp.core.opencl_kernels import assembly_devices
 
     if bempp.api.POTENTIAL_OPERATOR_DEVICE_TYPE == "gpu":
         device_type = "gpu"
@@ -367,11 +823,50 @@ def potential_assembler(
             f"Unknown device type {bempp.api.POTENTIAL_OPERATOR_DEVICE_TYPE}"
         )
 
+    ctx, devices = assembly_devices(device_type)
+
+    if len(devices) == 1:
+        number_of_batches = 1
+    else:
+        number_of_batches = BLOCKS_PER_DEVICE * len(devices)
+
+    batch_evaluators = [
+        _potential_evaluator(
+            space, operator_descriptor, batch, parameters, device_type, ctx
+        )
+        for batch in _np.array_split(points, number_of_batches, axis=1)
+        if batch.shape[1] > 0 or number_of_batches == 1
+    ]
+
+    def evaluator(x):
+        """Evaluate a potential."""
+        return _np.concatenate(
+            _distribute(
+                ctx,
+                devices,
+                batch_evaluators,
+                lambda queue, batch_evaluator: batch_evaluator(queue, x),
+            )
+        )
+
+    return evaluator
+
+
+def _potential_evaluator(
+    space, operator_descriptor, points, parameters, device_type, ctx
+):
+    """Return an evaluator of a potential at given points."""
+    from bempp.api.integration.triangle_gauss import rule
+    from bempp.api.utils.helpers import get_type
+    from bempp.core.opencl_kernels import get_kernel_from_name
+    from bempp.core.opencl_kernels import get_kernel_from_operator_descriptor
+    from bempp.core.opencl_kernels import get_vector_width
+
     mf = _cl.mem_flags
-    ctx = default_context(device_type)
-    device = default_device(device_type)
 
-    quad_points, quad_weights = rule(parameters.quadrature.regular)
+    quad_points, quad_weights = rule(
+        parameters.quadrature.adapted_order("regular", space)
+    )
 
     precision = operator_descriptor.precision
     dtype = get_type(precision).real
@@ -386,7 +881,11 @@ def potential_assembler(
 
     indices = space.support_elements
     nelements = len(indices)
-    vector_width = get_vector_width(precision, device_type=device_type)
+    if operator_descriptor.assembly_type.startswith("fused"):
+        # Fused potentials are only implemented as non-vectorized kernels.
+        vector_width = 1
+    else:
+        vector_width = get_vector_width(precision, device_type=device_type)
     npoints = points.shape[1]
     remainder_size = nelements % WORKGROUP_SIZE_POTENTIAL
     main_size = nelements - remainder_size
@@ -409,10 +908,19 @@ def potential_assembler(
 
     if main_size > 0:
         main_kernel = get_kernel_from_operator_descriptor(
-            operator_descriptor, options, "potential", device_type=device_type
+            operator_descriptor,
+            options,
+            "potential",
+            force_novec=vector_width == 1,
+            device_type=device_type,
+            context=ctx,
         )
         sum_kernel = get_kernel_from_name(
-            "sum_for_potential_novec", options, precision, device_type=device_type
+            "sum_for_potential_novec",
+            options,
+            precision,
+            device_type=device_type,
+            context=ctx,
         )
 
     if remainder_size > 0:
@@ -423,6 +931,7 @@ def potential_assembler(
             "potential",
             force_novec=True,
             device_type=device_type,
+            context=ctx,
         )
 
     indices_buffer = _cl.Buffer(ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=indices)
@@ -483,66 +992,65 @@ def potential_assembler(
         ctx, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=kernel_options_array
     )
 
-    def evaluator(x):
-        """Evaluate a potential."""
+    def evaluator(queue, x):
+        """Evaluate a potential with a given command queue."""
         result = _np.empty(kernel_dimension * npoints, dtype=result_type)
 
-        with _cl.CommandQueue(ctx, device=device) as queue:
-            _cl.enqueue_copy(queue, coefficients_buffer, x.astype(result_type))
-            _cl.enqueue_fill_buffer(
-                queue,
-                result_buffer,
-                _np.uint8(0),
-                0,
-                kernel_dimension * npoints * result_type.itemsize,
-            )
+        _cl.enqueue_copy(queue, coefficients_buffer, x.astype(result_type))
+        _cl.enqueue_fill_buffer(
+            queue,
+            result_buffer,
+            _np.uint8(0),
+            0,
+            kernel_dimension * npoints * result_type.itemsize,
+        )
 
-            if main_size > 0:
-                _cl.enqueue_fill_buffer(queue, sum_buffer, _np.uint8(0), 0, sum_size)
-                queue.finish()
+        if main_size > 0:
+            _cl.enqueue_fill_buffer(queue, sum_buffer, _np.uint8(0), 0, sum_size)
+            queue.finish()
 
-                main_kernel(
-                    queue,
-                    (npoints, main_size // vector_width),
-                    (1, WORKGROUP_SIZE_POTENTIAL // vector_width),
-                    grid_buffer,
-                    indices_buffer,
-                    normals_buffer,
-                    points_buffer,
-                    coefficients_buffer,
-                    quad_points_buffer,
-                    quad_weights_buffer,
-                    sum_buffer,
-                    kernel_options_buffer,
-                )
+            main_kernel(
+                queue,
+                (npoints, main_size // vector_width),
+                (1, WORKGROUP_SIZE_POTENTIAL // vector_width),
+                grid_buffer,
+                indices_buffer,
+                normals_buffer,
+                points_buffer,
+                coefficients_buffer,
+                quad_points_buffer,
+                quad_weights_buffer,
+                sum_buffer,
+                kernel_options_buffer,
+            )
 
-                sum_kernel(
-                    queue,
-                    (kernel_dimension * npoints,),
-                    (1,),
-                    sum_buffer,
-                    result_buffer,
-                    _np.uint32(nelements // WORKGROUP_SIZE_POTENTIAL),
-                )
+            sum_kernel(
+                queue,
+                (kernel_dimension * npoints,),
+                (1,),
+                sum_buffer,
+                result_buffer,
+                _np.uint32(nelements // WORKGROUP_SIZE_POTENTIAL),
+            )
 
-            if remainder_size > 0:
-                remainder_kernel(
-                    queue,
-                    (npoints, remainder_size),
-                    (1, remainder_size),
-                    grid_buffer,
-                    indices_buffer,
-                    normals_buffer,
-                    points_buffer,
-                    coefficients_buffer,
-                    quad_points_buffer,
-                    quad_weights_buffer,
-                    result_buffer,
-                    kernel_options_buffer,
-                    global_offset=(0, main_size),
-                )
+        if remainder_size > 0:
+            remainder_kernel(
+                queue,
+                (npoints, remainder_size),
+                (1, remainder_size),
+                grid_buffer,
+                indices_buffer,
+                normals_buffer,
+                points_buffer,
+                coefficients_buffer,
+                quad_points_buffer,
+                quad_weights_buffer,
+                result_buffer,
+                kernel_options_buffer,
+                global_offset=(0, main_size),
+            )
 
-            _cl.enqueue_copy(queue, result, result_buffer)
+        _cl.enqueue_copy(queue, result, result_buffer)
 
         return result
 
@@ -13,6 +13,12 @@ _DEFAULT_CPU_CONTEXT = None
 _DEFAULT_GPU_DEVICE = None
 _DEFAULT_GPU_CONTEXT = None
 
+_NUMA_CPU_DEVICES = None
+_NUMA_CPU_CONTEXT = None
+
+_ASSEMBLY_DEVICES = None
+_ASSEMBLY_CONTEXT = None
+
 
 def select_cl_kernel(operator_descriptor, mode):
     """Select OpenCL kernel."""
@@ -23,6 +29,7 @@ def select_cl_kernel(operator_descriptor, mode):
         "modified_helmholtz_hypersingular": "evaluate_dense_helmholtz_hypersingular_singular",
         "maxwell_electric_field": "evaluate_dense_electric_field_singular",
         "maxwell_magnetic_field": "evaluate_dense_magnetic_field_singular",
+        "maxwell_combined_field": "evaluate_dense_combined_field_singular",
     }
 
     regular_assemblers = {
@@ -32,6 +39,7 @@ def select_cl_kernel(operator_descriptor, mode):
         "modified_helmholtz_hypersingular": "evaluate_dense_helmholtz_hypersingular_regular",
         "maxwell_electric_field": "evaluate_dense_electric_field_regular",
         "maxwell_magnetic_field": "evaluate_dense_magnetic_field_regular",
+        "maxwell_combined_field": "evaluate_dense_combined_field_regular",
     }
 
     potential_assemblers = {
@@ -40,6 +48,8 @@ def select_cl_kernel(operator_descriptor, mode):
         "maxwell_magnetic_field": "evaluate_magnetic_field_potential",
         "maxwell_electric_far_field": "evaluate_maxwell_electric_far_field",
         "maxwell_magnetic_far_field": "evaluate_maxwell_magnetic_far_field",
+        "fused_scalar": "evaluate_fused_scalar_potential",
+        "fused_maxwell": "evaluate_fused_maxwell_potential",
     }
 
     kernels = {
@@ -54,6 +64,9 @@ def select_cl_kernel(operator_descriptor, mode):
         "modified_helmholtz_single_layer": "modified_helmholtz_real_single_layer",
         "modified_helmholtz_double_layer": "modified_helmholtz_real_double_layer",
         "modified_helmholtz_adjoint_double_layer": "modified_helmholtz_real_adjoint_double_layer",
+        "laplace_single_and_double_layer": "laplace_single_and_double_layer",
+        "helmholtz_single_and_double_layer": "helmholtz_single_and_double_layer",
+        "modified_helmholtz_single_and_double_layer": "modified_helmholtz_real_single_and_double_layer",
     }
 
     if mode == "singular":
@@ -112,23 +125,45 @@ def get_kernel_compile_options(options, precision):
     return compile_options
 
 
-def build_program(assembly_function, options, precision, device_type="cpu"):
-    """Build the kernel and return it."""
+def build_program(
+    assembly_function,
+    options,
+    precision,
+    device_type="cpu",
+    kernel_name="kernel_function",
+    context=None,
+):
+    """
+    Build the kernel and return it.
+
+    The kernel is built for the default context of the device type
+    unless a context is given.
+    """
+    from bempp.api.utils import instrumentation
+
+    if context is None:
+        context = default_context(device_type)
+
     file_name = assembly_function + ".cl"
     kernel_file = _os.path.join(_KERNEL_PATH, file_name)
 
     kernel_string = open(kernel_file).read()
     kernel_options = get_kernel_compile_options(options, precision)
 
-    return (
-        _cl.Program(default_context(device_type), kernel_string)
-        .build(options=kernel_options)
-        .kernel_function
-    )
+    with instrumentation.span("kernel build", kernel=assembly_function):
+        return getattr(
+            _cl.Program(context, kernel_string).build(options=kernel_options),
+            kernel_name,
+        )
 
 
 def get_kernel_from_operator_descriptor(
-    operator_descriptor, options, mode, force_novec=False, device_type="cpu"
+    operator_descriptor,
+    options,
+    mode,
+    force_novec=False,
+    device_type="cpu",
+    context=None,
 ):
     """Return compiled kernel from operator descriptor."""
     precision = operator_descriptor.precision
@@ -145,10 +180,44 @@ def get_kernel_from_operator_descriptor(
     options["KERNEL_FUNCTION"] = kernel_name
     options["VEC_LENGTH"] = vec_length
     options["VEC_STRING"] = vec_string
-    return build_program(assembly_function, options, precision, device_type)
+    return build_program(
+        assembly_function, options, precision, device_type, context=context
+    )
+
+
+# Pairs of test and trial vector spaces with an OpenCL identity kernel.
+VECTOR_IDENTITY_KERNELS = [
+    ("rwg0", "rwg0"),
+    ("rwg0", "snc0"),
+    ("rwg1", "rwg1"),
+    ("snc0", "rwg0"),
+    ("snc0", "snc0"),
+]
 
 
-def get_kernel_from_name(name, options, precision="double", device_type="cpu"):
+def select_cl_sparse_kernel(operator_descriptor, domain, dual_to_range):
+    """
+    Select the OpenCL kernel for the element matrices of a sparse operator.
+
+    Returns None if there is no OpenCL kernel for the operator and the
+    pair of spaces.
+    """
+    if operator_descriptor.kernel_type != "l2_identity":
+        return None
+
+    spaces = (dual_to_range.identifier, domain.identifier)
+
+    if spaces in VECTOR_IDENTITY_KERNELS:
+        return f"{spaces[0]}_{spaces[1]}_identity_novec"
+    elif domain.codomain_dimension == 1 and dual_to_range.codomain_dimension == 1:
+        return "scalar_identity_novec"
+    else:
+        return None
+
+
+def get_kernel_from_name(
+    name, options, precision="double", device_type="cpu", context=None
+):
     """Return compiled kernel from name."""
 
     vec_length = get_vector_width(precision, device_type)
@@ -156,7 +225,7 @@ def get_kernel_from_name(name, options, precision="double", device_type="cpu"):
 
     options["VEC_LENGTH"] = vec_length
     options["VEC_STRING"] = vec_string
-    return build_program(name, options, precision, device_type)
+    return build_program(name, options, precision, device_type, context=context)
 
 
 def get_vector_width(precision, device_type="cpu"):
@@ -168,7 +237,11 @@ def get_vector_width(precision, device_type="cpu"):
     if device_type == "gpu":
         return 1
     if bempp.api.VECTORIZATION_MODE == "auto":
-        return get_native_vector_width(default_device(device_type), precision)
+        # The kernels of all assembly devices are built with one width.
+        return min(
+            get_native_vector_width(device, precision)
+            for device in assembly_devices(device_type)[1]
+        )
     else:
         return mode_to_length[bempp.api.VECTORIZATION_MODE]
 
@@ -252,6 +325,117 @@ def default_context(device_type="cpu"):
         raise ValueError(f"Unknown value for 'mode' = {device_type}.")
 
 
+def numa_cpu_devices():
+    """
+    Return a context and the NUMA sub-devices of the default CPU device.
+
+    The default CPU device is partitioned by the NUMA affinity domain.
+    If the driver does not support this partitioning or the machine
+    has a single NUMA node, the default CPU context and device are
+    returned.
+    """
+    import bempp.api
+
+    # pylint: disable=W0603
+    global _NUMA_CPU_DEVICES
+    global _NUMA_CPU_CONTEXT
+
+    if _NUMA_CPU_DEVICES is None:
+        device = default_cpu_device()
+        try:
+            sub_devices = device.create_sub_devices(
+                [
+                    _cl.device_partition_property.BY_AFFINITY_DOMAIN,
+                    _cl.device_affinity_domain.NUMA,
+                ]
+            )
+        except _cl.Error:
+            sub_devices = []
+
+        if len(sub_devices) > 1:
+            _NUMA_CPU_CONTEXT = _cl.Context(devices=sub_devices)
+            _NUMA_CPU_DEVICES = sub_devices
+        else:
+            _NUMA_CPU_CONTEXT = default_cpu_context()
+            _NUMA_CPU_DEVICES = [device]
+        bempp.api.log(
+            f"OpenCL CPU Device partitioned into {len(_NUMA_CPU_DEVICES)} NUMA sub-devices."
+        )
+    return _NUMA_CPU_CONTEXT, _NUMA_CPU_DEVICES
+
+
+def assembly_devices(device_type="cpu"):
+    """
+    Return the context and the list of devices used for assembly.
+
+    These are the devices set with set_assembly_devices. Otherwise, for
+    CPU devices with bempp.api.OPENCL_NUMA_FISSION set, these are the
+    NUMA sub-devices of the default CPU device. Otherwise the list only
+    contains the default device.
+    """
+    import bempp.api
+
+    if _ASSEMBLY_DEVICES is not None:
+        return _ASSEMBLY_CONTEXT, _ASSEMBLY_DEVICES
+    if device_type == "cpu" and bempp.api.OPENCL_NUMA_FISSION:
+        return numa_cpu_devices()
+    return default_context(device_type), [default_device(device_type)]
+
+
+def set_assembly_devices(context, devices=None):
+    """
+    Use several devices of a context for assembly.
+
+    Dense and singular assembly and potential evaluation split their
+    work into blocks that are distributed dynamically across the devices.
+    If devices is None, all devices of the context are used. The devices
+    are used for CPU and GPU device types. Call with context=None to
+    return to the default devices.
+    """
+    import bempp.api
+
+    # pylint: disable=W0603
+    global _ASSEMBLY_DEVICES
+    global _ASSEMBLY_CONTEXT
+
+    if context is None:
+        _ASSEMBLY_CONTEXT = None
+        _ASSEMBLY_DEVICES = None
+        return
+
+    if devices is None:
+        devices = context.devices
+
+    _ASSEMBLY_CONTEXT = context
+    _ASSEMBLY_DEVICES = list(devices)
+    bempp.api.log(
+        "Assembly devices set to: "
+        + ", ".join(device.name for device in _ASSEMBLY_DEVICES)
+    )
+
+
+def set_assembly_devices_by_name(name):
+    """Use all devices of the first platform containing name for assembly."""
+    context, _ = get_context_by_name(name)
+    set_assembly_devices(context)
+
+
+def get_context_by_name(identifier):
+    """
+    Return a context with all devices of a platform and the platform index.
+
+    The platform is the first one whose name contains identifier.
+    """
+    for platform_index, platform in enumerate(_cl.get_platforms()):
+        if identifier in platform.name:
+            context = _cl.Context(
+                dev_type=_cl.device_type.ALL,
+                properties=[(_cl.context_properties.PLATFORM, platform)],
+            )
+            return context, platform_index
+    raise ValueError(f"No OpenCL platform containing {identifier} found.")
+
+
 def default_cpu_context():
     """Return default CPU context."""
 
@@ -416,7 +600,7 @@ def set_default_gpu_device(platform_index, device_index):
     _DEFAULT_GPU_CONTEXT = _cl.Context(
         devices=[device], properties=[(_cl.context_properties.PLATFORM, platform)]
     )
-    _DEFAULT_GPU_DEVICE = _DEFAULT_CPU_CONTEXT.devices[0]
+    _DEFAULT_GPU_DEVICE = _DEFAULT_GPU_CONTEXT.devices[0]
 
     vector_width_single = _DEFAULT_GPU_DEVICE.native_vector_width_float
     vector_width_double = _DEFAULT_GPU_DEVICE.native_vector_width_double
@@ -25,6 +25,7 @@ class SingularAssembler(_assembler.AssemblerBase):
         from bempp.api.utils.helpers import promote_to_double_precision
         from scipy.sparse import coo_matrix, csr_matrix
         from bempp.api.space.space import return_compatible_representation
+        from bempp.api.utils import instrumentation
 
         domain, dual_to_range = return_compatible_representation(
             self.domain, self.dual_to_range
@@ -58,10 +59,11 @@ class SingularAssembler(_assembler.AssemblerBase):
         if self.parameters.assembly.always_promote_to_double:
             values = promote_to_double_precision(values)
 
-        mat = coo_matrix(
-            (global_values, (global_rows, global_cols)),
-            shape=(row_grid_dofs, col_grid_dofs),
-        ).tocsr()
+        with instrumentation.span("scatter"):
+            mat = coo_matrix(
+                (global_values, (global_rows, global_cols)),
+                shape=(row_grid_dofs, col_grid_dofs),
+            ).tocsr()
 
         if domain.requires_dof_transformation:
             mat = mat @ domain.dof_transformation
@@ -73,9 +75,21 @@ class SingularAssembler(_assembler.AssemblerBase):
 
 
 def assemble_singular_part(
-    domain, dual_to_range, parameters, operator_descriptor, device_interface
+    domain,
+    dual_to_range,
+    parameters,
+    operator_descriptor,
+    device_interface,
+    test_support=None,
+    trial_support=None,
 ):
-    """Actually assemble the Numba kernel."""
+    """
+    Actually assemble the Numba kernel.
+
+    By default all singular element pairs in the support of the spaces
+    are assembled. The boolean arrays test_support and trial_support
+    restrict the test and trial elements of the assembled pairs.
+    """
     from bempp.api.utils.helpers import get_type
     from bempp.core.dispatcher import singular_assembler_dispatcher
     import bempp.api
@@ -85,26 +99,24 @@ def assemble_singular_part(
     is_complex = operator_descriptor.is_complex
 
     grid = domain.grid
-    order = parameters.quadrature.singular
+    order = parameters.quadrature.adapted_order("singular", domain, dual_to_range)
 
-    rule = _SingularQuadratureRuleInterfaceGalerkin(
-        grid, order, dual_to_range.support, domain.support
-    )
+    if test_support is None:
+        test_support = dual_to_range.support
+    if trial_support is None:
+        trial_support = domain.support
+
+    from bempp.api.utils import instrumentation
+
+    with instrumentation.span("singular rule setup"):
+        rule = _SingularQuadratureRuleInterfaceGalerkin(
+            grid, order, test_support, trial_support
+        )
 
     number_of_test_shape_functions = dual_to_range.number_of_shape_functions
     number_of_trial_shape_functions = domain.number_of_shape_functions
 
-    [
-        test_points,
-        trial_points,
-        quad_weights,
-        test_elements,
-        trial_elements,
-        test_offsets,
-        trial_offsets,
-        weights_offsets,
-        number_of_quad_points,
-    ] = rule.get_arrays()
+    instrumentation.count("singular element pairs", rule.index_count["all"])
 
     if is_complex:
         result_type = get_type(precision).complex
@@ -114,7 +126,7 @@ def assemble_singular_part(
     result = _np.zeros(
         number_of_test_shape_functions
         * number_of_trial_shape_functions
-        * len(test_elements),
+        * rule.index_count["all"],
         dtype=result_type,
     )
 
@@ -129,15 +141,7 @@ def assemble_singular_part(
             grid,
             domain,
             dual_to_range,
-            test_points,
-            trial_points,
-            quad_weights,
-            test_elements,
-            trial_elements,
-            test_offsets,
-            trial_offsets,
-            weights_offsets,
-            number_of_quad_points,
+            rule,
             kernel_options,
             result,
         )
@@ -162,32 +166,34 @@ def assemble_singular_part(
     return (i_ind, j_ind, result)
 
 
-_SingularQuadratureRule = _collections.namedtuple(
-    "_QuadratureRule", "test_points trial_points weights"
+# Permutation index of the edge adjacent rules for the shared local
+# vertices (i, j), see duffy_galerkin.EDGE_PERMUTATIONS. The diagonal
+# elements are not needed, so just set to -1.
+_EDGE_PERMUTATION_INDICES = _np.array([[-1, 0, 4], [1, -1, 2], [5, 3, -1]])
+
+_ADJACENCIES = ["coincident", "edge_adjacent", "vertex_adjacent"]
+
+AdjacencyBatch = _collections.namedtuple(
+    "AdjacencyBatch", "adjacency table start end permutations"
 )
 
 
 class _SingularQuadratureRuleInterfaceGalerkin(object):
-    """Interface for a singular quadrature rule."""
+    """
+    Interface for a singular quadrature rule.
+
+    The singular element pairs are ordered by adjacency: first the
+    coincident, then the edge adjacent and finally the vertex adjacent
+    pairs. Each pair has a permutation index into the precomputed table
+    of its adjacency (see duffy_galerkin.tables). For a table with n
+    permutations per side it is n * test_permutation + trial_permutation.
+    """
 
     def __init__(self, grid, order, test_support, trial_support):
         """Initialize singular quadrature rule."""
         self._grid = grid
         self._order = order
-        self._test_indices = None
-        self._trial_indices = None
-
-        self._coincident_rule = _SingularQuadratureRule(
-            *_duffy_galerkin.rule(order, "coincident")
-        )
-
-        self._edge_adjacent_rule = _SingularQuadratureRule(
-            *_duffy_galerkin.rule(order, "edge_adjacent")
-        )
-
-        self._vertex_adjacent_rule = _SingularQuadratureRule(
-            *_duffy_galerkin.rule(order, "vertex_adjacent")
-        )
+        self._tables = _duffy_galerkin.tables(order)
 
         # Iterate through the singular pairs and only add those that are
         # in the support of the space.
@@ -223,25 +229,18 @@ class _SingularQuadratureRuleInterfaceGalerkin(object):
             + self._index_count["vertex_adjacent"]
         )
 
+        self._test_indices, self._trial_indices = self._vectorize_indices()
+        self._permutations = self._vectorize_permutations()
+
     @property
     def order(self):
         """Return the order."""
         return self._order
 
     @property
-    def coincident_rule(self):
-        """Return coincident rule."""
-        return self._coincident_rule
-
-    @property
-    def edge_adjacent_rule(self):
-        """Return edge adjacent rule."""
-        return self._edge_adjacent_rule
-
-    @property
-    def vertex_adjacent_rule(self):
-        """Return vertex adjacent rule."""
-        return self._vertex_adjacent_rule
+    def tables(self):
+        """Return the reference tables for each adjacency."""
+        return self._tables
 
     @property
     def grid(self):
@@ -278,27 +277,69 @@ class _SingularQuadratureRuleInterfaceGalerkin(object):
         """Return the trial indicies of all singular contributions."""
         return self._trial_indices
 
+    @property
+    def permutations(self):
+        """Return the table permutation indices of all singular contributions."""
+        return self._permutations
+
     def number_of_points(self, adjacency):
         """Return the number of quadrature points for given adjacency."""
-        return _duffy_galerkin.number_of_quadrature_points(self.order, adjacency)
+        return self._tables[adjacency].number_of_points
+
+    def adjacency_batches(self):
+        """
+        Return the element pairs grouped by adjacency.
+
+        Returns a list of AdjacencyBatch tuples with the adjacency, its
+        table and the range start:end of its pairs. Adjacencies without
+        pairs are omitted.
+        """
+        batches = []
+        start = 0
+        for adjacency in _ADJACENCIES:
+            end = start + self._index_count[adjacency]
+            if end > start:
+                batches.append(
+                    AdjacencyBatch(
+                        adjacency,
+                        self._tables[adjacency],
+                        start,
+                        end,
+                        self._permutations[start:end],
+                    )
+                )
+            start = end
+        return batches
 
     def get_arrays(self):
-        """Return the arrays."""
-        test_indices, trial_indices = self._vectorize_indices()
-        test_points, trial_points = self._vectorize_points()
-        weights = self._vectorize_weights()
+        """
+        Return the arrays of the concatenated rules.
+
+        The points and weights of all tables are concatenated and each
+        element pair has explicit offsets into them.
+        """
+        test_points = _np.asfortranarray(
+            _np.hstack(
+                [self._tables[adjacency].test_points for adjacency in _ADJACENCIES]
+            )
+        )
+        trial_points = _np.asfortranarray(
+            _np.hstack(
+                [self._tables[adjacency].trial_points for adjacency in _ADJACENCIES]
+            )
+        )
+        weights = _np.hstack(
+            [self._tables[adjacency].weights for adjacency in _ADJACENCIES]
+        )
         test_offsets, trial_offsets, weights_offsets = self._vectorize_offsets()
         number_of_quad_points = self._get_number_of_quad_points()
 
-        self._test_indices = test_indices
-        self._trial_indices = trial_indices
-
         arrays = [
             test_points,
             trial_points,
             weights,
-            test_indices,
-            trial_indices,
+            self._test_indices,
+            self._trial_indices,
             test_offsets,
             trial_offsets,
             weights_offsets,
@@ -307,81 +348,6 @@ class _SingularQuadratureRuleInterfaceGalerkin(object):
 
         return arrays
 
-    def _collect_remapped_quad_points_for_edge_adjacent_rule(self, quad_points):
-        """
-        Remap quad points for edge adjacent quadrature rules.
-
-        Given a 2xN array of quadrature points, return all possible
-        combinations of remapped rules, according to the following
-        order
-        0: edge (index 0, 1)
-        1: edge (index 1, 0)
-        2: edge (index 1, 2)
-        3: edge (index 2, 1)
-        4: edge (index 0, 2)
-        5: edge (index 2, 0)
-        """
-        return _np.hstack(
-            [
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 0, 1),
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 1, 0),
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 1, 2),
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 2, 1),
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 0, 2),
-                _duffy_galerkin.remap_points_shared_edge(quad_points, 2, 0),
-            ]
-        )
-
-    def _collect_remapped_quad_points_for_vertex_adjacent_rule(self, quad_points):
-        """
-        Remap quad points for vertex adjacent quadrature rules.
-
-        Given a 2xN array of quadrature points, return all possible
-        combinations of remapped rules, according to the following
-        order
-        0: vertex (index 0)
-        1: vertex (index 1)
-        2: vertex (index 2)
-        """
-        return _np.hstack(
-            [
-                _duffy_galerkin.remap_points_shared_vertex(quad_points, 0),
-                _duffy_galerkin.remap_points_shared_vertex(quad_points, 1),
-                _duffy_galerkin.remap_points_shared_vertex(quad_points, 2),
-            ]
-        )
-
-    def _compute_edge_offsets(self):
-        """Compute offsets for the edge based rule."""
-        ncoincident = self.number_of_points("coincident")
-        nedge_adjacent = self.number_of_points("edge_adjacent")
-
-        # Offset values is a 3 x 3 matrix such that
-        # the value (i, j) is the offset of the rule
-        # associted with the (i, j) remap case,
-        # where i and j are 0, 1, or 2. The diagonal
-        # elements are not needed, so just set to -1.
-
-        offset_values = _np.array([[-1, 0, 4], [1, -1, 2], [5, 3, -1]])
-
-        edge_offsets = ncoincident + nedge_adjacent * offset_values
-
-        return edge_offsets
-
-    def _compute_vertex_offsets(self):
-        """Compute offsets for the vertex based rules."""
-        ncoincident = self.number_of_points("coincident")
-        nedge_adjacent = self.number_of_points("edge_adjacent")
-        nvertex_adjacent = self.number_of_points("vertex_adjacent")
-
-        vertex_offsets = (
-            ncoincident
-            + 6 * nedge_adjacent
-            + nvertex_adjacent * _np.arange(3, dtype="uint32")
-        )
-
-        return vertex_offsets
-
     def _vectorize_indices(self):
         """Return vector of test and trial indices for sing. integration."""
         test_indices = _np.empty(self.index_count["all"], dtype="uint32")
@@ -401,107 +367,64 @@ class _SingularQuadratureRuleInterfaceGalerkin(object):
 
         return test_indices, trial_indices
 
-    def _get_number_of_quad_points(self):
-        """Compute an array of local numbers of integration points."""
-        number_of_quad_points = _np.empty(self.index_count["all"], dtype="uint32")
-
-        number_of_quad_points[: self.index_count["coincident"]] = self.number_of_points(
-            "coincident"
-        )
-        number_of_quad_points[
-            self.index_count["coincident"] : (
-                self.index_count["coincident"] + self.index_count["edge_adjacent"]
-            )
-        ] = self.number_of_points("edge_adjacent")
-        number_of_quad_points[
-            -self.index_count["vertex_adjacent"] :
-        ] = self.number_of_points("vertex_adjacent")
-
-        return number_of_quad_points
+    def _vectorize_permutations(self):
+        """Return the table permutation index of each element pair."""
+        edge_permutations = self._tables["edge_adjacent"].number_of_permutations
+        vertex_permutations = self._tables["vertex_adjacent"].number_of_permutations
 
-    def _vectorize_points(self):
-        """Return an array of all quadrature points for all different rules."""
-        test_points = _np.hstack(
-            [
-                self.coincident_rule.test_points,
-                self._collect_remapped_quad_points_for_edge_adjacent_rule(
-                    self.edge_adjacent_rule.test_points
-                ),
-                self._collect_remapped_quad_points_for_vertex_adjacent_rule(
-                    self.vertex_adjacent_rule.test_points
-                ),
-            ]
-        )
-
-        trial_points = _np.hstack(
+        return _np.hstack(
             [
-                self.coincident_rule.trial_points,
-                self._collect_remapped_quad_points_for_edge_adjacent_rule(
-                    self.edge_adjacent_rule.trial_points
-                ),
-                self._collect_remapped_quad_points_for_vertex_adjacent_rule(
-                    self.vertex_adjacent_rule.trial_points
-                ),
+                _np.zeros(self.index_count["coincident"], dtype="uint32"),
+                edge_permutations
+                * _EDGE_PERMUTATION_INDICES[
+                    self.edge_adjacency[2, :], self.edge_adjacency[3, :]
+                ]
+                + _EDGE_PERMUTATION_INDICES[
+                    self.edge_adjacency[4, :], self.edge_adjacency[5, :]
+                ],
+                vertex_permutations * self.vertex_adjacency[2, :]
+                + self.vertex_adjacency[3, :],
             ]
-        )
+        ).astype("uint32")
 
-        return test_points, trial_points
-
-    def _vectorize_weights(self):
-        """Vectorize the quadrature weights."""
-        weights = _np.hstack(
-            [
-                self.coincident_rule.weights,
-                self.edge_adjacent_rule.weights,
-                self.vertex_adjacent_rule.weights,
-            ]
+    def _get_number_of_quad_points(self):
+        """Compute an array of local numbers of integration points."""
+        return _np.repeat(
+            _np.array(
+                [self.number_of_points(adjacency) for adjacency in _ADJACENCIES],
+                dtype="uint32",
+            ),
+            [self.index_count[adjacency] for adjacency in _ADJACENCIES],
         )
 
-        return weights
-
     def _vectorize_offsets(self):
-        """Vectorize the offsets."""
-        edge_offsets = self._compute_edge_offsets()
-        vertex_offsets = self._compute_vertex_offsets()
+        """
+        Vectorize the offsets into the concatenated rules.
 
+        The test and trial points of a pair start at the column of its
+        adjacency table in the concatenated points plus the offset of
+        its test and trial permutation in this table.
+        """
         test_offsets = _np.empty(self.index_count["all"], dtype="uint32")
         trial_offsets = _np.empty(self.index_count["all"], dtype="uint32")
         weights_offsets = _np.empty(self.index_count["all"], dtype="uint32")
 
-        test_offsets[: self.index_count["coincident"]] = 0
-
-        test_offsets[
-            self.index_count["coincident"] : (
-                self.index_count["coincident"] + self.index_count["edge_adjacent"]
+        points_offset = 0
+        weights_offset = 0
+        start = 0
+        for adjacency in _ADJACENCIES:
+            table = self._tables[adjacency]
+            end = start + self.index_count[adjacency]
+            permutations = self._permutations[start:end]
+            test_offsets[start:end] = points_offset + table.number_of_points * (
+                permutations // table.number_of_permutations
             )
-        ] = edge_offsets[self.edge_adjacency[2, :], self.edge_adjacency[3, :]]
-
-        test_offsets[
-            (self.index_count["coincident"] + self.index_count["edge_adjacent"]) :
-        ] = vertex_offsets[self.vertex_adjacency[2, :]]
-
-        trial_offsets[: self.index_count["coincident"]] = _np.zeros(
-            self.index_count["coincident"]
-        )
-
-        trial_offsets[
-            self.index_count["coincident"] : (
-                self.index_count["coincident"] + self.index_count["edge_adjacent"]
-            )
-        ] = edge_offsets[self.edge_adjacency[4, :], self.edge_adjacency[5, :]]
-
-        trial_offsets[
-            (self.index_count["coincident"] + self._index_count["edge_adjacent"]) :
-        ] = vertex_offsets[self.vertex_adjacency[3, :]]
-
-        weights_offsets[: self.index_count["coincident"]] = 0
-        weights_offsets[
-            self.index_count["coincident"] : (
-                self.index_count["coincident"] + self.index_count["edge_adjacent"]
+            trial_offsets[start:end] = points_offset + table.number_of_points * (
+                permutations % table.number_of_permutations
             )
-        ] = self.number_of_points("coincident")
-        weights_offsets[-self.index_count["vertex_adjacent"] :] = self.number_of_points(
-            "coincident"
-        ) + self.number_of_points("edge_adjacent")
+            weights_offsets[start:end] = weights_offset
+            points_offset += table.number_of_permutations * table.number_of_points
+            weights_offset += table.number_of_points
+            start = end
 
         return test_offsets, trial_offsets, weights_offsets
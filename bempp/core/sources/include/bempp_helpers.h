@@ -69,6 +69,64 @@ inline void updateNormals(size_t index, __global int *signs, REALTYPE3 *normal)
     *normal *= signs[index];
 }
 
+inline void getCurvedNodes(__global REALTYPE *grid, size_t elementIndex, REALTYPE3 *nodes)
+{
+    /* The six nodes of a curved element are the three corners followed by
+       the nodes on the local edges (0, 1), (2, 0) and (1, 2). */
+
+    for (int i = 0; i < 6; ++i)
+        nodes[i] = (REALTYPE3)(grid[18 * elementIndex + 3 * i],
+                               grid[18 * elementIndex + 3 * i + 1],
+                               grid[18 * elementIndex + 3 * i + 2]);
+}
+
+inline void getCurvedGeometry(REALTYPE3 *nodes, REALTYPE2 *localPoint, REALTYPE3 *globalPoint,
+                              REALTYPE3 *normal, REALTYPE *integrationElement)
+{
+    REALTYPE s = localPoint->x;
+    REALTYPE t = localPoint->y;
+    REALTYPE lam0 = M_ONE - s - t;
+
+    REALTYPE3 jacobian[2];
+
+    *globalPoint = nodes[0] * lam0 * (2 * lam0 - M_ONE) + nodes[1] * s * (2 * s - M_ONE) +
+                   nodes[2] * t * (2 * t - M_ONE) + 4 * (nodes[3] * lam0 * s + nodes[4] * t * lam0 +
+                                                         nodes[5] * s * t);
+
+    jacobian[0] = nodes[0] * (M_ONE - 4 * lam0) + nodes[1] * (4 * s - M_ONE) +
+                  4 * (nodes[3] * (lam0 - s) + (nodes[5] - nodes[4]) * t);
+    jacobian[1] = nodes[0] * (M_ONE - 4 * lam0) + nodes[2] * (4 * t - M_ONE) +
+                  4 * (nodes[4] * (lam0 - t) + (nodes[5] - nodes[3]) * s);
+
+    getNormalAndIntegrationElement(jacobian, normal, integrationElement);
+}
+
+/* Singular kernels assemble PAIRS_PER_GROUP element pairs per work group,
+ * each with ITEMS_PER_PAIR consecutive work items. */
+#ifndef PAIRS_PER_GROUP
+#define PAIRS_PER_GROUP 1
+#endif
+#define ITEMS_PER_PAIR (WORKGROUP_SIZE / PAIRS_PER_GROUP)
+
+/* Tree reduction of the local results of groups of itemsPerPair consecutive
+ * work items, which must be a power of two. The work item localId holds size
+ * values starting at localResult[size * localId]. On return the first work
+ * item of each group holds the sums. Must be called by all work items. */
+inline void reduceLocalResult(__local REALTYPE *localResult, uint size, uint itemsPerPair, size_t localId)
+{
+    uint stride;
+    uint k;
+
+    for (stride = itemsPerPair / 2; stride > 0; stride /= 2)
+    {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if (localId % itemsPerPair < stride)
+            for (k = 0; k < size; ++k)
+                localResult[size * localId + k] += localResult[size * (localId + stride) + k];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
 #ifdef REALTYPEVEC
 
 inline void getElementVec(__global uint *connectivity, size_t *elementIndex, uint element[VEC_LENGTH][3])
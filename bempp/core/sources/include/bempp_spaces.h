@@ -5,7 +5,10 @@
 
 #include "p0_discontinuous_shapeset.h"
 #include "p1_discontinuous_shapeset.h"
+#include "p2_discontinuous_shapeset.h"
+#include "p3_discontinuous_shapeset.h"
 #include "rwg0_shapeset.h"
+#include "rwg1_shapeset.h"
 
 #define BASIS(name, modus) CAT(name, _ ## modus)
 
@@ -1131,5 +1131,74 @@ inline void helmholtz_double_layer_far_field_vec16(const REALTYPE3 testGlobalPoi
 
 }
 
+/* Combined single and double layer kernels for fused potential evaluation.
+   The distance between test and trial point is only computed once and
+   result[0] receives the single layer, result[1] the double layer value.
+*/
+
+inline void laplace_single_and_double_layer_novec(const REALTYPE3 testGlobalPoint, 
+                                                    const REALTYPE3 trialGlobalPoint, 
+                                                    const REALTYPE3 testNormal,
+                                                    const REALTYPE3 trialNormal,
+                                                    __global REALTYPE* kernel_parameters,
+                                                    REALTYPE* result)
+{
+    REALTYPE3 diff = trialGlobalPoint - testGlobalPoint;
+    REALTYPE dist = length(diff);
+
+    result[0] = M_INV_4PI / dist;
+    result[1] = -result[0] * dot(diff, trialNormal) / (dist * dist);
+
+}
+
+inline void modified_helmholtz_real_single_and_double_layer_novec(const REALTYPE3 testGlobalPoint, 
+                                                                    const REALTYPE3 trialGlobalPoint, 
+                                                                    const REALTYPE3 testNormal,
+                                                                    const REALTYPE3 trialNormal,
+                                                                    __global REALTYPE* kernel_parameters,
+                                                                    REALTYPE* result)
+{
+    REALTYPE3 diff = trialGlobalPoint - testGlobalPoint;
+    REALTYPE dist = length(diff);
+
+    REALTYPE inner = dot(diff, trialNormal);
+
+    result[0] = M_INV_4PI * exp(-kernel_parameters[0] * dist) / dist;
+    result[1] = -result[0] / (dist * dist) * (M_ONE + kernel_parameters[0] * dist) * inner;
+
+}
+
+inline void helmholtz_single_and_double_layer_novec(const REALTYPE3 testGlobalPoint, 
+                                                      const REALTYPE3 trialGlobalPoint, 
+                                                      const REALTYPE3 testNormal,
+                                                      const REALTYPE3 trialNormal,
+                                                      __global REALTYPE* kernel_parameters,
+                                                      REALTYPE result[2][2])
+{
+    REALTYPE3 diff = trialGlobalPoint - testGlobalPoint;
+    REALTYPE dist = length(diff);
+
+    REALTYPE inner = dot(diff, trialNormal) / (dist * dist);
+
+    REALTYPE factor[2];
+
+    result[0][0] = M_INV_4PI * cos(kernel_parameters[0] * dist) / dist;
+    result[0][1] = M_INV_4PI * sin(kernel_parameters[0] * dist) / dist;
+
+    factor[0] = -M_ONE;
+    factor[1] = kernel_parameters[0] * dist;
+
+    if (kernel_parameters[1] != M_ZERO) {
+        result[0][0] *= exp(-kernel_parameters[1] * dist);
+        result[0][1] *= exp(-kernel_parameters[1] * dist);
+
+        factor[0] += -kernel_parameters[1] * dist;
+    }
+
+    result[1][0] = (result[0][0] * factor[0] - result[0][1] * factor[1]) * inner;
+    result[1][1] = (result[0][0] * factor[1] + result[0][1] * factor[0]) * inner;
+
+}
+
 #endif
 
@@ -0,0 +1,25 @@
+#ifndef bempp_p2_discontinuous_shapeset_h
+#define bempp_p2_discontinuous_shapeset_h
+
+#include "bempp_base_types.h"
+
+inline void p2_discontinuous_evaluate(const REALTYPE2* localPoint, REALTYPE* result)
+{
+    REALTYPE l0 = M_ONE - localPoint->x - localPoint->y;
+    REALTYPE l1 = localPoint->x;
+    REALTYPE l2 = localPoint->y;
+
+    // Vertex functions
+    result[0] = l0 * (2 * l0 - M_ONE);
+    result[1] = l1 * (2 * l1 - M_ONE);
+    result[2] = l2 * (2 * l2 - M_ONE);
+
+    // Edge functions on the edges (0, 1), (2, 0) and (1, 2)
+    result[3] = 4 * l0 * l1;
+    result[4] = 4 * l2 * l0;
+    result[5] = 4 * l1 * l2;
+
+}
+
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef bempp_p3_discontinuous_shapeset_h
+#define bempp_p3_discontinuous_shapeset_h
+
+#include "bempp_base_types.h"
+
+inline void p3_discontinuous_evaluate(const REALTYPE2* localPoint, REALTYPE* result)
+{
+    REALTYPE l0 = M_ONE - localPoint->x - localPoint->y;
+    REALTYPE l1 = localPoint->x;
+    REALTYPE l2 = localPoint->y;
+
+    // Vertex functions
+    result[0] = ((REALTYPE)0.5) * l0 * (3 * l0 - M_ONE) * (3 * l0 - 2);
+    result[1] = ((REALTYPE)0.5) * l1 * (3 * l1 - M_ONE) * (3 * l1 - 2);
+    result[2] = ((REALTYPE)0.5) * l2 * (3 * l2 - M_ONE) * (3 * l2 - 2);
+
+    // Edge functions on the edges (0, 1), (2, 0) and (1, 2),
+    // ordered from the first to the second vertex of the edge
+    result[3] = ((REALTYPE)4.5) * l0 * l1 * (3 * l0 - M_ONE);
+    result[4] = ((REALTYPE)4.5) * l0 * l1 * (3 * l1 - M_ONE);
+    result[5] = ((REALTYPE)4.5) * l2 * l0 * (3 * l2 - M_ONE);
+    result[6] = ((REALTYPE)4.5) * l2 * l0 * (3 * l0 - M_ONE);
+    result[7] = ((REALTYPE)4.5) * l1 * l2 * (3 * l1 - M_ONE);
+    result[8] = ((REALTYPE)4.5) * l1 * l2 * (3 * l2 - M_ONE);
+
+    // Bubble function
+    result[9] = 27 * l0 * l1 * l2;
+
+}
+
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef bempp_rwg1_shapeset_h
+#define bempp_rwg1_shapeset_h
+
+#include "bempp_base_types.h"
+#include "rwg0_shapeset.h"
+
+inline void rwg1_evaluate(const REALTYPE2* localPoint, REALTYPE* result)
+{
+    REALTYPE l0 = M_ONE - localPoint->x - localPoint->y;
+    REALTYPE l1 = localPoint->x;
+    REALTYPE l2 = localPoint->y;
+
+    // Shape functions 0, 1, 2 are the RWG0 functions
+    rwg0_evaluate(localPoint, result);
+
+    // The hierarchical functions are the differences of the BDM1
+    // functions l_a (v_a - v_c) and l_b (v_b - v_c) of the edge (a, b)
+    // opposite to vertex c.
+
+    // Shape function on edge 0, linear along the edge
+    result[2 * 3 + 0] = -l1;
+    result[2 * 3 + 1] = l1 - l0;
+
+    // Shape function on edge 1, linear along the edge
+    result[2 * 4 + 0] = l0 - l2;
+    result[2 * 4 + 1] = l2;
+
+    // Shape function on edge 2, linear along the edge
+    result[2 * 5 + 0] = l1;
+    result[2 * 5 + 1] = -l2;
+
+}
+
+
+#endif
@@ -0,0 +1,40 @@
+#include "bempp_base_types.h"
+
+/* Sum the element matrix entries belonging to each CSR data entry.
+ *
+ * The entries of the element matrices are sorted by their position in
+ * the CSR data array (see bempp.core.sparse_assembler.CsrPattern), so
+ * that each work item computes one CSR data entry without atomics.
+ */
+__kernel void kernel_function(__global REALTYPE *values,
+                              __global REALTYPE *testMultipliers,
+                              __global REALTYPE *trialMultipliers,
+                              __global ulong *order,
+                              __global ulong *gatherPtr,
+                              __global REALTYPE *data) {
+  size_t position = get_global_id(0);
+  size_t index;
+  size_t entry;
+  size_t elementIndex;
+  size_t testIndex;
+  size_t trialIndex;
+
+  REALTYPE myResult = M_ZERO;
+
+  for (index = gatherPtr[position]; index < gatherPtr[position + 1]; ++index) {
+    entry = order[index];
+    elementIndex = entry / (NUMBER_OF_TEST_SHAPE_FUNCTIONS *
+                            NUMBER_OF_TRIAL_SHAPE_FUNCTIONS);
+    testIndex = (entry / NUMBER_OF_TRIAL_SHAPE_FUNCTIONS) %
+                NUMBER_OF_TEST_SHAPE_FUNCTIONS;
+    trialIndex = entry % NUMBER_OF_TRIAL_SHAPE_FUNCTIONS;
+    myResult +=
+        values[entry] *
+        testMultipliers[elementIndex * NUMBER_OF_TEST_SHAPE_FUNCTIONS +
+                        testIndex] *
+        trialMultipliers[elementIndex * NUMBER_OF_TRIAL_SHAPE_FUNCTIONS +
+                         trialIndex];
+  }
+
+  data[position] = myResult;
+}
@@ -0,0 +1,249 @@
+#include "bempp_base_types.h"
+#include "bempp_helpers.h"
+#include "bempp_spaces.h"
+#include "kernels.h"
+
+/* Singular part of the weighted sum of the Maxwell electric and
+ * magnetic field operators. See
+ * evaluate_dense_combined_field_regular_novec.cl.
+ */
+__kernel void kernel_function(
+    __global REALTYPE *grid, __global int *testNormalSigns,
+    __global int *trialNormalSigns, __global REALTYPE *testPoints,
+    __global REALTYPE *trialPoints, __global REALTYPE *quadWeights,
+    __global uint *testIndices, __global uint *trialIndices,
+    __global uint *permutations,
+    __global REALTYPE *globalResult, __global REALTYPE *kernel_parameters) {
+  /* Variable declarations */
+
+  size_t groupId;
+  size_t localId;
+
+  int i, j, k;
+
+  REALTYPE2 testPoint;
+  REALTYPE2 trialPoint;
+  REALTYPE weight;
+  REALTYPE dist;
+  REALTYPE3 diff;
+
+  REALTYPE3 testGlobalPoint;
+  REALTYPE3 trialGlobalPoint;
+
+  REALTYPE testValue[3][2];
+  REALTYPE trialValue[3][2];
+
+  REALTYPE3 testElementValue[3];
+  REALTYPE3 trialElementValue[3];
+  REALTYPE testEdgeLength[3];
+  REALTYPE trialEdgeLength[3];
+
+  REALTYPE3 testCorners[3];
+  REALTYPE3 trialCorners[3];
+
+  REALTYPE3 testNormal;
+  REALTYPE3 trialNormal;
+
+  REALTYPE3 testJac[2];
+  REALTYPE3 trialJac[2];
+
+  REALTYPE testIntElem;
+  REALTYPE trialIntElem;
+
+  REALTYPE kernelValue[2];
+  REALTYPE gradientFactor[2];
+  REALTYPE tempFactor[2];
+  REALTYPE tempGradient[3][2];
+  REALTYPE shapeIntegralFirstComponent[3][3][2];
+  REALTYPE shapeIntegralSecondComponent[2];
+  REALTYPE shapeIntegralMagnetic[3][3][2];
+  REALTYPE shiftedWavenumber[2] = {M_ZERO, M_ZERO};
+  REALTYPE inverseShiftedWavenumber[2] = {M_ZERO, M_ZERO};
+  REALTYPE divergenceProduct;
+  REALTYPE electricValue[2];
+  REALTYPE magneticValue[2];
+
+  REALTYPE shapeIntegral[3][3][2];
+
+  uint pairLocalId;
+  uint quadStart;
+  uint quadEnd;
+
+  uint localTestOffset;
+  uint localTrialOffset;
+
+  uint testIndex;
+  uint trialIndex;
+
+  __local REALTYPE localResult[WORKGROUP_SIZE][3][3][2];
+
+  // groupId is the index of the element pair of this work item.
+  localId = get_local_id(0);
+  groupId = PAIRS_PER_GROUP * get_group_id(0) + localId / ITEMS_PER_PAIR;
+  pairLocalId = localId % ITEMS_PER_PAIR;
+
+  // Rules of a single adjacency. permutations holds the permutation index
+  // NUMBER_OF_PERMUTATIONS * testPermutation + trialPermutation of the
+  // pair into the tables of this adjacency.
+  // Evenly sized chunks of the quadrature points for each work item.
+  quadStart = NUMBER_OF_QUAD_POINTS * pairLocalId / ITEMS_PER_PAIR;
+  quadEnd = NUMBER_OF_QUAD_POINTS * (pairLocalId + 1) / ITEMS_PER_PAIR;
+  localTestOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] / NUMBER_OF_PERMUTATIONS);
+  localTrialOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] % NUMBER_OF_PERMUTATIONS);
+  testIndex = testIndices[groupId];
+  trialIndex = trialIndices[groupId];
+
+  getCorners(grid, testIndex, testCorners);
+  getCorners(grid, trialIndex, trialCorners);
+
+  getJacobian(testCorners, testJac);
+  getJacobian(trialCorners, trialJac);
+
+  getNormalAndIntegrationElement(testJac, &testNormal, &testIntElem);
+  getNormalAndIntegrationElement(trialJac, &trialNormal, &trialIntElem);
+
+  computeEdgeLength(testCorners, testEdgeLength);
+  computeEdgeLength(trialCorners, trialEdgeLength);
+
+  updateNormals(testIndex, testNormalSigns, &testNormal);
+  updateNormals(trialIndex, trialNormalSigns, &trialNormal);
+
+  // Computation of 1i * wavenumber and 1 / (1i * wavenumber)
+  shiftedWavenumber[0] = -kernel_parameters[1];
+  shiftedWavenumber[1] = kernel_parameters[0];
+
+  inverseShiftedWavenumber[0] = M_ONE /
+                                (shiftedWavenumber[0] * shiftedWavenumber[0] +
+                                 shiftedWavenumber[1] * shiftedWavenumber[1]) *
+                                shiftedWavenumber[0];
+  inverseShiftedWavenumber[1] = -M_ONE /
+                                (shiftedWavenumber[0] * shiftedWavenumber[0] +
+                                 shiftedWavenumber[1] * shiftedWavenumber[1]) *
+                                shiftedWavenumber[1];
+
+  for (i = 0; i < 3; ++i)
+    for (j = 0; j < 3; ++j)
+      for (k = 0; k < 2; ++k) {
+        shapeIntegralFirstComponent[i][j][k] = M_ZERO;
+        shapeIntegralMagnetic[i][j][k] = M_ZERO;
+      }
+  shapeIntegralSecondComponent[0] = M_ZERO;
+  shapeIntegralSecondComponent[1] = M_ZERO;
+
+  for (uint quadIndex = quadStart; quadIndex < quadEnd; ++quadIndex) {
+    testPoint = (REALTYPE2)(testPoints[2 * (localTestOffset + quadIndex)],
+                            testPoints[2 * (localTestOffset + quadIndex) + 1]);
+    trialPoint =
+        (REALTYPE2)(trialPoints[2 * (localTrialOffset + quadIndex)],
+                    trialPoints[2 * (localTrialOffset + quadIndex) + 1]);
+    weight = quadWeights[quadIndex];
+    BASIS(TEST, evaluate)(&testPoint, &testValue[0][0]);
+    BASIS(TRIAL, evaluate)(&trialPoint, &trialValue[0][0]);
+    getPiolaTransform(testIntElem, testJac, testValue, testElementValue);
+    getPiolaTransform(trialIntElem, trialJac, trialValue, trialElementValue);
+
+    testGlobalPoint = getGlobalPoint(testCorners, &testPoint);
+    trialGlobalPoint = getGlobalPoint(trialCorners, &trialPoint);
+
+    // Green's function exp(ikr) / (4 pi r)
+    diff = trialGlobalPoint - testGlobalPoint;
+    dist = length(diff);
+    kernelValue[0] = M_INV_4PI * cos(kernel_parameters[0] * dist) / dist;
+    kernelValue[1] = M_INV_4PI * sin(kernel_parameters[0] * dist) / dist;
+    if (kernel_parameters[1] != M_ZERO) {
+      kernelValue[0] *= exp(-kernel_parameters[1] * dist);
+      kernelValue[1] *= exp(-kernel_parameters[1] * dist);
+    }
+
+    tempFactor[0] = kernelValue[0] * weight;
+    tempFactor[1] = kernelValue[1] * weight;
+
+    // Gradient with respect to the test point.
+    gradientFactor[0] = (M_ONE + kernel_parameters[1] * dist) / (dist * dist);
+    gradientFactor[1] = -kernel_parameters[0] * dist / (dist * dist);
+
+    for (k = 0; k < 3; ++k) {
+      tempGradient[k][0] = (tempFactor[0] * gradientFactor[0] -
+                            tempFactor[1] * gradientFactor[1]) *
+                           VEC_ELEMENT(diff, k);
+      tempGradient[k][1] = (tempFactor[0] * gradientFactor[1] +
+                            tempFactor[1] * gradientFactor[0]) *
+                           VEC_ELEMENT(diff, k);
+    }
+
+    for (i = 0; i < 3; ++i)
+      for (j = 0; j < 3; ++j)
+        for (k = 0; k < 2; ++k) {
+          shapeIntegralFirstComponent[i][j][k] +=
+              tempFactor[k] * dot(testElementValue[i], trialElementValue[j]);
+          shapeIntegralMagnetic[i][j][k] -=
+              testElementValue[i].x *
+                  (tempGradient[1][k] * trialElementValue[j].z -
+                   tempGradient[2][k] * trialElementValue[j].y) +
+              testElementValue[i].y *
+                  (tempGradient[2][k] * trialElementValue[j].x -
+                   tempGradient[0][k] * trialElementValue[j].z) +
+              testElementValue[i].z *
+                  (tempGradient[0][k] * trialElementValue[j].y -
+                   tempGradient[1][k] * trialElementValue[j].x);
+        }
+    shapeIntegralSecondComponent[0] += tempFactor[0];
+    shapeIntegralSecondComponent[1] += tempFactor[1];
+  }
+
+  divergenceProduct = M_TWO * M_TWO / testIntElem / trialIntElem;
+
+  for (i = 0; i < 3; ++i)
+    for (j = 0; j < 3; ++j) {
+      electricValue[0] =
+          -(shiftedWavenumber[0] * shapeIntegralFirstComponent[i][j][0] -
+            shiftedWavenumber[1] * shapeIntegralFirstComponent[i][j][1]);
+      electricValue[1] =
+          -(shiftedWavenumber[0] * shapeIntegralFirstComponent[i][j][1] +
+            shiftedWavenumber[1] * shapeIntegralFirstComponent[i][j][0]);
+      electricValue[0] -=
+          divergenceProduct *
+          (inverseShiftedWavenumber[0] * shapeIntegralSecondComponent[0] -
+           inverseShiftedWavenumber[1] * shapeIntegralSecondComponent[1]);
+      electricValue[1] -=
+          divergenceProduct *
+          (inverseShiftedWavenumber[0] * shapeIntegralSecondComponent[1] +
+           inverseShiftedWavenumber[1] * shapeIntegralSecondComponent[0]);
+      magneticValue[0] = shapeIntegralMagnetic[i][j][0];
+      magneticValue[1] = shapeIntegralMagnetic[i][j][1];
+
+      shapeIntegral[i][j][0] = kernel_parameters[2] * electricValue[0] -
+                               kernel_parameters[3] * electricValue[1] +
+                               kernel_parameters[4] * magneticValue[0] -
+                               kernel_parameters[5] * magneticValue[1];
+      shapeIntegral[i][j][1] = kernel_parameters[2] * electricValue[1] +
+                               kernel_parameters[3] * electricValue[0] +
+                               kernel_parameters[4] * magneticValue[1] +
+                               kernel_parameters[5] * magneticValue[0];
+    }
+
+  for (i = 0; i < 3; ++i)
+    for (j = 0; j < 3; ++j) {
+      localResult[localId][i][j][0] = shapeIntegral[i][j][0] * testIntElem *
+                                      trialIntElem * testEdgeLength[i] *
+                                      trialEdgeLength[j];
+      localResult[localId][i][j][1] = shapeIntegral[i][j][1] * testIntElem *
+                                      trialIntElem * testEdgeLength[i] *
+                                      trialEdgeLength[j];
+    }
+
+  reduceLocalResult((__local REALTYPE *)localResult,
+                    sizeof(localResult[0]) / sizeof(REALTYPE), ITEMS_PER_PAIR,
+                    localId);
+
+  if (pairLocalId == 0) {
+    for (i = 0; i < 3; ++i)
+      for (j = 0; j < 3; ++j) {
+        globalResult[2 * (9 * groupId + i * 3 + j)] = localResult[localId][i][j][0];
+        globalResult[2 * (9 * groupId + i * 3 + j) + 1] =
+            localResult[localId][i][j][1];
+      }
+  }
+}
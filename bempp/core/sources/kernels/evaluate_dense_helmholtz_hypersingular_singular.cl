@@ -9,8 +9,7 @@ __kernel void kernel_function(
     __global REALTYPE *testPoints,
     __global REALTYPE *trialPoints, __global REALTYPE *quadWeights,
     __global uint *testIndices, __global uint *trialIndices,
-    __global uint *testOffsets, __global uint *trialOffsets,
-    __global uint *weightOffsets, __global uint *numberOfLocalQuadPoints,
+    __global uint *permutations,
     __global REALTYPE *globalResult,
     __global REALTYPE* kernel_parameters){
   /* Variable declarations */
@@ -18,7 +17,7 @@ __kernel void kernel_function(
   size_t groupId;
   size_t localId;
 
-  int i, j, m;
+  int i, j;
 
   REALTYPE2 testPoint;
   REALTYPE2 trialPoint;
@@ -43,11 +42,12 @@ __kernel void kernel_function(
   REALTYPE testIntElem;
   REALTYPE trialIntElem;
 
-  uint localQuadPointsPerItem;
+  uint pairLocalId;
+  uint quadStart;
+  uint quadEnd;
 
   uint localTestOffset;
   uint localTrialOffset;
-  uint localWeightsOffset;
 
   uint testIndex;
   uint trialIndex;
@@ -78,13 +78,21 @@ __kernel void kernel_function(
   REALTYPE wavenumberProduct[2];
 #endif
 
-  groupId = get_group_id(0);
+  // groupId is the index of the element pair of this work item.
   localId = get_local_id(0);
-
-  localQuadPointsPerItem = numberOfLocalQuadPoints[groupId];
-  localTestOffset = testOffsets[groupId];
-  localTrialOffset = trialOffsets[groupId];
-  localWeightsOffset = weightOffsets[groupId];
+  groupId = PAIRS_PER_GROUP * get_group_id(0) + localId / ITEMS_PER_PAIR;
+  pairLocalId = localId % ITEMS_PER_PAIR;
+
+  // Rules of a single adjacency. permutations holds the permutation index
+  // NUMBER_OF_PERMUTATIONS * testPermutation + trialPermutation of the
+  // pair into the tables of this adjacency.
+  // Evenly sized chunks of the quadrature points for each work item.
+  quadStart = NUMBER_OF_QUAD_POINTS * pairLocalId / ITEMS_PER_PAIR;
+  quadEnd = NUMBER_OF_QUAD_POINTS * (pairLocalId + 1) / ITEMS_PER_PAIR;
+  localTestOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] / NUMBER_OF_PERMUTATIONS);
+  localTrialOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] % NUMBER_OF_PERMUTATIONS);
   testIndex = testIndices[groupId];
   trialIndex = trialIndices[groupId];
 
@@ -154,11 +162,10 @@ __kernel void kernel_function(
 
   normalProduct = dot(testNormal, trialNormal);
 
-  for (uint quadIndex = localQuadPointsPerItem * localId;
-       quadIndex < localQuadPointsPerItem * (localId + 1); ++quadIndex) {
+  for (uint quadIndex = quadStart; quadIndex < quadEnd; ++quadIndex) {
     testPoint = (REALTYPE2)(testPoints[2 * (localTestOffset + quadIndex)], testPoints[2 * (localTestOffset + quadIndex) + 1]);
     trialPoint = (REALTYPE2)(trialPoints[2 * (localTrialOffset + quadIndex)], trialPoints[2 * (localTrialOffset + quadIndex) + 1]);
-    weight = quadWeights[localWeightsOffset + quadIndex];
+    weight = quadWeights[quadIndex];
     BASIS(TEST, evaluate)(&testPoint, &testValue[0]);
     BASIS(TRIAL, evaluate)(&trialPoint, &trialValue[0]);
 
@@ -216,31 +223,27 @@ __kernel void kernel_function(
 #endif
     }
 
-  barrier(CLK_LOCAL_MEM_FENCE);
+  reduceLocalResult((__local REALTYPE *)localResult,
+                    sizeof(localResult[0]) / sizeof(REALTYPE), ITEMS_PER_PAIR,
+                    localId);
 
-  if (localId == 0) {
+  if (pairLocalId == 0) {
     for (i = 0; i < NUMBER_OF_TEST_SHAPE_FUNCTIONS; ++i)
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
 #ifndef COMPLEX_KERNEL
-        for (m = 1; m < WORKGROUP_SIZE; ++m)
-          localResult[0][i][j] += localResult[m][i][j];
         globalResult[NUMBER_OF_TEST_SHAPE_FUNCTIONS *
                          NUMBER_OF_TRIAL_SHAPE_FUNCTIONS * groupId +
                      i * NUMBER_OF_TRIAL_SHAPE_FUNCTIONS + j] =
-            localResult[0][i][j];
+            localResult[localId][i][j];
 #else
-        for (m = 1; m < WORKGROUP_SIZE; ++m) {
-          localResult[0][i][j][0] += localResult[m][i][j][0];
-          localResult[0][i][j][1] += localResult[m][i][j][1];
-        }
         globalResult[2 * (NUMBER_OF_TEST_SHAPE_FUNCTIONS *
                               NUMBER_OF_TRIAL_SHAPE_FUNCTIONS * groupId +
                           i * NUMBER_OF_TRIAL_SHAPE_FUNCTIONS + j)] =
-            localResult[0][i][j][0];
+            localResult[localId][i][j][0];
         globalResult[2 * (NUMBER_OF_TEST_SHAPE_FUNCTIONS *
                               NUMBER_OF_TRIAL_SHAPE_FUNCTIONS * groupId +
                           i * NUMBER_OF_TRIAL_SHAPE_FUNCTIONS + j) +
-                     1] = localResult[0][i][j][1];
+                     1] = localResult[localId][i][j][1];
 #endif
       }
   }
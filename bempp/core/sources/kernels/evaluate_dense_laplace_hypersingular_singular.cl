@@ -9,8 +9,7 @@ __kernel void kernel_function(
     __global REALTYPE *testPoints,
     __global REALTYPE *trialPoints, __global REALTYPE *quadWeights,
     __global uint *testIndices, __global uint *trialIndices,
-    __global uint *testOffsets, __global uint *trialOffsets,
-    __global uint *weightOffsets, __global uint *numberOfLocalQuadPoints,
+    __global uint *permutations,
     __global REALTYPE *globalResult,
     __global REALTYPE *kernel_parameters) {
   /* Variable declarations */
@@ -18,7 +17,7 @@ __kernel void kernel_function(
   size_t groupId;
   size_t localId;
 
-  int i, j, m;
+  int i, j;
 
   REALTYPE2 testPoint;
   REALTYPE2 trialPoint;
@@ -51,11 +50,12 @@ __kernel void kernel_function(
 
   REALTYPE basisProduct[3][3];
 
-  uint localQuadPointsPerItem;
+  uint pairLocalId;
+  uint quadStart;
+  uint quadEnd;
 
   uint localTestOffset;
   uint localTrialOffset;
-  uint localWeightsOffset;
 
   uint testIndex;
   uint trialIndex;
@@ -64,13 +64,21 @@ __kernel void kernel_function(
   REALTYPE result;
   REALTYPE kernelValue;
 
-  groupId = get_group_id(0);
+  // groupId is the index of the element pair of this work item.
   localId = get_local_id(0);
-
-  localQuadPointsPerItem = numberOfLocalQuadPoints[groupId];
-  localTestOffset = testOffsets[groupId];
-  localTrialOffset = trialOffsets[groupId];
-  localWeightsOffset = weightOffsets[groupId];
+  groupId = PAIRS_PER_GROUP * get_group_id(0) + localId / ITEMS_PER_PAIR;
+  pairLocalId = localId % ITEMS_PER_PAIR;
+
+  // Rules of a single adjacency. permutations holds the permutation index
+  // NUMBER_OF_PERMUTATIONS * testPermutation + trialPermutation of the
+  // pair into the tables of this adjacency.
+  // Evenly sized chunks of the quadrature points for each work item.
+  quadStart = NUMBER_OF_QUAD_POINTS * pairLocalId / ITEMS_PER_PAIR;
+  quadEnd = NUMBER_OF_QUAD_POINTS * (pairLocalId + 1) / ITEMS_PER_PAIR;
+  localTestOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] / NUMBER_OF_PERMUTATIONS);
+  localTrialOffset =
+      NUMBER_OF_QUAD_POINTS * (permutations[groupId] % NUMBER_OF_PERMUTATIONS);
   testIndex = testIndices[groupId];
   trialIndex = trialIndices[groupId];
 
@@ -117,11 +125,10 @@ __kernel void kernel_function(
 
   result = M_ZERO;
 
-  for (uint quadIndex = localQuadPointsPerItem * localId;
-       quadIndex < localQuadPointsPerItem * (localId + 1); ++quadIndex) {
+  for (uint quadIndex = quadStart; quadIndex < quadEnd; ++quadIndex) {
     testPoint = (REALTYPE2)(testPoints[2 * (localTestOffset + quadIndex)], testPoints[2 * (localTestOffset + quadIndex) + 1]);
     trialPoint = (REALTYPE2)(trialPoints[2 * (localTrialOffset + quadIndex)], trialPoints[2 * (localTrialOffset + quadIndex) + 1]);
-    weight = quadWeights[localWeightsOffset + quadIndex];
+    weight = quadWeights[quadIndex];
 
     testGlobalPoint = getGlobalPoint(testCorners, &testPoint);
     trialGlobalPoint = getGlobalPoint(trialCorners, &trialPoint);
@@ -138,16 +145,17 @@ __kernel void kernel_function(
 
   localResult[localId] = result / (testIntElem * trialIntElem);
 
-  barrier(CLK_LOCAL_MEM_FENCE);
+  reduceLocalResult((__local REALTYPE *)localResult,
+                    sizeof(localResult[0]) / sizeof(REALTYPE), ITEMS_PER_PAIR,
+                    localId);
 
-  if (localId == 0) {
-    for (m = 1; m < WORKGROUP_SIZE; ++m) localResult[0] += localResult[m];
+  if (pairLocalId == 0) {
     for (i = 0; i < NUMBER_OF_TEST_SHAPE_FUNCTIONS; ++i)
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
         globalResult[NUMBER_OF_TEST_SHAPE_FUNCTIONS *
                          NUMBER_OF_TRIAL_SHAPE_FUNCTIONS * groupId +
                      i * NUMBER_OF_TRIAL_SHAPE_FUNCTIONS + j] =
-            localResult[0] * basisProduct[i][j];
+            localResult[localId] * basisProduct[i][j];
       }
   }
 }
@@ -31,8 +31,14 @@ __kernel void kernel_function(
   REALTYPE3 testGlobalPoint;
   REALTYPE3 trialGlobalPoint;
 
+#ifndef CURVED_GRID
   REALTYPE3 testCorners[3];
   REALTYPE3 trialCorners[3];
+#else
+  REALTYPE3 testNodes[6];
+  REALTYPE3 trialNodes[6];
+  REALTYPE testWeight;
+#endif
 
   uint testElement[3];
   uint trialElement[3];
@@ -81,8 +87,13 @@ __kernel void kernel_function(
 #endif
     }
 
+#ifndef CURVED_GRID
   getCorners(testGrid, testIndex, testCorners);
   getCorners(trialGrid, trialIndex, trialCorners);
+#else
+  getCurvedNodes(testGrid, testIndex, testNodes);
+  getCurvedNodes(trialGrid, trialIndex, trialNodes);
+#endif
 
   getElement(testConnectivity, testIndex, testElement);
   getElement(trialConnectivity, trialIndex, trialElement);
@@ -97,6 +108,7 @@ __kernel void kernel_function(
   getLocalMultipliers(trialLocalMultipliers, trialIndex,
                       myTrialLocalMultipliers, NUMBER_OF_TRIAL_SHAPE_FUNCTIONS);
 
+#ifndef CURVED_GRID
   getJacobian(testCorners, testJac);
   getJacobian(trialCorners, trialJac);
 
@@ -105,11 +117,20 @@ __kernel void kernel_function(
 
   updateNormals(testIndex, testNormalSigns, &testNormal);
   updateNormals(trialIndex, trialNormalSigns, &trialNormal);
+#endif
 
   for (testQuadIndex = 0; testQuadIndex < NUMBER_OF_QUAD_POINTS;
        ++testQuadIndex) {
     testPoint = (REALTYPE2)(quadPoints[2 * testQuadIndex], quadPoints[2 * testQuadIndex + 1]);
+#ifndef CURVED_GRID
     testGlobalPoint = getGlobalPoint(testCorners, &testPoint);
+#else
+    /* Geometry of curved elements varies over the quadrature points. */
+    getCurvedGeometry(testNodes, &testPoint, &testGlobalPoint, &testNormal,
+                      &testIntElem);
+    updateNormals(testIndex, testNormalSigns, &testNormal);
+    testWeight = quadWeights[testQuadIndex] * testIntElem;
+#endif
     BASIS(TEST, evaluate)(&testPoint, &testValue[0]);
 
     for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
@@ -124,13 +145,22 @@ __kernel void kernel_function(
     for (trialQuadIndex = 0; trialQuadIndex < NUMBER_OF_QUAD_POINTS;
          ++trialQuadIndex) {
       trialPoint = (REALTYPE2)(quadPoints[2 * trialQuadIndex], quadPoints[2 * trialQuadIndex + 1]);
+#ifndef CURVED_GRID
       trialGlobalPoint = getGlobalPoint(trialCorners, &trialPoint);
+#else
+      getCurvedGeometry(trialNodes, &trialPoint, &trialGlobalPoint,
+                        &trialNormal, &trialIntElem);
+      updateNormals(trialIndex, trialNormalSigns, &trialNormal);
+#endif
       BASIS(TRIAL, evaluate)(&trialPoint, &trialValue[0]);
 #ifndef COMPLEX_KERNEL
       KERNEL(novec)
       (testGlobalPoint, trialGlobalPoint, testNormal, trialNormal, kernel_parameters,
        &kernelValue);
       tempFactor = quadWeights[trialQuadIndex] * kernelValue;
+#ifdef CURVED_GRID
+      tempFactor *= trialIntElem;
+#endif
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j)
         tempResult[j] += trialValue[j] * tempFactor;
 #else
@@ -138,6 +168,10 @@ __kernel void kernel_function(
       (testGlobalPoint, trialGlobalPoint, testNormal, trialNormal, kernel_parameters, kernelValue);
       tempFactor[0] = quadWeights[trialQuadIndex] * kernelValue[0];
       tempFactor[1] = quadWeights[trialQuadIndex] * kernelValue[1];
+#ifdef CURVED_GRID
+      tempFactor[0] *= trialIntElem;
+      tempFactor[1] *= trialIntElem;
+#endif
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
         tempResult[j][0] += trialValue[j] * tempFactor[0];
         tempResult[j][1] += trialValue[j] * tempFactor[1];
@@ -146,6 +180,7 @@ __kernel void kernel_function(
 #endif
     }
 
+#ifndef CURVED_GRID
     for (i = 0; i < NUMBER_OF_TEST_SHAPE_FUNCTIONS; ++i)
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
 #ifndef COMPLEX_KERNEL
@@ -158,8 +193,25 @@ __kernel void kernel_function(
             tempResult[j][1] * quadWeights[testQuadIndex] * testValue[i];
 #endif
       }
+#else
+    for (i = 0; i < NUMBER_OF_TEST_SHAPE_FUNCTIONS; ++i)
+      for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
+#ifndef COMPLEX_KERNEL
+        shapeIntegral[i][j] += tempResult[j] * testWeight * testValue[i];
+#else
+        shapeIntegral[i][j][0] += tempResult[j][0] * testWeight * testValue[i];
+        shapeIntegral[i][j][1] += tempResult[j][1] * testWeight * testValue[i];
+#endif
+      }
+#endif
   }
 
+#ifdef CURVED_GRID
+  /* The integration elements are already contained in the shape integrals. */
+  testIntElem = M_ONE;
+  trialIntElem = M_ONE;
+#endif
+
   if (!elementsAreAdjacent(testElement, trialElement, gridsAreDisjoint)) {
     for (i = 0; i < NUMBER_OF_TEST_SHAPE_FUNCTIONS; ++i)
       for (j = 0; j < NUMBER_OF_TRIAL_SHAPE_FUNCTIONS; ++j) {
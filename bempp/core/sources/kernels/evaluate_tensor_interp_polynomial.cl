@@ -0,0 +1,85 @@
+#include "bempp_base_types.h"
+
+/* Evaluate a 3d tensor Chebychev interpolant at a set of points.
+ *
+ * Each work item computes the barycentric 1d basis values of one
+ * point in each dimension and contracts the tensor of values one
+ * dimension at a time, starting with the inner most (z) dimension.
+ * Complex values are stored as interleaved real and imaginary parts.
+ */
+__kernel void kernel_function(__constant REALTYPE *nodes,
+                              __constant REALTYPE *weights,
+                              __global REALTYPE *values,
+                              __global REALTYPE *points,
+                              __global REALTYPE *result) {
+  size_t gid = get_global_id(0);
+
+  REALTYPE basis[3][NUMBER_OF_NODES];
+  REALTYPE denominator;
+  REALTYPE xdiff;
+  int exactIndex;
+  int dim, i, j, k;
+  size_t offset;
+
+#ifndef COMPLEX_VALUES
+  REALTYPE partialY, partialZ;
+  REALTYPE myResult = M_ZERO;
+#else
+  REALTYPE partialY[2], partialZ[2];
+  REALTYPE myResult[2] = {M_ZERO, M_ZERO};
+#endif
+
+  for (dim = 0; dim < 3; ++dim) {
+    exactIndex = -1;
+    denominator = M_ZERO;
+    for (i = 0; i < NUMBER_OF_NODES; ++i) {
+      xdiff = points[3 * gid + dim] - nodes[i];
+      if (xdiff == M_ZERO) exactIndex = i;
+      basis[dim][i] = weights[i] / xdiff;
+      denominator += basis[dim][i];
+    }
+    for (i = 0; i < NUMBER_OF_NODES; ++i)
+      basis[dim][i] = (exactIndex < 0) ? basis[dim][i] / denominator
+                                       : (REALTYPE)(i == exactIndex);
+  }
+
+  for (i = 0; i < NUMBER_OF_NODES; ++i) {
+#ifndef COMPLEX_VALUES
+    partialY = M_ZERO;
+#else
+    partialY[0] = M_ZERO;
+    partialY[1] = M_ZERO;
+#endif
+    for (j = 0; j < NUMBER_OF_NODES; ++j) {
+      offset = (i * NUMBER_OF_NODES + j) * NUMBER_OF_NODES;
+#ifndef COMPLEX_VALUES
+      partialZ = M_ZERO;
+      for (k = 0; k < NUMBER_OF_NODES; ++k)
+        partialZ += basis[2][k] * values[offset + k];
+      partialY += basis[1][j] * partialZ;
+#else
+      partialZ[0] = M_ZERO;
+      partialZ[1] = M_ZERO;
+      for (k = 0; k < NUMBER_OF_NODES; ++k) {
+        partialZ[0] += basis[2][k] * values[2 * (offset + k)];
+        partialZ[1] += basis[2][k] * values[2 * (offset + k) + 1];
+      }
+      partialY[0] += basis[1][j] * partialZ[0];
+      partialY[1] += basis[1][j] * partialZ[1];
+#endif
+    }
+#ifndef COMPLEX_VALUES
+    myResult += basis[0][i] * partialY;
+#else
+    myResult[0] += basis[0][i] * partialY[0];
+    myResult[1] += basis[0][i] * partialY[1];
+#endif
+  }
+
+#ifndef COMPLEX_VALUES
+  result[gid] = myResult;
+#else
+  result[2 * gid] = myResult[0];
+  result[2 * gid + 1] = myResult[1];
+#endif
+}
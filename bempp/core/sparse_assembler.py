@@ -1,5 +1,6 @@
 """Sparse assembly."""
 
+import numba as _numba
 import numpy as _np
 
 from bempp.api.assembly import assembler as _assembler
@@ -7,7 +8,13 @@ from bempp.helpers import timeit as _timeit
 
 
 class SparseAssembler(_assembler.AssemblerBase):
-    """Implementation of a sparse assembler."""
+    """
+    Implementation of a sparse assembler.
+
+    Sparse operators are assembled with the device interface in
+    parameters.assembly.sparse.device_interface (default 'numba'),
+    independent of the device interface of the operator.
+    """
 
     # pylint: disable=useless-super-delegation
     def __init__(self, domain, dual_to_range, parameters=None):
@@ -20,8 +27,7 @@ class SparseAssembler(_assembler.AssemblerBase):
         """Sparse assembly of operators."""
         from bempp.api.utils.helpers import promote_to_double_precision
         from bempp.api.space.space import return_compatible_representation
-        from .numba_kernels import select_numba_kernels
-        from scipy.sparse import coo_matrix
+        from scipy.sparse import csr_matrix
         from bempp.api.assembly.discrete_boundary_operator import (
             SparseDiscreteBoundaryOperator,
         )
@@ -37,34 +43,26 @@ class SparseAssembler(_assembler.AssemblerBase):
                 "For sparse operators the domain and dual_to_range grids must be identical."
             )
 
-        trial_local2global = domain.local2global.ravel()
-        test_local2global = dual_to_range.local2global.ravel()
-        trial_multipliers = domain.local_multipliers.ravel()
-        test_multipliers = dual_to_range.local_multipliers.ravel()
-
-        numba_assembly_function, numba_kernel_function = select_numba_kernels(
-            operator_descriptor, mode="sparse"
-        )
+        elements = _support_elements(domain, dual_to_range)
+        pattern = CsrPattern(domain, dual_to_range, elements)
 
-        rows, cols, values = assemble_sparse(
+        data = assemble_sparse_csr(
             domain.localised_space,
             dual_to_range.localised_space,
             self.parameters,
             operator_descriptor,
-            numba_assembly_function,
-            numba_kernel_function,
+            self.parameters.assembly.sparse.device_interface,
+            elements,
+            pattern,
         )
-        global_rows = test_local2global[rows]
-        global_cols = trial_local2global[cols]
-        global_values = values * trial_multipliers[cols] * test_multipliers[rows]
 
         if self.parameters.assembly.always_promote_to_double:
-            values = promote_to_double_precision(values)
+            data = promote_to_double_precision(data)
 
-        mat = coo_matrix(
-            (global_values, (global_rows, global_cols)),
+        mat = csr_matrix(
+            (data, pattern.indices, pattern.indptr),
             shape=(row_grid_dofs, col_grid_dofs),
-        ).tocsr()
+        )
 
         if domain.requires_dof_transformation:
             mat = mat @ domain.dof_transformation
@@ -74,35 +72,89 @@ class SparseAssembler(_assembler.AssemblerBase):
 
         return SparseDiscreteBoundaryOperator(mat)
 
+    def result_type(self, operator_descriptor, precision):
+        """Return the dtype of the assembled weak form."""
+        # Sparse operators are always assembled in double precision.
+        if operator_descriptor.is_complex:
+            return _np.dtype("complex128")
+        return _np.dtype("float64")
+
+    def accumulate(
+        self, operator_descriptor, device_interface, precision, result, alpha
+    ):
+        """Add alpha times the weak form to the dense array result in place."""
+        mat = self.assemble(
+            operator_descriptor, device_interface, precision
+        ).to_sparse()
+        mat = mat.tocoo()
+        _np.add.at(result, (mat.row, mat.col), alpha * mat.data)
+
+
+class CsrPattern(object):
+    """
+    Sparsity pattern of an operator with elementwise local contributions.
+
+    The pattern is computed from the local2global maps of the two spaces.
+    For each entry of the element matrices it stores the position in the
+    CSR data array into which the entry is summed. Element matrices from
+    any assembler (Numba or OpenCL) can then be scattered directly into
+    the CSR data without forming coordinate triplets.
+    """
+
+    def __init__(self, domain, dual_to_range, elements):
+        """Compute the CSR pattern for the given support elements."""
+        test_dofs = dual_to_range.local2global[elements]
+        trial_dofs = domain.local2global[elements]
+
+        (
+            self.indptr,
+            self.indices,
+            self.order,
+            self.gather_ptr,
+        ) = _csr_pattern(test_dofs, trial_dofs, dual_to_range.grid_dof_count)
+
+        self.test_multipliers = dual_to_range.local_multipliers[elements]
+        self.trial_multipliers = domain.local_multipliers[elements]
+
+        if len(self.indices) < _np.iinfo(_np.int32).max:
+            self.indptr = self.indptr.astype(_np.int32)
+            self.indices = self.indices.astype(_np.int32)
+
+    def scatter(self, values):
+        """Sum element matrix entries into a CSR data array."""
+        data = _np.zeros(len(self.indices), dtype=values.dtype)
+        _csr_gather(
+            values,
+            self.test_multipliers,
+            self.trial_multipliers,
+            self.order,
+            self.gather_ptr,
+            data,
+        )
+        return data
+
 
 @_timeit
-def assemble_sparse(
+def assemble_sparse_csr(
     domain,
     dual_to_range,
     parameters,
     operator_descriptor,
-    numba_assembly_function,
-    numba_kernel_function,
+    device_interface,
+    elements,
+    pattern,
 ):
-    """Actually assemble the operator."""
+    """
+    Assemble the CSR data array of a sparse operator.
+
+    With OpenCL the element matrices are summed into the CSR data on the
+    device, so that only the CSR data is transferred back to the host.
+    """
     import bempp.api
-    from bempp.api.integration.triangle_gauss import rule as regular_rule
     from bempp.api.utils.helpers import get_type
-
-    order = parameters.quadrature.regular
-    quad_points, quad_weights = regular_rule(order)
-
-    support = domain.support * dual_to_range.support
-
-    elements = _np.flatnonzero(support)
-    number_of_elements = len(elements)
-
-    nshape_test = dual_to_range.number_of_shape_functions
-    nshape_trial = domain.number_of_shape_functions
+    from bempp.core.dispatcher import sparse_csr_assembler_dispatcher
 
     # Always assemble in double precision for sparse ops
-    # precision = operator_descriptor.precision
-
     precision = "double"
 
     if operator_descriptor.is_complex:
@@ -110,41 +162,122 @@ def assemble_sparse(
     else:
         result_type = get_type(precision).real
 
-    result = _np.zeros(
-        nshape_test * nshape_trial * number_of_elements, dtype=result_type
-    )
+    data = _np.zeros(len(pattern.indices), dtype=result_type)
 
     with bempp.api.Timer() as t:  # noqa: F841
-        numba_assembly_function(
-            domain.grid.data(precision),
-            nshape_test,
-            nshape_trial,
+        sparse_csr_assembler_dispatcher(
+            device_interface,
+            operator_descriptor,
+            domain,
+            dual_to_range,
+            parameters,
             elements,
-            quad_points,
-            quad_weights,
-            dual_to_range.normal_multipliers,
-            domain.normal_multipliers,
-            dual_to_range.local_multipliers,
-            domain.local_multipliers,
-            dual_to_range.shapeset.evaluate,
-            domain.shapeset.evaluate,
-            dual_to_range.numba_evaluate,
-            domain.numba_evaluate,
-            numba_kernel_function,
-            result,
+            pattern,
+            data,
         )
 
-    irange = _np.arange(nshape_test)
-    jrange = _np.arange(nshape_trial)
+    return data
+
+
+def _support_elements(domain, dual_to_range):
+    """Return the elements in the support of both spaces."""
+    return _np.flatnonzero(domain.support * dual_to_range.support)
+
+
+@_numba.njit(parallel=True, cache=True)
+def _csr_pattern(test_dofs, trial_dofs, row_count):
+    """
+    Compute a CSR sparsity pattern from element to dof maps.
+
+    Returns the CSR index pointer and the column indices, together with
+    the entries of the element matrices (in row-major order) sorted by
+    their position in the CSR data array and the start of the entries for
+    each position. This allows to sum up each CSR data entry independently.
+    """
+    nelements, nshape_test = test_dofs.shape
+    nshape_trial = trial_dofs.shape[1]
 
-    i_ind = _np.tile(_np.repeat(irange, nshape_trial), len(elements)) + _np.repeat(
-        elements * nshape_test,
-        nshape_test * nshape_trial,
-    )
+    # Collect the candidate columns of each row.
+    candidate_ptr = _np.zeros(row_count + 1, dtype=_np.int64)
+    for element_index in range(nelements):
+        for test_index in range(nshape_test):
+            candidate_ptr[1 + test_dofs[element_index, test_index]] += nshape_trial
+    candidate_ptr = _np.cumsum(candidate_ptr)
 
-    j_ind = _np.tile(_np.tile(jrange, nshape_test), len(elements)) + _np.repeat(
-        elements * nshape_trial,
-        nshape_test * nshape_trial,
-    )
+    candidates = _np.empty(candidate_ptr[-1], dtype=_np.int64)
+    fill = candidate_ptr[:-1].copy()
+    for element_index in range(nelements):
+        for test_index in range(nshape_test):
+            row = test_dofs[element_index, test_index]
+            for trial_index in range(nshape_trial):
+                candidates[fill[row]] = trial_dofs[element_index, trial_index]
+                fill[row] += 1
 
-    return i_ind, j_ind, result
+    # Sort and compress the columns of each row.
+    row_nnz = _np.zeros(row_count, dtype=_np.int64)
+    for row in _numba.prange(row_count):
+        start = candidate_ptr[row]
+        end = candidate_ptr[row + 1]
+        if start == end:
+            continue
+        candidates[start:end] = _np.sort(candidates[start:end])
+        count = 1
+        for index in range(start + 1, end):
+            if candidates[index] != candidates[start + count - 1]:
+                candidates[start + count] = candidates[index]
+                count += 1
+        row_nnz[row] = count
+
+    indptr = _np.zeros(row_count + 1, dtype=_np.int64)
+    indptr[1:] = _np.cumsum(row_nnz)
+
+    indices = _np.empty(indptr[-1], dtype=_np.int64)
+    for row in _numba.prange(row_count):
+        indices[indptr[row] : indptr[row + 1]] = candidates[
+            candidate_ptr[row] : candidate_ptr[row] + row_nnz[row]
+        ]
+
+    positions = _np.empty(nelements * nshape_test * nshape_trial, dtype=_np.int64)
+    for element_index in _numba.prange(nelements):
+        for test_index in range(nshape_test):
+            row = test_dofs[element_index, test_index]
+            row_indices = indices[indptr[row] : indptr[row + 1]]
+            for trial_index in range(nshape_trial):
+                positions[
+                    (element_index * nshape_test + test_index) * nshape_trial
+                    + trial_index
+                ] = indptr[row] + _np.searchsorted(
+                    row_indices, trial_dofs[element_index, trial_index]
+                )
+
+    # Counting sort of the element matrix entries by position.
+    gather_ptr = _np.zeros(indptr[-1] + 1, dtype=_np.int64)
+    for position in positions:
+        gather_ptr[1 + position] += 1
+    gather_ptr = _np.cumsum(gather_ptr)
+
+    order = _np.empty(len(positions), dtype=_np.int64)
+    fill = gather_ptr[:-1].copy()
+    for index, position in enumerate(positions):
+        order[fill[position]] = index
+        fill[position] += 1
+
+    return indptr, indices, order, gather_ptr
+
+
+@_numba.njit(parallel=True)
+def _csr_gather(values, test_multipliers, trial_multipliers, order, gather_ptr, data):
+    """Sum the element matrix entries belonging to each CSR data entry."""
+    nshape_test = test_multipliers.shape[1]
+    nshape_trial = trial_multipliers.shape[1]
+    for position in _numba.prange(len(data)):
+        for index in range(gather_ptr[position], gather_ptr[position + 1]):
+            entry = order[index]
+            element_index = entry // (nshape_test * nshape_trial)
+            test_index = (entry // nshape_trial) % nshape_test
+            trial_index = entry % nshape_trial
+            data[position] += (
+                values[entry]
+                * test_multipliers[element_index, test_index]
+                * trial_multipliers[element_index, trial_index]
+            )
@@ -17,9 +17,11 @@ def timeit(fun):
     def timed_fun(*args, **kwargs):
         """Time an operation."""
         from bempp.api import log
+        from bempp.api.utils import instrumentation
 
         start_time = _time.time()
-        res = fun(*args, **kwargs)
+        with instrumentation.span(fun.__qualname__):
+            res = fun(*args, **kwargs)
         end_time = _time.time()
         log(fun.__qualname__ + " : {0:.3e}s".format(end_time - start_time), "timing")
         return res
@@ -0,0 +1,114 @@
+#include "bempp_base_types.h"
+#include "kernels.h"
+
+/* Two levels of indirection so that VEC_LENGTH is expanded before
+   concatenation, e.g. VEC_FUNCTION(vload) becomes vload4. */
+#define BENCHMARK_CAT(X, Y) CAT(X, Y)
+#define VEC_FUNCTION(NAME) BENCHMARK_CAT(NAME, VEC_LENGTH)
+
+/* Evaluate the Green's function KERNEL_FUNCTION for all pairs of test
+   and trial points. Trial points and normals are stored component-wise,
+   i.e. all x-coordinates first. The result of each work item is the sum
+   of all kernel values, so that the compiler cannot drop the kernel
+   evaluations. */
+__kernel void green_function_benchmark(__global REALTYPE *testPoints,
+                                       __global REALTYPE *testNormals,
+                                       __global REALTYPE *trialPoints,
+                                       __global REALTYPE *trialNormals,
+                                       __global REALTYPE *kernel_parameters,
+                                       int numberOfTrialPoints,
+                                       __global REALTYPE *result) {
+  size_t gid = get_global_id(0);
+  int trialIndex;
+  int index;
+
+  REALTYPE3 testPoint =
+      (REALTYPE3)(testPoints[3 * gid + 0], testPoints[3 * gid + 1],
+                  testPoints[3 * gid + 2]);
+  REALTYPE3 testNormal =
+      (REALTYPE3)(testNormals[3 * gid + 0], testNormals[3 * gid + 1],
+                  testNormals[3 * gid + 2]);
+
+  REALTYPEVEC sum = M_ZERO;
+  REALTYPEVEC kernelValue RESULT_SHAPE;
+  REALTYPEVEC *values = (REALTYPEVEC *)kernelValue;
+
+#if VEC_LENGTH == 1
+  REALTYPE3 trialPoint;
+  REALTYPE3 trialNormal;
+
+  for (trialIndex = 0; trialIndex < numberOfTrialPoints; ++trialIndex) {
+    trialPoint = (REALTYPE3)(trialPoints[trialIndex],
+                             trialPoints[numberOfTrialPoints + trialIndex],
+                             trialPoints[2 * numberOfTrialPoints + trialIndex]);
+    trialNormal =
+        (REALTYPE3)(trialNormals[trialIndex],
+                    trialNormals[numberOfTrialPoints + trialIndex],
+                    trialNormals[2 * numberOfTrialPoints + trialIndex]);
+    KERNEL(novec)
+    (testPoint, trialPoint, testNormal, trialNormal, kernel_parameters,
+     kernelValue);
+    for (index = 0; index < RESULT_SIZE; ++index)
+      sum += values[index];
+  }
+  result[gid] = sum;
+#else
+  REALTYPEVEC trialPoint[3];
+  REALTYPEVEC trialNormal[3];
+
+  for (trialIndex = 0; trialIndex < numberOfTrialPoints / VEC_LENGTH;
+       ++trialIndex) {
+    for (index = 0; index < 3; ++index) {
+      trialPoint[index] = VEC_FUNCTION(vload)(
+          trialIndex, trialPoints + index * numberOfTrialPoints);
+      trialNormal[index] = VEC_FUNCTION(vload)(
+          trialIndex, trialNormals + index * numberOfTrialPoints);
+    }
+    KERNEL(VEC_STRING)
+    (testPoint, trialPoint, testNormal, trialNormal, kernel_parameters,
+     kernelValue);
+    for (index = 0; index < RESULT_SIZE; ++index)
+      sum += values[index];
+  }
+  VEC_FUNCTION(vstore)(sum, gid, result);
+#endif
+}
+
+/* STREAM triad to measure the sustainable memory bandwidth. */
+__kernel void stream_triad(__global REALTYPE *a, __global REALTYPE *b,
+                           __global REALTYPE *c, REALTYPE scalar) {
+  size_t gid = get_global_id(0);
+  a[gid] = b[gid] + scalar * c[gid];
+}
+
+/* Independent chains of multiply-add operations to measure the peak
+   floating point rate. Each iteration performs
+   2 * NUMBER_OF_CHAINS * VEC_LENGTH floating point operations. */
+#define NUMBER_OF_CHAINS 8
+
+__kernel void peak_flops(__global REALTYPE *result, int iterations,
+                         REALTYPE factor) {
+  size_t gid = get_global_id(0);
+  int iteration;
+  int index;
+
+  REALTYPEVEC values[NUMBER_OF_CHAINS];
+  REALTYPEVEC vecFactor = factor;
+  REALTYPEVEC sum = M_ZERO;
+
+  for (index = 0; index < NUMBER_OF_CHAINS; ++index)
+    values[index] = (REALTYPEVEC)(gid + index);
+
+  for (iteration = 0; iteration < iterations; ++iteration)
+    for (index = 0; index < NUMBER_OF_CHAINS; ++index)
+      values[index] = mad(values[index], vecFactor, vecFactor);
+
+  for (index = 0; index < NUMBER_OF_CHAINS; ++index)
+    sum += values[index];
+
+#if VEC_LENGTH == 1
+  result[gid] = sum;
+#else
+  VEC_FUNCTION(vstore)(sum, gid, result);
+#endif
+}
@@ -0,0 +1,795 @@
+"""
+Microbenchmarks for the Green's functions and the dense assembly kernels.
+
+Each Green's function in kernels.h is evaluated for all pairs of two
+synthetic point clouds in every vector mode in which it is implemented.
+Each dense assembly kernel is run on the elements of a synthetic grid.
+The achieved throughput is reported against the measured memory
+bandwidth and peak floating point rate of the device as JSON.
+
+Run from the root directory of the repository, e.g.
+
+    python -m benchmarks.kernel_microbenchmarks --device opencl --output out.json
+
+Floating point operation counts are nominal. Every addition,
+multiplication, division, square root and elementary function counts as
+one operation. Bytes per interaction are the compulsory memory traffic,
+i.e. the input and output data of a run divided by the number of pair
+interactions.
+"""
+
+import argparse as _argparse
+import collections as _collections
+import json as _json
+import os as _os
+import re as _re
+import time as _time
+
+import numba as _numba
+import numpy as _np
+
+_CURRENT_PATH = _os.path.dirname(_os.path.realpath(__file__))
+
+_VEC_MODES = ["novec", "vec4", "vec8", "vec16"]
+_VEC_WIDTHS = {"novec": 1, "vec4": 4, "vec8": 8, "vec16": 16}
+
+_GreensFunction = _collections.namedtuple(
+    "_GreensFunction", "kernel_type result_shape flops parameters"
+)
+
+# Green's functions in kernels.h. The kernel type is the name of the
+# corresponding Numba kernel in bempp.core.numba_kernels (if there is one)
+# and the result shape is the shape of the result array in kernels.h.
+GREENS_FUNCTIONS = {
+    "laplace_single_layer": _GreensFunction("laplace_single_layer", (1,), 10, [0.0]),
+    "laplace_double_layer": _GreensFunction("laplace_double_layer", (1,), 18, [0.0]),
+    "laplace_adjoint_double_layer": _GreensFunction(
+        "laplace_adjoint_double_layer", (1,), 18, [0.0]
+    ),
+    "modified_helmholtz_real_single_layer": _GreensFunction(
+        "modified_helmholtz_single_layer", (1,), 13, [2.5]
+    ),
+    "modified_helmholtz_real_double_layer": _GreensFunction(
+        "modified_helmholtz_double_layer", (1,), 24, [2.5]
+    ),
+    "modified_helmholtz_real_adjoint_double_layer": _GreensFunction(
+        "modified_helmholtz_adjoint_double_layer", (1,), 24, [2.5]
+    ),
+    "helmholtz_single_layer": _GreensFunction(
+        "helmholtz_single_layer", (2,), 17, [2.5, 0.0]
+    ),
+    "helmholtz_double_layer": _GreensFunction(
+        "helmholtz_double_layer", (2,), 35, [2.5, 0.0]
+    ),
+    "helmholtz_adjoint_double_layer": _GreensFunction(
+        "helmholtz_adjoint_double_layer", (2,), 36, [2.5, 0.0]
+    ),
+    "helmholtz_gradient": _GreensFunction(None, (3, 2), 36, [2.5, 0.0]),
+    "helmholtz_single_layer_far_field": _GreensFunction(
+        "helmholtz_far_field_single_layer", (2,), 11, [2.5, 0.0]
+    ),
+    "helmholtz_double_layer_far_field": _GreensFunction(
+        "helmholtz_far_field_double_layer", (2,), 19, [2.5, 0.0]
+    ),
+    "laplace_single_and_double_layer": _GreensFunction(
+        "laplace_single_and_double_layer", (2,), 18, [0.0]
+    ),
+    "modified_helmholtz_real_single_and_double_layer": _GreensFunction(
+        "modified_helmholtz_single_and_double_layer", (2,), 24, [2.5]
+    ),
+    "helmholtz_single_and_double_layer": _GreensFunction(
+        "helmholtz_single_and_double_layer", (2, 2), 33, [2.5, 0.0]
+    ),
+}
+
+
+def _scalar_operator(name, space_type, degree, *args):
+    """Return a factory for a scalar operator on a grid."""
+
+    def factory(grid, precision):
+        """Create the operator."""
+        import importlib
+        import bempp.api
+
+        module_name, operator_name = name.rsplit(".", 1)
+        module = importlib.import_module("bempp.api.operators.boundary." + module_name)
+        space = bempp.api.function_space(grid, space_type, degree)
+        return getattr(module, operator_name)(
+            space, space, space, *args, precision=precision
+        )
+
+    return factory
+
+
+def _maxwell_operator(name, *args):
+    """Return a factory for a Maxwell operator on a grid."""
+
+    def factory(grid, precision):
+        """Create the operator."""
+        import bempp.api
+        from bempp.api.operators.boundary import maxwell
+
+        rwg = bempp.api.function_space(grid, "RWG", 0)
+        snc = bempp.api.function_space(grid, "SNC", 0)
+        return getattr(maxwell, name)(rwg, rwg, snc, *args, precision=precision)
+
+    return factory
+
+
+# Operators that cover all dense assembly kernels.
+ASSEMBLY_OPERATORS = {
+    "laplace_single_layer": _scalar_operator("laplace.single_layer", "DP", 0),
+    "helmholtz_double_layer": _scalar_operator("helmholtz.double_layer", "P", 1, 2.5),
+    "laplace_hypersingular": _scalar_operator("laplace.hypersingular", "P", 1),
+    "helmholtz_hypersingular": _scalar_operator("helmholtz.hypersingular", "P", 1, 2.5),
+    "modified_helmholtz_hypersingular": _scalar_operator(
+        "modified_helmholtz.hypersingular", "P", 1, 2.5
+    ),
+    "maxwell_electric_field": _maxwell_operator("electric_field", 2.5),
+    "maxwell_magnetic_field": _maxwell_operator("magnetic_field", 2.5),
+    "maxwell_combined_field": _maxwell_operator("combined_field", 2.5),
+}
+
+
+def available_vec_modes():
+    """Return the vector modes in which each Green's function is implemented."""
+    from bempp.core.opencl_kernels import _INCLUDE_PATH
+
+    source = open(_os.path.join(_INCLUDE_PATH, "kernels.h")).read()
+    modes = {}
+    for name, mode in _re.findall(
+        r"inline void (\w+)_(novec|vec4|vec8|vec16)\(", source
+    ):
+        modes.setdefault(name, []).append(mode)
+    return modes
+
+
+def synthetic_point_clouds(number_of_test_points, number_of_trial_points, dtype):
+    """
+    Return test and trial points and normals.
+
+    The points are uniformly distributed in two disjoint unit cubes and
+    the normals are random unit vectors. Test data is stored point-wise
+    and trial data component-wise, as expected by the kernels.
+    """
+    generator = _np.random.default_rng(0)
+
+    def normals(count):
+        """Return random unit vectors."""
+        vectors = generator.standard_normal((3, count))
+        return vectors / _np.linalg.norm(vectors, axis=0)
+
+    test_points = generator.random((3, number_of_test_points))
+    trial_points = generator.random((3, number_of_trial_points))
+    trial_points[0] += 2
+
+    return (
+        test_points.astype(dtype),
+        normals(number_of_test_points).astype(dtype),
+        trial_points.astype(dtype),
+        normals(number_of_trial_points).astype(dtype),
+    )
+
+
+def roofline_entry(flops, bytes_moved, elapsed, interactions, roofline):
+    """Return the throughput of a run relative to the roofline."""
+    flops = float(flops)
+    interactions = int(interactions)
+    gflops = flops / elapsed * 1e-9
+    intensity = flops / bytes_moved
+    attainable = min(
+        roofline["peak_gflops"], intensity * roofline["bandwidth_gb_per_second"]
+    )
+    return {
+        "time": elapsed,
+        "pair_interactions": interactions,
+        "pair_interactions_per_second": interactions / elapsed,
+        "flops_per_interaction": flops / interactions,
+        "gflops": gflops,
+        "bytes_per_interaction": bytes_moved / interactions,
+        "arithmetic_intensity": intensity,
+        "roofline_gflops": attainable,
+        "roofline_fraction": gflops / attainable,
+    }
+
+
+def _best_time(fun, repeats):
+    """Return the smallest time of a number of runs of fun after a warm-up run."""
+    fun()
+    times = []
+    for _ in range(repeats):
+        start = _time.perf_counter()
+        fun()
+        times.append(_time.perf_counter() - start)
+    return min(times)
+
+
+def _singular_rule_bytes(rule, device_interface, dtype):
+    """
+    Return the bytes of the quadrature data read by a singular assembly.
+
+    The OpenCL kernels read the tables of each adjacency and the element
+    pairs with their permutation index. The Numba assembler reads the
+    concatenated rules with explicit offsets for each element pair.
+    """
+    if device_interface == "opencl":
+        table_bytes = sum(
+            (
+                batch.table.test_points.size
+                + batch.table.trial_points.size
+                + batch.table.weights.size
+            )
+            * _np.dtype(dtype).itemsize
+            for batch in rule.adjacency_batches()
+        )
+        return (
+            table_bytes
+            + rule.test_indices.nbytes
+            + rule.trial_indices.nbytes
+            + rule.permutations.nbytes
+        )
+    return sum(
+        array.nbytes for array in rule.get_arrays() if isinstance(array, _np.ndarray)
+    )
+
+
+class OpenCLBenchmarks(object):
+    """Microbenchmarks on an OpenCL device."""
+
+    def __init__(self, precision, device_type="cpu"):
+        """Initialize the benchmarks on the default device of the given type."""
+        import pyopencl as cl
+        from bempp.core.opencl_kernels import default_context, default_device
+        from bempp.core.opencl_kernels import get_native_vector_width
+
+        self._cl = cl
+        self._precision = precision
+        self._device_type = device_type
+        self._context = default_context(device_type)
+        self._device = default_device(device_type)
+        self._dtype = _np.dtype("float32" if precision == "single" else "float64")
+        self._native_width = get_native_vector_width(self._device, precision)
+        self._source = open(
+            _os.path.join(_CURRENT_PATH, "kernel_microbenchmarks.cl")
+        ).read()
+
+    def device_info(self):
+        """Return a description of the device."""
+        return {
+            "interface": "opencl",
+            "name": self._device.name.strip(),
+            "platform": self._device.platform.name.strip(),
+            "device_type": self._device_type,
+            "compute_units": self._device.max_compute_units,
+            "native_vector_width": self._native_width,
+        }
+
+    def _build(self, options):
+        """Build the benchmark program."""
+        from bempp.core.opencl_kernels import get_kernel_compile_options
+
+        return self._cl.Program(self._context, self._source).build(
+            options=get_kernel_compile_options(options, self._precision)
+        )
+
+    def _run(self, kernel, global_size, args, repeats):
+        """Return the smallest kernel time from the profiling events."""
+        cl = self._cl
+        properties = cl.command_queue_properties.PROFILING_ENABLE
+        times = []
+        with cl.CommandQueue(
+            self._context, device=self._device, properties=properties
+        ) as queue:
+            for _ in range(1 + repeats):
+                event = kernel(queue, (global_size,), None, *args)
+                event.wait()
+                times.append(1e-9 * (event.profile.end - event.profile.start))
+        return min(times[1:])
+
+    def _native_vec_string(self):
+        """Return the vector mode that corresponds to the native vector width."""
+        widths = {width: mode for mode, width in _VEC_WIDTHS.items()}
+        return widths.get(self._native_width, "novec")
+
+    def roofline(self, stream_size, repeats):
+        """Measure the memory bandwidth and the peak floating point rate."""
+        cl = self._cl
+        mf = cl.mem_flags
+        vec_string = self._native_vec_string()
+        vec_length = _VEC_WIDTHS[vec_string]
+        program = self._build({"VEC_LENGTH": vec_length, "VEC_STRING": vec_string})
+
+        buffers = [
+            cl.Buffer(
+                self._context,
+                mf.READ_WRITE | mf.COPY_HOST_PTR,
+                hostbuf=_np.ones(stream_size, dtype=self._dtype),
+            )
+            for _ in range(3)
+        ]
+        elapsed = self._run(
+            program.stream_triad,
+            stream_size,
+            buffers + [self._dtype.type(3)],
+            repeats,
+        )
+        bandwidth = 3 * stream_size * self._dtype.itemsize / elapsed * 1e-9
+
+        work_items = 64 * self._device.max_compute_units
+        iterations = 4096
+        result_buffer = cl.Buffer(
+            self._context,
+            mf.WRITE_ONLY,
+            size=work_items * vec_length * self._dtype.itemsize,
+        )
+        elapsed = self._run(
+            program.peak_flops,
+            work_items,
+            [result_buffer, _np.int32(iterations), self._dtype.type(0.999)],
+            repeats,
+        )
+        flops = 2 * 8 * vec_length * iterations * work_items
+
+        return {
+            "bandwidth_gb_per_second": bandwidth,
+            "peak_gflops": flops / elapsed * 1e-9,
+        }
+
+    def greens_function(self, name, mode, test_points, trial_points, repeats):
+        """Benchmark a Green's function in a given vector mode."""
+        cl = self._cl
+        mf = cl.mem_flags
+        green = GREENS_FUNCTIONS[name]
+        vec_length = _VEC_WIDTHS[mode]
+
+        program = self._build(
+            {
+                "KERNEL_FUNCTION": name,
+                "VEC_LENGTH": vec_length,
+                "VEC_STRING": mode,
+                "RESULT_SHAPE": "".join(f"[{n}]" for n in green.result_shape),
+                "RESULT_SIZE": int(_np.prod(green.result_shape)),
+            }
+        )
+
+        test, test_normals, trial, trial_normals = synthetic_point_clouds(
+            test_points, trial_points, self._dtype
+        )
+        host_arrays = [
+            test.ravel(order="F"),
+            test_normals.ravel(order="F"),
+            trial.ravel(),
+            trial_normals.ravel(),
+            _np.array(green.parameters, dtype=self._dtype),
+        ]
+        buffers = [
+            cl.Buffer(self._context, mf.READ_ONLY | mf.COPY_HOST_PTR, hostbuf=array)
+            for array in host_arrays
+        ]
+        result_buffer = cl.Buffer(
+            self._context,
+            mf.WRITE_ONLY,
+            size=test_points * vec_length * self._dtype.itemsize,
+        )
+
+        elapsed = self._run(
+            program.green_function_benchmark,
+            test_points,
+            buffers + [_np.int32(trial_points), result_buffer],
+            repeats,
+        )
+        bytes_moved = (
+            sum(array.nbytes for array in host_arrays)
+            + test_points * vec_length * self._dtype.itemsize
+        )
+        return elapsed, bytes_moved
+
+    def kernel_name(self, descriptor, mode):
+        """Return the name of the assembly kernel."""
+        from bempp.core.opencl_kernels import select_cl_kernel
+
+        return select_cl_kernel(descriptor, mode)[0]
+
+
+class NumbaBenchmarks(object):
+    """Microbenchmarks with Numba on the CPU."""
+
+    def __init__(self, precision):
+        """Initialize the benchmarks."""
+        self._precision = precision
+        self._dtype = _np.dtype("float32" if precision == "single" else "float64")
+
+    def device_info(self):
+        """Return a description of the device."""
+        import platform
+
+        return {
+            "interface": "numba",
+            "name": platform.processor() or platform.machine(),
+            "threads": _numba.get_num_threads(),
+        }
+
+    def roofline(self, stream_size, repeats):
+        """Measure the memory bandwidth and the peak floating point rate."""
+        a, b, c = [_np.ones(stream_size, dtype=self._dtype) for _ in range(3)]
+        scalar = self._dtype.type(3)
+        elapsed = _best_time(lambda: _numba_stream_triad(a, b, c, scalar), repeats)
+        bandwidth = 3 * stream_size * self._dtype.itemsize / elapsed * 1e-9
+
+        chunks = 64 * _numba.get_num_threads()
+        iterations = 4096
+        result = _np.zeros(chunks, dtype=self._dtype)
+        factor = self._dtype.type(0.999)
+        elapsed = _best_time(
+            lambda: _numba_peak_flops(result, iterations, factor), repeats
+        )
+        flops = 2 * _NUMBA_CHAINS * iterations * chunks
+
+        return {
+            "bandwidth_gb_per_second": bandwidth,
+            "peak_gflops": flops / elapsed * 1e-9,
+        }
+
+    def greens_function(self, name, mode, test_points, trial_points, repeats):
+        """Benchmark the Numba implementation of a Green's function."""
+        from bempp.core.numba_kernels import select_numba_kernels
+        from bempp.api.operators import OperatorDescriptor
+
+        green = GREENS_FUNCTIONS[name]
+        descriptor = OperatorDescriptor(
+            name,
+            green.parameters,
+            green.kernel_type,
+            "default_scalar",
+            self._precision,
+            green.result_shape[-1] == 2,
+            None,
+            1,
+        )
+        _, kernel_function = select_numba_kernels(descriptor, mode="regular")
+
+        test, test_normals, trial, trial_normals = synthetic_point_clouds(
+            test_points, trial_points, self._dtype
+        )
+        parameters = _np.array(green.parameters, dtype=self._dtype)
+        result = _np.zeros(test_points, dtype=_np.complex128)
+
+        elapsed = _best_time(
+            lambda: _numba_greens_function_driver(
+                kernel_function,
+                test,
+                test_normals,
+                trial,
+                trial_normals,
+                parameters,
+                result,
+            ),
+            repeats,
+        )
+        bytes_moved = (
+            test.nbytes
+            + test_normals.nbytes
+            + trial.nbytes
+            + trial_normals.nbytes
+            + test_points * self._dtype.itemsize
+        )
+        return elapsed, bytes_moved
+
+    def kernel_name(self, descriptor, mode):
+        """Return the name of the assembly kernel."""
+        from bempp.core.numba_kernels import select_numba_kernels
+
+        return select_numba_kernels(descriptor, mode)[0].__name__
+
+
+_NUMBA_CHAINS = 16
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _numba_stream_triad(a, b, c, scalar):
+    """STREAM triad."""
+    for index in _numba.prange(len(a)):
+        a[index] = b[index] + scalar * c[index]
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _numba_peak_flops(result, iterations, factor):
+    """Run independent chains of multiply-add operations."""
+    dtype = result.dtype
+    for chunk in _numba.prange(len(result)):
+        values = _np.empty(_NUMBA_CHAINS, dtype=dtype)
+        for index in range(_NUMBA_CHAINS):
+            values[index] = chunk + index
+        for _ in range(iterations):
+            for index in range(_NUMBA_CHAINS):
+                values[index] = values[index] * factor + factor
+        result[chunk] = _np.sum(values)
+
+
+@_numba.jit(
+    nopython=True, parallel=True, error_model="numpy", fastmath=True, boundscheck=False
+)
+def _numba_greens_function_driver(
+    kernel_function,
+    test_points,
+    test_normals,
+    trial_points,
+    trial_normals,
+    kernel_parameters,
+    result,
+):
+    """Evaluate a Green's function for all pairs of test and trial points."""
+    for index in _numba.prange(test_points.shape[1]):
+        values = kernel_function(
+            test_points[:, index],
+            trial_points,
+            test_normals[:, index],
+            trial_normals,
+            kernel_parameters,
+        )
+        result[index] = _np.sum(values)
+
+
+def benchmark_greens_functions(backend, names, modes, args, roofline):
+    """Benchmark Green's functions in all requested vector modes."""
+    if isinstance(backend, OpenCLBenchmarks):
+        implemented = available_vec_modes()
+    else:
+        implemented = {
+            name: ["numba"]
+            for name, green in GREENS_FUNCTIONS.items()
+            if green.kernel_type is not None
+        }
+        modes = ["numba"]
+
+    results = []
+    for name in names:
+        for mode in modes:
+            if mode not in implemented.get(name, []):
+                continue
+            elapsed, bytes_moved = backend.greens_function(
+                name, mode, args.test_points, args.trial_points, args.repeats
+            )
+            interactions = args.test_points * args.trial_points
+            entry = {"kernel": name, "mode": mode}
+            entry.update(
+                roofline_entry(
+                    GREENS_FUNCTIONS[name].flops * interactions,
+                    bytes_moved,
+                    elapsed,
+                    interactions,
+                    roofline,
+                )
+            )
+            results.append(entry)
+    return results
+
+
+def _kernel_flops(descriptor, nshape_test, nshape_trial):
+    """
+    Nominal flops per quadrature point pair of a dense assembly kernel.
+
+    This is the cost of the Green's function and one multiply-add for
+    each pair of test and trial shape functions.
+    """
+    cl_names = {
+        green.kernel_type: name
+        for name, green in GREENS_FUNCTIONS.items()
+        if green.kernel_type is not None
+    }
+    complex_factor = 4 if descriptor.is_complex else 1
+    kernel = GREENS_FUNCTIONS[cl_names[descriptor.kernel_type]]
+    return kernel.flops + 2 * complex_factor * nshape_test * nshape_trial
+
+
+def benchmark_assembly(backend, names, args, roofline):
+    """Benchmark the regular and singular dense assembly kernels."""
+    import bempp.api
+    from bempp.api.integration.triangle_gauss import rule
+    from bempp.core.dispatcher import dense_assembler_dispatcher
+    from bempp.core.dispatcher import singular_assembler_dispatcher
+    from bempp.core.singular_assembler import _SingularQuadratureRuleInterfaceGalerkin
+    from bempp.api.utils.helpers import get_type
+
+    device_interface = "opencl" if isinstance(backend, OpenCLBenchmarks) else "numba"
+    grid = bempp.api.shapes.regular_sphere(args.grid_level)
+
+    results = []
+    for name in names:
+        operator = ASSEMBLY_OPERATORS[name](grid, args.precision)
+        descriptor = operator.descriptor
+        domain = operator.domain
+        dual_to_range = operator.dual_to_range
+        parameters = operator.parameters
+        nshape_test = dual_to_range.number_of_shape_functions
+        nshape_trial = domain.number_of_shape_functions
+        flops_per_interaction = _kernel_flops(descriptor, nshape_test, nshape_trial)
+
+        if descriptor.is_complex:
+            result_type = get_type(descriptor.precision).complex
+        else:
+            result_type = get_type(descriptor.precision).real
+        grid_bytes = (
+            grid.as_array.size * _np.dtype(get_type(descriptor.precision).real).itemsize
+        )
+
+        # Regular kernel
+        order = parameters.quadrature.adapted_order("regular", domain, dual_to_range)
+        number_of_quad_points = len(rule(order)[1])
+        result = _np.zeros(
+            (dual_to_range.global_dof_count, domain.global_dof_count),
+            dtype=result_type,
+        )
+
+        def run_regular():
+            """Run the regular assembly."""
+            result[:] = 0
+            dense_assembler_dispatcher(
+                device_interface,
+                descriptor,
+                domain,
+                dual_to_range,
+                parameters,
+                result,
+            )
+
+        elapsed = _best_time(run_regular, args.repeats)
+        interactions = (
+            dual_to_range.number_of_support_elements
+            * domain.number_of_support_elements
+            * number_of_quad_points**2
+        )
+        entry = {
+            "operator": name,
+            "kernel": backend.kernel_name(descriptor, "regular"),
+            "mode": "regular",
+            "number_of_elements": int(grid.number_of_elements),
+        }
+        entry.update(
+            roofline_entry(
+                flops_per_interaction * interactions,
+                result.nbytes + 2 * grid_bytes,
+                elapsed,
+                interactions,
+                roofline,
+            )
+        )
+        results.append(entry)
+
+        # Singular kernel
+        order = parameters.quadrature.adapted_order("singular", domain, dual_to_range)
+        localised_domain = domain.localised_space
+        localised_dual = dual_to_range.localised_space
+        singular_rule = _SingularQuadratureRuleInterfaceGalerkin(
+            grid, order, localised_dual.support, localised_domain.support
+        )
+        singular_result = _np.zeros(
+            nshape_test * nshape_trial * singular_rule.index_count["all"],
+            dtype=result_type,
+        )
+
+        def run_singular():
+            """Run the singular assembly."""
+            singular_assembler_dispatcher(
+                device_interface,
+                descriptor,
+                grid,
+                localised_domain,
+                localised_dual,
+                singular_rule,
+                descriptor.options,
+                singular_result,
+            )
+
+        elapsed = _best_time(run_singular, args.repeats)
+        interactions = sum(
+            singular_rule.index_count[adjacency]
+            * singular_rule.number_of_points(adjacency)
+            for adjacency in ["coincident", "edge_adjacent", "vertex_adjacent"]
+        )
+        entry = {
+            "operator": name,
+            "kernel": backend.kernel_name(descriptor, "singular"),
+            "mode": "singular",
+            "number_of_elements": int(grid.number_of_elements),
+        }
+        entry.update(
+            roofline_entry(
+                flops_per_interaction * interactions,
+                singular_result.nbytes
+                + _singular_rule_bytes(
+                    singular_rule,
+                    device_interface,
+                    get_type(descriptor.precision).real,
+                )
+                + grid_bytes,
+                elapsed,
+                interactions,
+                roofline,
+            )
+        )
+        results.append(entry)
+
+    return results
+
+
+def main(argv=None):
+    """Run the microbenchmarks and write the results as JSON."""
+    parser = _argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("--device", default="numba", choices=["numba", "opencl"])
+    parser.add_argument("--device-type", default="cpu", choices=["cpu", "gpu"])
+    parser.add_argument("--precision", default="double", choices=["single", "double"])
+    parser.add_argument(
+        "--vec",
+        default=",".join(_VEC_MODES),
+        help="Comma separated OpenCL vector modes (novec, vec4, vec8, vec16).",
+    )
+    parser.add_argument(
+        "--kernels",
+        default=",".join(GREENS_FUNCTIONS),
+        help="Comma separated Green's functions, or 'none'.",
+    )
+    parser.add_argument(
+        "--operators",
+        default=",".join(ASSEMBLY_OPERATORS),
+        help="Comma separated operators for the assembly kernels, or 'none'.",
+    )
+    parser.add_argument("--test-points", type=int, default=2048)
+    parser.add_argument("--trial-points", type=int, default=4096)
+    parser.add_argument("--grid-level", type=int, default=3)
+    parser.add_argument("--stream-size", type=int, default=2**24)
+    parser.add_argument("--repeats", type=int, default=3)
+    parser.add_argument("--output", default=None, help="Output file (default stdout).")
+    args = parser.parse_args(argv)
+
+    if args.trial_points % 16 != 0:
+        raise ValueError("Number of trial points must be a multiple of 16.")
+
+    def selection(value, choices):
+        """Return the selected names."""
+        if value == "none":
+            return []
+        names = value.split(",")
+        for name in names:
+            if name not in choices:
+                raise ValueError(f"Unknown name {name}.")
+        return names
+
+    kernels = selection(args.kernels, GREENS_FUNCTIONS)
+    operators = selection(args.operators, ASSEMBLY_OPERATORS)
+    modes = selection(args.vec, _VEC_MODES)
+
+    if args.device == "opencl":
+        import bempp.api
+
+        bempp.api.BOUNDARY_OPERATOR_DEVICE_TYPE = args.device_type
+        backend = OpenCLBenchmarks(args.precision, args.device_type)
+    else:
+        backend = NumbaBenchmarks(args.precision)
+
+    roofline = backend.roofline(args.stream_size, args.repeats)
+
+    report = {
+        "device": backend.device_info(),
+        "precision": args.precision,
+        "roofline": roofline,
+        "greens_functions": benchmark_greens_functions(
+            backend, kernels, modes, args, roofline
+        ),
+        "assembly": benchmark_assembly(backend, operators, args, roofline),
+    }
+
+    output = _json.dumps(report, indent=2)
+    if args.output is None:
+        print(output)
+    else:
+        with open(args.output, "w") as f:
+            f.write(output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,436 @@
+"""
+Scaling benchmarks for the assembly and evaluation phases.
+
+The driver sweeps the refinement level of a regular sphere, the device
+interface, the precision, the OpenCL vector width and the number of
+threads. Each combination of device interface, precision, vector width
+and thread count runs in its own process, since the number of Numba
+threads has to be fixed before Numba is imported. For OpenCL the number
+of threads is set by device fission of the default CPU device.
+
+For each phase the time and the peak increase of the resident memory
+are recorded, together with strong and weak scaling efficiencies.
+The results can be compared against a stored baseline, e.g.
+
+    python -m benchmarks.scaling_benchmarks --levels 2,3,4 --threads 1,2,4 \\
+        --output results.json --baseline baseline.json
+
+The process exits with status 1 if a phase is slower or needs more
+memory than the baseline by more than the given tolerances.
+"""
+
+import argparse as _argparse
+import itertools as _itertools
+import json as _json
+import os as _os
+import subprocess as _subprocess
+import sys as _sys
+import tempfile as _tempfile
+import threading as _threading
+import time as _time
+
+import numpy as _np
+
+PHASES = ["dense", "singular", "sparse", "fmm", "potential"]
+
+# Exponent of the number of elements in the work of a phase.
+_WORK_EXPONENT = {"dense": 2, "singular": 1, "sparse": 1, "fmm": 1, "potential": 2}
+
+_CONFIG_KEYS = ["device_interface", "precision", "vec", "threads"]
+
+
+def _resident_memory():
+    """Return the resident set size of this process in bytes (or None)."""
+    try:
+        import psutil
+
+        return psutil.Process(_os.getpid()).memory_info()[0]
+    except ImportError:
+        pass
+    try:
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * _os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError):
+        return None
+
+
+class PeakMemory(object):
+    """Context manager to measure the peak increase of the resident memory."""
+
+    def __init__(self, interval=0.005):
+        """Construct with the sampling interval in seconds."""
+        self._interval = interval
+        self._stop = _threading.Event()
+        self._thread = None
+        self.start = None
+        self.peak = None
+        self.increase = None
+
+    def _sample(self):
+        """Sample the resident memory until stopped."""
+        while not self._stop.wait(self._interval):
+            self.peak = max(self.peak, _resident_memory())
+
+    def __enter__(self):
+        """Enter."""
+        self.start = _resident_memory()
+        self.peak = self.start
+        if self.start is not None:
+            self._thread = _threading.Thread(target=self._sample, daemon=True)
+            self._thread.start()
+        return self
+
+    def __exit__(self, *args):
+        """Exit."""
+        if self._thread is not None:
+            self._stop.set()
+            self._thread.join()
+            self.peak = max(self.peak, _resident_memory())
+            self.increase = self.peak - self.start
+
+
+def _prepare_phase(phase, grid, device_interface, precision):
+    """
+    Prepare a phase on a grid.
+
+    Return a callable that runs the timed part of the phase, or None if
+    the phase is not available.
+    """
+    import bempp.api
+    from bempp.api.operators.boundary import laplace, sparse
+    from bempp.api.operators.potential import laplace as laplace_potential
+
+    space = bempp.api.function_space(grid, "DP", 0)
+
+    def single_layer(assembler):
+        """Return the Laplace single layer operator."""
+        return laplace.single_layer(
+            space,
+            space,
+            space,
+            assembler=assembler,
+            device_interface=device_interface,
+            precision=precision,
+        )
+
+    if phase == "dense":
+        return lambda: single_layer("dense").weak_form()
+
+    if phase == "singular":
+        return lambda: single_layer("only_singular_part").weak_form()
+
+    if phase == "sparse":
+        p1_space = bempp.api.function_space(grid, "P", 1)
+        return lambda: sparse.identity(
+            p1_space,
+            p1_space,
+            p1_space,
+            device_interface=device_interface,
+            precision=precision,
+        ).weak_form()
+
+    if phase == "fmm":
+        if not bempp.api.check_for_fmm():
+            return None
+        # The setup of the FMM is not timed, only the matrix-vector product.
+        bempp.api.clear_fmm_cache()
+        discrete_operator = single_layer("fmm").weak_form()
+        vec = _np.random.default_rng(0).random(space.global_dof_count)
+        return lambda: discrete_operator @ vec
+
+    if phase == "potential":
+        # As many evaluation points on a larger sphere as there are elements.
+        points = 2 * grid.centroids.T
+        fun = bempp.api.GridFunction(
+            space, coefficients=_np.ones(space.global_dof_count)
+        )
+        return lambda: laplace_potential.single_layer(
+            space,
+            points,
+            device_interface=device_interface,
+            precision=precision,
+        ).evaluate(fun)
+
+    raise ValueError(f"Unknown phase {phase}.")
+
+
+def _fission_opencl_device(threads):
+    """Restrict the default OpenCL CPU device to a number of compute units."""
+    import pyopencl as cl
+    from bempp.core import opencl_kernels
+
+    device = opencl_kernels.default_cpu_device()
+    if threads >= device.max_compute_units:
+        return
+
+    sub_device = device.create_sub_devices(
+        [cl.device_partition_property.EQUALLY, threads]
+    )[0]
+    opencl_kernels._DEFAULT_CPU_CONTEXT = cl.Context(devices=[sub_device])
+    opencl_kernels._DEFAULT_CPU_DEVICE = sub_device
+
+
+def run_worker(config):
+    """Run all levels and phases for one configuration in this process."""
+    import bempp.api
+
+    if config["device_interface"] == "opencl":
+        bempp.api.VECTORIZATION_MODE = config["vec"]
+        _fission_opencl_device(config["threads"])
+
+    # Compile all kernels on a small grid before measuring.
+    warmup_grid = bempp.api.shapes.regular_sphere(0)
+    for phase in config["phases"]:
+        run = _prepare_phase(
+            phase, warmup_grid, config["device_interface"], config["precision"]
+        )
+        if run is not None:
+            run()
+
+    records = []
+    for level in config["levels"]:
+        grid = bempp.api.shapes.regular_sphere(level)
+        for phase in config["phases"]:
+            record = {key: config[key] for key in _CONFIG_KEYS}
+            record.update(
+                {
+                    "level": level,
+                    "number_of_elements": int(grid.number_of_elements),
+                    "phase": phase,
+                    "work": float(grid.number_of_elements) ** _WORK_EXPONENT[phase],
+                }
+            )
+            run = _prepare_phase(
+                phase, grid, config["device_interface"], config["precision"]
+            )
+            if run is None:
+                record["skipped"] = True
+                records.append(record)
+                continue
+            times = []
+            increases = []
+            for _ in range(config["repeats"]):
+                with PeakMemory() as memory:
+                    start = _time.perf_counter()
+                    run()
+                    times.append(_time.perf_counter() - start)
+                increases.append(memory.increase)
+            record["time"] = min(times)
+            record["peak_memory"] = (
+                None if increases[0] is None else int(max(increases))
+            )
+            records.append(record)
+    return records
+
+
+def run_configuration(config):
+    """Run one configuration in a separate process and return the records."""
+    with _tempfile.TemporaryDirectory() as tmp:
+        output = _os.path.join(tmp, "records.json")
+        env = dict(_os.environ)
+        env["NUMBA_NUM_THREADS"] = str(config["threads"])
+        _subprocess.run(
+            [
+                _sys.executable,
+                "-m",
+                "benchmarks.scaling_benchmarks",
+                "--worker",
+                _json.dumps(config),
+                "--output",
+                output,
+            ],
+            env=env,
+            check=True,
+        )
+        with open(output) as f:
+            return _json.load(f)
+
+
+def add_scaling_efficiencies(records):
+    """
+    Add speedup and strong and weak scaling efficiencies to the records.
+
+    The strong scaling reference is the run with the fewest threads on the
+    same level. The weak scaling reference is the run with the fewest
+    threads on the coarsest level. The weak scaling efficiency is
+    normalized by the work of a phase, which grows quadratically with the
+    number of elements for dense phases and linearly otherwise.
+    """
+    timed = [record for record in records if "time" in record]
+
+    def group_key(record):
+        """Key of records that are compared with each other."""
+        return (
+            record["device_interface"],
+            record["precision"],
+            record["vec"],
+            record["phase"],
+        )
+
+    timed.sort(key=group_key)
+    for _, group in _itertools.groupby(timed, key=group_key):
+        group = list(group)
+        weak_reference = min(group, key=lambda r: (r["threads"], r["level"]))
+        for record in group:
+            strong_reference = min(
+                (r for r in group if r["level"] == record["level"]),
+                key=lambda r: r["threads"],
+            )
+            speedup = strong_reference["time"] / record["time"]
+            record["speedup"] = speedup
+            record["strong_efficiency"] = (
+                speedup * strong_reference["threads"] / record["threads"]
+            )
+            record["weak_efficiency"] = (
+                weak_reference["time"]
+                / record["time"]
+                * (record["work"] / weak_reference["work"])
+                * (weak_reference["threads"] / record["threads"])
+            )
+    return records
+
+
+def compare_with_baseline(
+    records, baseline, time_rtol=0.2, memory_rtol=0.2, min_time=0.05
+):
+    """
+    Compare records with baseline records.
+
+    A phase regresses if its time exceeds the baseline time by more than
+    a factor of 1 + time_rtol and by more than min_time seconds, or if
+    its peak memory exceeds the baseline by a factor of 1 + memory_rtol.
+    Return the list of regressions.
+    """
+    keys = _CONFIG_KEYS + ["level", "phase"]
+    reference = {
+        tuple(record[key] for key in keys): record
+        for record in baseline
+        if "time" in record
+    }
+
+    regressions = []
+    for record in records:
+        base = reference.get(tuple(record[key] for key in keys))
+        if base is None or "time" not in record:
+            continue
+        if (
+            record["time"] > (1 + time_rtol) * base["time"]
+            and record["time"] - base["time"] > min_time
+        ):
+            regressions.append(
+                dict(
+                    {key: record[key] for key in keys},
+                    quantity="time",
+                    value=record["time"],
+                    baseline=base["time"],
+                )
+            )
+        if (
+            record.get("peak_memory") is not None
+            and base.get("peak_memory") is not None
+            and record["peak_memory"] > (1 + memory_rtol) * base["peak_memory"]
+        ):
+            regressions.append(
+                dict(
+                    {key: record[key] for key in keys},
+                    quantity="peak_memory",
+                    value=record["peak_memory"],
+                    baseline=base["peak_memory"],
+                )
+            )
+    return regressions
+
+
+def main(argv=None):
+    """Run the scaling benchmarks."""
+
+    def int_list(value):
+        """Parse a comma separated list of integers."""
+        return [int(item) for item in value.split(",")]
+
+    def str_list(value):
+        """Parse a comma separated list of strings."""
+        return value.split(",")
+
+    parser = _argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("--levels", type=int_list, default=[1, 2, 3])
+    parser.add_argument("--device-interfaces", type=str_list, default=["numba"])
+    parser.add_argument("--precisions", type=str_list, default=["double"])
+    parser.add_argument(
+        "--vec",
+        type=str_list,
+        default=["auto"],
+        help="OpenCL vector modes (auto, novec, vec4, vec8, vec16).",
+    )
+    parser.add_argument("--threads", type=int_list, default=[1])
+    parser.add_argument("--phases", type=str_list, default=PHASES)
+    parser.add_argument("--repeats", type=int, default=1)
+    parser.add_argument("--output", default=None, help="Output file (default stdout).")
+    parser.add_argument("--baseline", default=None, help="Baseline results file.")
+    parser.add_argument("--time-rtol", type=float, default=0.2)
+    parser.add_argument("--memory-rtol", type=float, default=0.2)
+    parser.add_argument(
+        "--min-time",
+        type=float,
+        default=0.05,
+        help="Time differences below this value (in seconds) are ignored.",
+    )
+    parser.add_argument("--worker", default=None, help=_argparse.SUPPRESS)
+    args = parser.parse_args(argv)
+
+    if args.worker is not None:
+        records = run_worker(_json.loads(args.worker))
+        with open(args.output, "w") as f:
+            _json.dump(records, f)
+        return
+
+    for phase in args.phases:
+        if phase not in PHASES:
+            raise ValueError(f"Unknown phase {phase}.")
+
+    records = []
+    for device_interface, precision, threads in _itertools.product(
+        args.device_interfaces, args.precisions, args.threads
+    ):
+        # The vector width only applies to OpenCL.
+        vec_modes = args.vec if device_interface == "opencl" else [None]
+        for vec in vec_modes:
+            config = {
+                "device_interface": device_interface,
+                "precision": precision,
+                "vec": vec,
+                "threads": threads,
+                "levels": args.levels,
+                "phases": args.phases,
+                "repeats": args.repeats,
+            }
+            records += run_configuration(config)
+
+    report = {"records": add_scaling_efficiencies(records)}
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = _json.load(f)["records"]
+        report["regressions"] = compare_with_baseline(
+            records, baseline, args.time_rtol, args.memory_rtol, args.min_time
+        )
+
+    output = _json.dumps(report, indent=2)
+    if args.output is None:
+        print(output)
+    else:
+        with open(args.output, "w") as f:
+            f.write(output)
+
+    if report.get("regressions"):
+        for regression in report["regressions"]:
+            print(
+                "Regression: "
+                + ", ".join(f"{key}={value}" for key, value in regression.items()),
+                file=_sys.stderr,
+            )
+        _sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
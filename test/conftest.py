@@ -97,6 +97,26 @@ def two_element_grid():
     return Grid(vertices, elements)
 
 
+@pytest.fixture
+def curved_sphere():
+    """Unit sphere of six-node triangles with edge nodes on the sphere."""
+    from bempp.api.grid import Grid
+
+    grid = bempp.api.shapes.regular_sphere(2)
+
+    edge_nodes = 0.5 * (
+        grid.vertices[:, grid.edges[0]] + grid.vertices[:, grid.edges[1]]
+    )
+    edge_nodes /= np.linalg.norm(edge_nodes, axis=0)
+
+    # Gmsh order of the edge nodes: (0, 1), (1, 2), (2, 0)
+    elements = np.vstack(
+        [grid.elements, grid.number_of_vertices + grid.element_edges[[0, 2, 1]]]
+    )
+
+    return Grid(np.hstack([grid.vertices, edge_nodes]), elements)
+
+
 @pytest.fixture
 def default_parameters():
     """Return a default parameters object."""
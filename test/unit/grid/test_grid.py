@@ -118,3 +118,30 @@ def test_integration_element(two_element_geometries):
     """Check the volume of an element."""
     for geom in two_element_geometries:
         np.testing.assert_almost_equal(geom.integration_element, 1)
+
+
+def test_curved_grid(curved_sphere):
+    """Check the geometry of a grid of six-node triangles."""
+    flat_sphere = bempp.api.shapes.regular_sphere(2)
+
+    assert curved_sphere.is_curved
+    assert not flat_sphere.is_curved
+    assert curved_sphere.number_of_vertices == flat_sphere.number_of_vertices
+    assert curved_sphere.number_of_edges == flat_sphere.number_of_edges
+
+    curved_error = abs(np.sum(curved_sphere.volumes) - 4 * np.pi)
+    flat_error = abs(np.sum(flat_sphere.volumes) - 4 * np.pi)
+    assert curved_error < 0.05 * flat_error
+
+    local_points = np.array([[0, 1, 0, 0.5, 0.2], [0, 0, 1, 0.5, 0.3]], dtype="float64")
+    grid_data = curved_sphere.data()
+
+    for index in range(curved_sphere.number_of_elements):
+        points, normals, _ = grid_data.geometry(index, local_points)
+        np.testing.assert_allclose(
+            points[:, :3],
+            curved_sphere.vertices[:, curved_sphere.elements[:, index]],
+            atol=1e-14,
+        )
+        np.testing.assert_allclose(np.linalg.norm(points[:, 3], axis=0), 1)
+        np.testing.assert_allclose(np.sum(points * normals, axis=0), 1, rtol=5e-3)
@@ -1,4 +1,5 @@
 import numpy as np
+import pytest
 from math import sqrt
 
 import bempp.api
@@ -105,3 +106,30 @@ def test_vectorized_assembly():
     ) / np.abs(grid_fun_non_vec.projections())
 
     assert np.max(rel_diff) < 1e-14
+
+
+@pytest.mark.parametrize("vectorized", [False, True])
+def test_from_callables(vectorized):
+    """Test batched projection of callables for several parameter sets."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = bempp.api.function_space(grid, "P", 1)
+
+    @bempp.api.callable(complex=True, parameterized=True, vectorized=vectorized)
+    def fun(x, n, d, res, parameters):
+        res[0] = np.exp(1j * parameters[0] * x[0]) * (1 + n[1])
+
+    function_parameters = np.array([[1.0], [2.0], [3.0]])
+
+    grid_funs = bempp.api.GridFunction.from_callables(
+        space, fun, function_parameters=function_parameters
+    )
+
+    assert len(grid_funs) == len(function_parameters)
+
+    for grid_fun, parameters in zip(grid_funs, function_parameters):
+        expected = bempp.api.GridFunction(
+            space, fun=fun, function_parameters=parameters
+        )
+        np.testing.assert_allclose(
+            grid_fun.projections(), expected.projections(), rtol=1e-14
+        )
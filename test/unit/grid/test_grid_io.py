@@ -16,6 +16,28 @@ def test_import(filename, folder):
     bempp.api.grid.io.import_grid(os.path.join(folder, filename))
 
 
+def test_import_mixed_triangles(monkeypatch):
+    """Test that grids with flat and curved triangles are rejected."""
+    import numpy as np
+
+    class Mesh(object):
+        """Mesh with one flat and one curved triangle."""
+
+        points = np.zeros((7, 3))
+        cells_dict = {
+            "triangle": np.array([[0, 1, 2]]),
+            "triangle6": np.array([[0, 2, 3, 4, 5, 6]]),
+        }
+        cell_data_dict = {}
+
+    monkeypatch.setattr(
+        bempp.api.grid.io._meshio, "read", lambda filename: Mesh(), raising=False
+    )
+
+    with pytest.raises(ValueError):
+        bempp.api.grid.io.import_grid("mixed.msh")
+
+
 @pytest.mark.parametrize("filename", ["testoutput_cube.msh", "testoutput_cube.vtk"])
 def test_export(filename, folder):
     """Return geometries of two element grid."""
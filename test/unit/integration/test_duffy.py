@@ -33,3 +33,58 @@ def test_number_of_quad_points_for_vertex_adjacent_case():
     expected_number_of_points = 2 * _order ** 4
 
     assert actual_number_of_points == expected_number_of_points
+
+
+def test_edge_adjacent_table():
+    """Test that the edge adjacent table contains the remapped rules."""
+    import numpy as np
+
+    table = _duffy.tables(2)["edge_adjacent"]
+    test_points, trial_points, weights = _duffy.rule(2, "edge_adjacent")
+    npoints = len(weights)
+
+    assert table.number_of_permutations == 6
+    assert table.number_of_points == npoints
+    np.testing.assert_array_equal(table.weights, weights)
+
+    for index, (vertex1, vertex2) in enumerate(_duffy.EDGE_PERMUTATIONS):
+        columns = slice(index * npoints, (index + 1) * npoints)
+        np.testing.assert_array_equal(
+            table.test_points[:, columns],
+            _duffy.remap_points_shared_edge(test_points, vertex1, vertex2),
+        )
+        np.testing.assert_array_equal(
+            table.trial_points[:, columns],
+            _duffy.remap_points_shared_edge(trial_points, vertex1, vertex2),
+        )
+
+
+def test_vertex_adjacent_table():
+    """Test that the vertex adjacent table contains the remapped rules."""
+    import numpy as np
+
+    table = _duffy.tables(2)["vertex_adjacent"]
+    test_points, trial_points, _ = _duffy.rule(2, "vertex_adjacent")
+    npoints = table.number_of_points
+
+    assert table.number_of_permutations == 3
+    assert table.test_points.flags.f_contiguous
+
+    for vertex in _duffy.VERTEX_PERMUTATIONS:
+        columns = slice(vertex * npoints, (vertex + 1) * npoints)
+        np.testing.assert_array_equal(
+            table.test_points[:, columns],
+            _duffy.remap_points_shared_vertex(test_points, vertex),
+        )
+        np.testing.assert_array_equal(
+            table.trial_points[:, columns],
+            _duffy.remap_points_shared_vertex(trial_points, vertex),
+        )
+
+
+def test_tables_are_cached():
+    """Test that the tables are computed once and are read-only."""
+    tables = _duffy.tables(2)
+
+    assert _duffy.tables(2) is tables
+    assert not tables["coincident"].test_points.flags.writeable
@@ -1,5 +1,6 @@
 """Unit tests for the dense assembler."""
 
+import numpy as np
 import pytest
 import bempp.api
 from bempp.api import function_space
@@ -42,6 +43,73 @@ def test_maxwell_sparse_operators(operator, type0, type1):
     op.weak_form()
 
 
+def test_sparse_identity_pattern():
+    """Test the CSR pattern and values of the sparse identity."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    p1_space = function_space(grid, "P", 1)
+
+    mat = sparse.identity(p1_space, p1_space, p1_space).weak_form().A
+
+    # Each vertex couples with itself and its neighbours.
+    edges = grid.edges
+    expected_nnz = p1_space.global_dof_count + 2 * edges.shape[1]
+
+    assert mat.nnz == expected_nnz
+    assert mat.has_sorted_indices
+
+    # Row sums are the integrals of the hat functions.
+    vertex_areas = np.zeros(p1_space.global_dof_count)
+    for element in range(grid.number_of_elements):
+        vertex_areas[grid.elements[:, element]] += grid.volumes[element] / 3
+
+    np.testing.assert_allclose(mat.sum(axis=1).A1, vertex_areas, rtol=1e-14)
+
+
+def test_sparse_identity_with_opencl(default_parameters):
+    """Test the OpenCL sparse identity against the Numba one."""
+    if not bempp.api.CPU_OPENCL_DRIVER_FOUND:
+        pytest.skip("No OpenCL CPU driver found.")
+
+    grid = bempp.api.shapes.regular_sphere(2)
+    p1_space = function_space(grid, "P", 1)
+    dp0_space = function_space(grid, "DP", 0)
+
+    expected = sparse.identity(p1_space, dp0_space, dp0_space).weak_form().A
+
+    default_parameters.assembly.sparse.device_interface = "opencl"
+    actual = (
+        sparse.identity(p1_space, dp0_space, dp0_space, parameters=default_parameters)
+        .weak_form()
+        .A
+    )
+
+    assert actual.dtype == np.float64
+    np.testing.assert_allclose(actual.toarray(), expected.toarray(), rtol=1e-14)
+
+
+def test_sparse_identity_without_opencl_kernel(default_parameters):
+    """Test that spaces without OpenCL identity kernel fall back to Numba."""
+    if not bempp.api.CPU_OPENCL_DRIVER_FOUND:
+        pytest.skip("No OpenCL CPU driver found.")
+
+    grid = bempp.api.shapes.regular_sphere(2)
+    rwg0_space = function_space(grid, "RWG", 0)
+    rwg1_space = function_space(grid, "RWG", 1)
+
+    expected = sparse.identity(rwg1_space, rwg0_space, rwg0_space).weak_form().A
+
+    default_parameters.assembly.sparse.device_interface = "opencl"
+    actual = (
+        sparse.identity(
+            rwg1_space, rwg0_space, rwg0_space, parameters=default_parameters
+        )
+        .weak_form()
+        .A
+    )
+
+    np.testing.assert_allclose(actual.toarray(), expected.toarray(), rtol=1e-14)
+
+
 @pytest.mark.parametrize(
     "operator",
     [laplace.single_layer, laplace.double_layer, laplace.adjoint_double_layer],
@@ -75,6 +143,30 @@ def test_helmholtz_operators(operator, wavenumber, type0, type1):
     op.weak_form()
 
 
+@pytest.mark.parametrize(
+    "operator",
+    [helmholtz.single_layer, helmholtz.double_layer, helmholtz.hypersingular],
+)
+def test_helmholtz_wideband_operators(operator):
+    """Test wideband interpolation of Helmholtz operators."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = function_space(grid, "P", 1)
+
+    wideband = helmholtz.wideband(operator, space, space, space, (1.0, 3.0), order=10)
+
+    for wavenumber in [1.0, 1.7, 2.9]:
+        expected = bempp.api.as_matrix(
+            operator(space, space, space, wavenumber).weak_form()
+        )
+        actual = wideband.weak_form(wavenumber).A
+        np.testing.assert_allclose(
+            actual, expected, rtol=0, atol=1e-10 * np.max(np.abs(expected))
+        )
+
+    with pytest.raises(ValueError):
+        wideband.weak_form(3.5)
+
+
 @pytest.mark.parametrize(
     "operator",
     [
@@ -153,3 +245,154 @@ def test_maxwell_operators(operator, wavenumber, type0, type1):
 
     with pytest.raises(ValueError):
         op = operator(space1, space1, space0, wavenumber, assembler="dense")
+
+
+@pytest.mark.parametrize("wavenumber", [2.5, 2.5 + 1j])
+def test_maxwell_combined_field(wavenumber):
+    """Test the fused assembly of the Maxwell combined field operator."""
+    grid = bempp.api.shapes.regular_sphere(1)
+    rwg = function_space(grid, "RWG", 0)
+    snc = function_space(grid, "SNC", 0)
+
+    electric_weight = 0.3 - 0.2j
+    magnetic_weight = 1.7
+
+    actual = maxwell.combined_field(
+        rwg, rwg, snc, wavenumber, electric_weight, magnetic_weight, assembler="dense"
+    ).weak_form()
+
+    electric = maxwell.electric_field(rwg, rwg, snc, wavenumber, assembler="dense")
+    magnetic = maxwell.magnetic_field(rwg, rwg, snc, wavenumber, assembler="dense")
+    expected = (
+        electric_weight * electric.weak_form().to_dense()
+        + magnetic_weight * magnetic.weak_form().to_dense()
+    )
+
+    np.testing.assert_allclose(
+        actual.to_dense(), expected, rtol=1e-12, atol=1e-14 * np.abs(expected).max()
+    )
+
+
+@pytest.mark.parametrize(
+    "operator",
+    [laplace.single_layer, laplace.double_layer, laplace.hypersingular],
+)
+def test_incremental_reassembly_after_deformation(operator):
+    """Test that deformed operators match a full reassembly."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = function_space(grid, "P", 1)
+
+    op = operator(space, space, space)
+    op.weak_form()
+
+    vertices = grid.vertices.copy()
+    vertices[:, vertices[2] > 0.8] *= 1.1
+    deformed_grid = grid.deform(vertices)
+
+    changed_elements = grid.changed_elements(deformed_grid)
+    assert 0 < len(changed_elements) < grid.number_of_elements
+
+    actual = op.deform(deformed_grid).weak_form().to_dense()
+
+    deformed_space = function_space(deformed_grid, "P", 1)
+    expected = operator(deformed_space, deformed_space, deformed_space)
+    expected = expected.weak_form().to_dense()
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-12, atol=1e-14)
+
+
+@pytest.mark.parametrize("device_interface", ["numba", "opencl"])
+def test_fused_linear_combination(device_interface):
+    """Test that linear combinations of dense operators are assembled fused."""
+    from bempp.api.assembly.discrete_boundary_operator import (
+        DenseDiscreteBoundaryOperator,
+    )
+
+    if device_interface == "opencl" and not bempp.api.CPU_OPENCL_DRIVER_FOUND:
+        pytest.skip("No OpenCL CPU driver found.")
+
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = function_space(grid, "P", 1)
+    wavenumber = 1.5
+
+    def terms():
+        return (
+            sparse.identity(space, space, space),
+            helmholtz.double_layer(
+                space,
+                space,
+                space,
+                wavenumber,
+                device_interface=device_interface,
+                precision="double",
+            ),
+            helmholtz.single_layer(
+                space,
+                space,
+                space,
+                wavenumber,
+                device_interface=device_interface,
+                precision="double",
+            ),
+            laplace.single_layer(
+                space,
+                space,
+                space,
+                device_interface=device_interface,
+                precision="double",
+            ),
+        )
+
+    identity, double_layer, single_layer, laplace_single_layer = terms()
+    combined = (
+        0.5 * identity
+        + double_layer
+        - 1j * wavenumber * single_layer
+        + 2 * laplace_single_layer
+    )
+    actual = combined.weak_form()
+
+    assert isinstance(actual, DenseDiscreteBoundaryOperator)
+
+    identity, double_layer, single_layer, laplace_single_layer = terms()
+    expected = (
+        0.5 * identity.weak_form().to_dense()
+        + double_layer.weak_form().to_dense()
+        - 1j * wavenumber * single_layer.weak_form().to_dense()
+        + 2 * laplace_single_layer.weak_form().to_dense()
+    )
+
+    np.testing.assert_allclose(actual.to_dense(), expected, rtol=1e-13, atol=1e-15)
+
+
+def test_laplace_single_layer_on_curved_grid(curved_sphere):
+    """Test the Laplace single layer on a sphere of six-node triangles."""
+    flat_sphere = bempp.api.shapes.regular_sphere(2)
+
+    errors = []
+    for grid in [flat_sphere, curved_sphere]:
+        space = function_space(grid, "DP", 0)
+        ones = np.ones(space.global_dof_count)
+        mat = laplace.single_layer(space, space, space).weak_form()
+        # The single layer potential of the unit density on the unit sphere is one.
+        errors.append(abs(ones @ (mat @ ones) - 4 * np.pi))
+
+    assert errors[1] < 0.05 * errors[0]
+
+
+def test_hypersingular_fails_on_curved_grid(curved_sphere):
+    """Test that the hypersingular operator rejects curved grids."""
+    space = function_space(curved_sphere, "P", 1)
+
+    with pytest.raises(ValueError):
+        laplace.hypersingular(space, space, space).weak_form()
+
+
+def test_vector_identity_fails_on_curved_grid(curved_sphere):
+    """Test that sparse operators on vector spaces reject curved grids."""
+    from bempp.api.operators.boundary.sparse import identity
+
+    space = function_space(curved_sphere, "RWG", 0)
+
+    with pytest.raises(ValueError):
+        identity(space, space, space).weak_form()
@@ -0,0 +1,111 @@
+"""Unit tests for the automatic selection of the device interface."""
+
+import numpy as np
+import pytest
+
+import bempp.api
+from bempp.api import function_space
+from bempp.api.operators.boundary import laplace
+from bempp.core import cost_model
+
+
+@pytest.fixture
+def model():
+    """A cost model with a cheap and a fast backend."""
+    return cost_model.CostModel(
+        {
+            "numba": {
+                "overhead": 0.0,
+                "pair_cost": 1e-8,
+                "compile_time": 0.5,
+                "factors": {},
+            },
+            "opencl": {
+                "overhead": 0.1,
+                "pair_cost": 1e-9,
+                "compile_time": 2.0,
+                "factors": {},
+            },
+        }
+    )
+
+
+def test_selection_depends_on_size(model):
+    """Test that small assemblies use Numba and large ones OpenCL."""
+    assert model.select("key", 1e6) == "numba"
+    assert model.select("key", 1e10) == "opencl"
+
+
+def test_selection_depends_on_operator_type(model):
+    """Test that measured operator costs change the selection."""
+    work = 1e9
+    assert model.select("key", work) == "opencl"
+
+    model.update("opencl", "key", work, 0.1 + 2.0 + 30 * 1e-9 * work, False)
+    assert model.factor("opencl", "key") == pytest.approx(15.5)
+    assert model.select("key", work) == "numba"
+    assert model.select("other_key", work) == "opencl"
+
+
+def test_calibration_is_persisted(tmp_path, monkeypatch):
+    """Test the calibration and its storage."""
+    monkeypatch.setenv("BEMPP_CACHE_DIR", str(tmp_path))
+
+    model = cost_model.calibrate(["numba"], refine_levels=(1, 2))
+    entry = model.data["numba"]
+    assert entry["pair_cost"] > 0
+    assert entry["overhead"] >= 0
+    assert entry["compile_time"] >= 0
+
+    cost_model.save(model)
+    assert cost_model.load()[cost_model.machine_key()] == model.data
+
+
+def test_auto_device_interface(tmp_path, monkeypatch):
+    """Test assembly with the device interface 'auto'."""
+    monkeypatch.setenv("BEMPP_CACHE_DIR", str(tmp_path))
+
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = function_space(grid, "DP", 0)
+
+    actual = laplace.single_layer(
+        space, space, space, assembler="dense", device_interface="auto"
+    ).weak_form()
+    expected = laplace.single_layer(
+        space, space, space, assembler="dense", device_interface="numba"
+    ).weak_form()
+
+    np.testing.assert_allclose(actual.A, expected.A, rtol=1e-12)
+
+
+def test_only_automatic_assemblies_are_recorded(model, monkeypatch):
+    """Test that explicit device interfaces do not update the model."""
+    saved = []
+    monkeypatch.setattr(cost_model, "_MODEL", model)
+    monkeypatch.setattr(cost_model, "_UNSAVED_UPDATES", 0)
+    monkeypatch.setattr(cost_model, "_SAVE_INTERVAL", 2)
+    monkeypatch.setattr(cost_model, "_ATEXIT_REGISTERED", True)
+    monkeypatch.setattr(cost_model, "save", saved.append)
+    monkeypatch.setattr(cost_model, "available_backends", lambda precision: ["numba"])
+
+    grid = bempp.api.shapes.regular_sphere(1)
+    space = function_space(grid, "DP", 0)
+
+    def assemble(device_interface):
+        """Assemble a single layer operator."""
+        laplace.single_layer(
+            space, space, space, assembler="dense", device_interface=device_interface
+        ).weak_form()
+
+    assemble("numba")
+    assert model.data["numba"]["factors"] == {}
+
+    assemble("auto")
+    assert len(model.data["numba"]["factors"]) == 1
+    assert saved == []
+
+    assemble("auto")
+    assert saved == [model]
+
+    cost_model.flush()
+    assert saved == [model]
@@ -0,0 +1,76 @@
+"""Unit tests for discrete operators."""
+
+import numpy as np
+import pytest
+
+from bempp.api.assembly.discrete_boundary_operator import (
+    DenseDiscreteBoundaryOperator,
+)
+
+
+@pytest.fixture
+def matrices():
+    """A real and a complex matrix."""
+    rng = np.random.default_rng(0)
+    real = rng.random((300, 300))
+    imag = rng.random((300, 300))
+    return real, real + 1j * imag
+
+
+@pytest.mark.parametrize("nrhs", [1, 10])
+def test_real_matrix_times_complex_vector(matrices, nrhs):
+    """Test products of a real matrix with complex vectors."""
+    mat = matrices[0]
+    rng = np.random.default_rng(1)
+    x = rng.random((300, nrhs)) + 1j * rng.random((300, nrhs))
+
+    actual = DenseDiscreteBoundaryOperator(mat) @ x
+
+    assert actual.dtype == "complex128"
+    np.testing.assert_allclose(actual, mat @ x, rtol=1e-13)
+
+
+def test_lazy_linear_combination(matrices):
+    """Test that sums and scalar multiples are applied at matvec time."""
+    real, cplx = matrices
+    op = 2 * DenseDiscreteBoundaryOperator(real) - 1j * DenseDiscreteBoundaryOperator(
+        cplx
+    )
+    expected = 2 * real - 1j * cplx
+    x = np.random.default_rng(1).random(300)
+
+    assert len(op._terms) == 2
+    assert op.dtype == "complex128"
+    np.testing.assert_allclose(op @ x, expected @ x, rtol=1e-13)
+    np.testing.assert_allclose(op.to_dense(), expected, rtol=1e-13)
+    np.testing.assert_allclose(op.H @ x, expected.conj().T @ x, rtol=1e-13)
+    np.testing.assert_allclose((-op).to_dense(), -expected, rtol=1e-13)
+
+
+def test_single_precision_scaling_keeps_precision(matrices):
+    """Test that scalar multiplication keeps single precision."""
+    op = DenseDiscreteBoundaryOperator(matrices[0].astype("float32"))
+
+    assert (2.0 * op).dtype == "float32"
+    assert (op * 1j).dtype == "complex64"
+    assert (op @ np.ones(300)).dtype == "float32"
+
+
+@pytest.mark.parametrize("nrhs", [1, 10])
+@pytest.mark.parametrize("index", [0, 1])
+def test_single_precision_storage(matrices, index, nrhs):
+    """Test matrices stored in single precision with double precision products."""
+    mat = matrices[index]
+    op = DenseDiscreteBoundaryOperator(mat).with_storage_precision("single")
+    rng = np.random.default_rng(1)
+    x = rng.random((300, nrhs)) + 1j * rng.random((300, nrhs))
+    stored = mat.astype("complex64" if index else "float32")
+
+    actual = op @ x
+
+    assert op.dtype == mat.dtype
+    assert actual.dtype == "complex128"
+    np.testing.assert_allclose(
+        actual, stored.astype("complex128") @ x, rtol=1e-12, atol=1e-12
+    )
+    np.testing.assert_allclose(actual, mat @ x, rtol=1e-5)
@@ -42,3 +42,43 @@ def test_maxwell_operators(points, operator, wavenumber, space_type):
     )
 
     operator(space, points, wavenumber).evaluate(fun)
+
+
+@pytest.mark.parametrize(
+    "operator, space_type",
+    [
+        (helmholtz.single_layer, ("P", 1)),
+        (helmholtz.double_layer, ("DP", 1)),
+        (maxwell.electric_field, ("RWG", 0)),
+        (maxwell.magnetic_field, ("RWG", 0)),
+    ],
+)
+@pytest.mark.parametrize("interpolation", [False, True])
+def test_direction_grid_far_field(
+    operator, space_type, interpolation, default_parameters
+):
+    """Test far-field evaluation on a tensor grid of directions."""
+    from bempp.core.direction_grid_far_field_assembler import direction_grid_points
+
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = function_space(grid, *space_type)
+    rand = np.random.RandomState(0)
+    fun = bempp.api.GridFunction(space, coefficients=rand.rand(space.global_dof_count))
+
+    theta = np.linspace(0, np.pi, 31)
+    phi = np.linspace(0, 2 * np.pi, 40)
+
+    default_parameters.far_field.interpolation = interpolation
+
+    expected = operator(space, direction_grid_points(theta, phi), 2.5).evaluate(fun)
+    actual = operator(
+        space,
+        (theta, phi),
+        2.5,
+        assembler="direction_grid",
+        parameters=default_parameters,
+    ).evaluate(fun)
+
+    np.testing.assert_allclose(
+        actual, expected, rtol=0, atol=1e-10 * np.max(np.abs(expected))
+    )
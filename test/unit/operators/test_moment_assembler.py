@@ -0,0 +1,99 @@
+"""Unit tests for the assembly from single-layer moments."""
+
+import numpy as np
+import pytest
+
+import bempp.api
+from bempp.api import function_space
+from bempp.api.operators.boundary import helmholtz, laplace, maxwell
+from bempp.core import moment_assembler
+
+
+@pytest.fixture
+def grid():
+    """A small sphere."""
+    return bempp.api.shapes.regular_sphere(1)
+
+
+@pytest.fixture(autouse=True)
+def clear_cache():
+    """Start each test with an empty moment cache."""
+    moment_assembler.clear_moment_cache()
+    yield
+    moment_assembler.clear_moment_cache()
+
+
+def _compare(operator, *args):
+    """Compare the moment assembly of an operator with the dense assembly."""
+    actual = operator(*args, assembler="moments").weak_form().to_dense()
+    expected = operator(*args, assembler="dense").weak_form().to_dense()
+    np.testing.assert_allclose(
+        actual, expected, rtol=1e-10, atol=1e-10 * np.max(np.abs(expected))
+    )
+
+
+@pytest.mark.parametrize("space_type", [("DP", 0), ("P", 1), ("DP", 1)])
+def test_single_layer(grid, space_type):
+    """Test the Laplace and Helmholtz single layer operators."""
+    space = function_space(grid, *space_type)
+    _compare(laplace.single_layer, space, space, space)
+    _compare(helmholtz.single_layer, space, space, space, 1.5)
+
+
+def test_hypersingular(grid):
+    """Test hypersingular operators."""
+    space = function_space(grid, "P", 1)
+    _compare(laplace.hypersingular, space, space, space)
+    _compare(helmholtz.hypersingular, space, space, space, 1.5)
+
+
+def test_electric_field(grid):
+    """Test the Maxwell electric field operator."""
+    rwg = function_space(grid, "RWG", 0)
+    snc = function_space(grid, "SNC", 0)
+    _compare(maxwell.electric_field, rwg, rwg, snc, 1.5)
+
+
+def test_moments_are_shared(grid, tmp_path):
+    """Test that operators with the same kernel share out-of-core moments."""
+    parameters = bempp.api.GLOBAL_PARAMETERS
+    parameters.assembly.moments.cache_directory = str(tmp_path)
+    try:
+        space = function_space(grid, "P", 1)
+        rwg = function_space(grid, "RWG", 0)
+        snc = function_space(grid, "SNC", 0)
+        helmholtz.single_layer(
+            space, space, space, 1.5, assembler="moments"
+        ).weak_form()
+        helmholtz.hypersingular(
+            space, space, space, 1.5, assembler="moments"
+        ).weak_form()
+        maxwell.electric_field(rwg, rwg, snc, 1.5, assembler="moments").weak_form()
+    finally:
+        parameters.assembly.moments.cache_directory = None
+
+    assert len(moment_assembler._MOMENTS) == 1
+    assert len(list(tmp_path.iterdir())) == 1
+    moment_assembler.clear_moment_cache()
+    assert not list(tmp_path.iterdir())
+
+
+def test_moment_cache_is_bounded(grid, tmp_path):
+    """Test that the least recently used moments and files are removed."""
+    parameters = bempp.api.GLOBAL_PARAMETERS
+    parameters.assembly.moments.cache_directory = str(tmp_path)
+    parameters.assembly.moments.cache_size = 2
+    try:
+        space = function_space(grid, "P", 1)
+        for wavenumber in [1.0, 2.0, 1.0, 3.0]:
+            helmholtz.single_layer(
+                space, space, space, wavenumber, assembler="moments"
+            ).weak_form()
+            assert len(moment_assembler._MOMENTS) <= 2
+    finally:
+        parameters.assembly.moments.cache_directory = None
+        parameters.assembly.moments.cache_size = 2
+
+    wavenumbers = [key[2][0] for key in moment_assembler._MOMENTS]
+    assert wavenumbers == [1.0, 3.0]
+    assert len(list(tmp_path.iterdir())) == 2
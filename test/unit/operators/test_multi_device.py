@@ -0,0 +1,163 @@
+"""Unit tests for the distribution of OpenCL assembly across several devices."""
+
+import numpy as np
+import pytest
+
+import bempp.api
+from bempp.api import function_space
+from bempp.api.operators.boundary import laplace
+from bempp.api.operators.potential import laplace as laplace_potential
+
+
+@pytest.fixture
+def opencl():
+    """Skip tests without OpenCL CPU driver."""
+    if not bempp.api.CPU_OPENCL_DRIVER_FOUND:
+        pytest.skip("No OpenCL CPU driver found.")
+
+
+@pytest.fixture
+def three_devices(opencl, monkeypatch):
+    """Distribute the assembly across three queues of the default device."""
+    from bempp.core import opencl_kernels
+
+    def assembly_devices(device_type="cpu"):
+        """Return the default device three times."""
+        return (
+            opencl_kernels.default_context(device_type),
+            3 * [opencl_kernels.default_device(device_type)],
+        )
+
+    monkeypatch.setattr(opencl_kernels, "assembly_devices", assembly_devices)
+
+
+def test_partition_of_test_elements(opencl):
+    """Test that the partitions cover all test elements and keep their colors."""
+    from bempp.core.opencl_assemblers import _partition_test_elements
+
+    space = function_space(bempp.api.shapes.regular_sphere(2), "P", 1)
+    test_indices, test_color_indexptr = space.get_elements_by_color()
+    colors = np.repeat(
+        np.arange(len(test_color_indexptr) - 1), np.diff(test_color_indexptr)
+    )
+    color_of_element = dict(zip(test_indices, colors))
+
+    partitions = _partition_test_elements(
+        3, test_indices, test_color_indexptr, space.local2global, space.global_dof_count
+    )
+
+    np.testing.assert_equal(
+        np.sort(np.concatenate([partition.test_indices for partition in partitions])),
+        np.sort(test_indices),
+    )
+    for partition in partitions:
+        for color in range(len(test_color_indexptr) - 1):
+            elements = partition.test_indices[
+                partition.test_color_indexptr[color] : partition.test_color_indexptr[
+                    color + 1
+                ]
+            ]
+            assert all(color_of_element[element] == color for element in elements)
+        for element in partition.test_indices:
+            np.testing.assert_equal(
+                partition.rows[partition.test_local2global[element]],
+                space.local2global[element],
+            )
+
+
+def test_dense_assembly_across_devices(three_devices):
+    """Test dense assembly with the test elements split across devices."""
+    space = function_space(bempp.api.shapes.regular_sphere(2), "P", 1)
+
+    actual = laplace.single_layer(
+        space, space, space, assembler="dense", device_interface="opencl"
+    ).weak_form()
+    expected = laplace.single_layer(
+        space, space, space, assembler="dense", device_interface="numba"
+    ).weak_form()
+
+    np.testing.assert_allclose(actual.A, expected.A, rtol=1e-10)
+
+
+def test_potential_across_devices(three_devices):
+    """Test potential evaluation with the points split across devices."""
+    space = function_space(bempp.api.shapes.regular_sphere(2), "DP", 0)
+    fun = bempp.api.GridFunction(
+        space, coefficients=np.random.default_rng(0).random(space.global_dof_count)
+    )
+    points = 3 * np.random.default_rng(1).random((3, 10)) + 2
+
+    actual = laplace_potential.single_layer(
+        space, points, device_interface="opencl"
+    ).evaluate(fun)
+    expected = laplace_potential.single_layer(
+        space, points, device_interface="numba"
+    ).evaluate(fun)
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-10)
+
+
+def test_set_assembly_devices(opencl):
+    """Test assembly with devices set explicitly."""
+    from bempp.core import opencl_kernels
+
+    space = function_space(bempp.api.shapes.regular_sphere(2), "DP", 0)
+    context = opencl_kernels.default_context()
+    devices = 2 * [opencl_kernels.default_device()]
+
+    opencl_kernels.set_assembly_devices(context, devices)
+    try:
+        assert opencl_kernels.assembly_devices() == (context, devices)
+        actual = laplace.double_layer(
+            space, space, space, assembler="dense", device_interface="opencl"
+        ).weak_form()
+    finally:
+        opencl_kernels.set_assembly_devices(None)
+
+    assert opencl_kernels.assembly_devices()[1] == [opencl_kernels.default_device()]
+
+    expected = laplace.double_layer(
+        space, space, space, assembler="dense", device_interface="numba"
+    ).weak_form()
+    np.testing.assert_allclose(actual.A, expected.A, rtol=1e-10)
+
+
+def test_singular_assembly_with_shared_work_groups(
+    three_devices, monkeypatch, default_parameters
+):
+    """Test singular assembly with several pairs per work group."""
+    from bempp.api.operators.boundary import helmholtz
+    from bempp.core import opencl_assemblers
+
+    monkeypatch.setattr(
+        opencl_assemblers,
+        "SINGULAR_PAIRS_PER_GROUP",
+        {"coincident": 2, "edge_adjacent": 4, "vertex_adjacent": 8},
+    )
+
+    # The number of quadrature points of order 3 is not a multiple of
+    # the work group size.
+    default_parameters.quadrature.singular = 3
+
+    space = function_space(bempp.api.shapes.regular_sphere(1), "DP", 1)
+
+    actual = helmholtz.single_layer(
+        space,
+        space,
+        space,
+        1.5,
+        assembler="dense",
+        device_interface="opencl",
+        parameters=default_parameters,
+    ).weak_form()
+    expected = helmholtz.single_layer(
+        space,
+        space,
+        space,
+        1.5,
+        assembler="dense",
+        device_interface="numba",
+        parameters=default_parameters,
+    ).weak_form()
+
+    np.testing.assert_allclose(actual.A, expected.A, rtol=1e-10)
@@ -55,3 +55,72 @@ def test_maxwell_operators(points, operator, wavenumber, space_type):
     )
 
     operator(space, points, wavenumber).evaluate(fun)
+
+
+@pytest.mark.parametrize(
+    "module, args",
+    [(laplace, ()), (helmholtz, (2.5,)), (helmholtz, (2.5 + 1j,))],
+)
+@pytest.mark.parametrize("space_type", scalar_spaces)
+def test_fused_scalar_potentials(points, module, args, space_type):
+    """Test that a fused sum of single and double layer is correctly evaluated."""
+    grid = bempp.api.shapes.regular_sphere(1)
+    space = function_space(grid, *space_type)
+    fun = bempp.api.GridFunction(
+        space, coefficients=np.random.rand(space.global_dof_count)
+    )
+
+    slp = module.single_layer(space, points, *args)
+    dlp = module.double_layer(space, points, *args)
+
+    actual = (dlp - 2.0 * slp).evaluate(fun)
+    expected = dlp.evaluate(fun) - 2.0 * slp.evaluate(fun)
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-10)
+
+
+@pytest.mark.parametrize("wavenumber", [2.5, 2.5 + 1j])
+def test_fused_maxwell_potentials(points, wavenumber):
+    """Test that a fused sum of electric and magnetic potential is correctly evaluated."""
+    grid = bempp.api.shapes.regular_sphere(1)
+    space = function_space(grid, "RWG", 0)
+    fun = bempp.api.GridFunction(
+        space, coefficients=np.random.rand(space.global_dof_count)
+    )
+
+    efield = maxwell.electric_field(space, points, wavenumber)
+    mfield = maxwell.magnetic_field(space, points, wavenumber)
+
+    actual = (efield + 1j * mfield).evaluate(fun)
+    expected = efield.evaluate(fun) + 1j * mfield.evaluate(fun)
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-10)
+
+
+@pytest.mark.parametrize(
+    "operator, args",
+    [
+        (laplace.single_layer, ()),
+        (laplace.double_layer, ()),
+        (helmholtz.single_layer, (1.5,)),
+        (helmholtz.double_layer, (1.5 + 0.5j,)),
+    ],
+)
+def test_octree_potential_operators(operator, args):
+    """Compare octree based potential evaluation with dense evaluation."""
+    grid = bempp.api.shapes.regular_sphere(3)
+    space = function_space(grid, "P", 1)
+    fun = bempp.api.GridFunction(
+        space, coefficients=np.random.rand(space.global_dof_count)
+    )
+
+    rng = np.random.default_rng(0)
+    points = rng.uniform(-3, 3, (3, 200))
+    points = points[:, np.abs(np.linalg.norm(points, axis=0) - 1) > 0.3]
+
+    actual = operator(space, points, *args, assembler="octree").evaluate(fun)
+    expected = operator(space, points, *args).evaluate(fun)
+
+    np.testing.assert_allclose(
+        actual, expected, rtol=0, atol=1e-5 * np.max(np.abs(expected))
+    )
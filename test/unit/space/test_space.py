@@ -263,3 +263,106 @@ def test_dp1_closed_segment(grid):
             assert _np.all(space.local_multipliers[elem_index] != 0)
         else:
             assert _np.all(space.local_multipliers[elem_index] == 0)
+
+
+@pytest.mark.parametrize(
+    "space_type", [("DP", 0), ("DP", 1), ("P", 1), ("DP", 2), ("P", 3)]
+)
+def test_inverse_mass_matrix(space_type):
+    """Test the cached inverse mass matrix."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = bempp.api.function_space(grid, *space_type)
+
+    inverse = space.inverse_mass_matrix()
+    assert space.inverse_mass_matrix() is inverse
+
+    mass = space.mass_matrix().to_sparse()
+    rhs = _np.random.RandomState(0).randn(space.global_dof_count, 3)
+    rhs = rhs + 1j * rhs
+
+    _np.testing.assert_allclose(mass @ (inverse @ rhs), rhs, rtol=1e-10)
+
+    lumped = space.inverse_mass_matrix(lumped=True)
+    row_sums = _np.ravel(mass.sum(axis=1))
+    _np.testing.assert_allclose(lumped @ row_sums, _np.ones(space.global_dof_count))
+
+
+@pytest.mark.parametrize("space_type", [("P", 2), ("P", 3), ("RWG", 1)])
+def test_higher_order_continuity(space_type):
+    """Check the continuity of higher order spaces across edges."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    space = bempp.api.function_space(grid, *space_type)
+    coefficients = _np.random.RandomState(0).randn(space.global_dof_count)
+    fun = bempp.api.GridFunction(space, coefficients=coefficients)
+
+    reference_corners = _np.array([[0, 0], [1, 0], [0, 1]], dtype="float64")
+
+    for edge_index in range(grid.number_of_edges):
+        vertex0, vertex1 = grid.edges[:, edge_index]
+        tangent = grid.vertices[:, vertex1] - grid.vertices[:, vertex0]
+        values = []
+        for element in grid.edge_neighbors[edge_index]:
+            local_vertices = list(grid.elements[:, element])
+            corner0 = reference_corners[local_vertices.index(vertex0)]
+            corner1 = reference_corners[local_vertices.index(vertex1)]
+            points = _np.outer(corner0, [0.8, 0.5, 0.1]) + _np.outer(
+                corner1, [0.2, 0.5, 0.9]
+            )
+            element_values = fun.evaluate(element, points)
+            if space_type[0] == "RWG":
+                # Normal component across the edge
+                conormal = _np.cross(tangent, grid.normals[element])
+                element_values = conormal @ element_values
+            values.append(element_values)
+        _np.testing.assert_allclose(values[0], values[1], atol=1e-12)
+
+
+def test_rwg1_mass_matrix():
+    """Check that the RWG1 space extends the RWG0 space."""
+    grid = bempp.api.shapes.regular_sphere(2)
+    rwg0 = bempp.api.function_space(grid, "RWG", 0)
+    rwg1 = bempp.api.function_space(grid, "RWG", 1)
+
+    assert rwg1.global_dof_count == 2 * rwg0.global_dof_count
+
+    mass0 = bempp.api.as_matrix(rwg0.mass_matrix())
+    mass1 = bempp.api.as_matrix(rwg1.mass_matrix())
+
+    _np.testing.assert_allclose(mass1[::2, ::2], mass0, atol=1e-14)
+    assert _np.linalg.eigvalsh(mass1).min() > 0
+
+
+def test_rwg1_reproduces_linear_fields():
+    """Check that the RWG1 space contains all linear tangential fields."""
+    from bempp.api.grid import Grid
+
+    # A tilted unit square split into eight triangles.
+    points = _np.linspace(0, 1, 3)
+    x, y = [values.ravel() for values in _np.meshgrid(points, points)]
+    vertices = _np.vstack([x, y, 0.5 * x + 0.25 * y])
+    elements = []
+    for row in range(2):
+        for col in range(2):
+            corner = 3 * row + col
+            elements.append([corner, corner + 1, corner + 4])
+            elements.append([corner, corner + 4, corner + 3])
+    grid = Grid(vertices, _np.array(elements).T)
+
+    space = bempp.api.function_space(grid, "RWG", 1, include_boundary_dofs=True)
+
+    def linear_field(point, normal, domain_index, result):
+        result[:] = (1 + 2 * point[0] - point[1]) * _np.array([1.0, 0.0, 0.5]) + (
+            0.5 - point[0] + 3 * point[1]
+        ) * _np.array([0.0, 1.0, 0.25])
+
+    grid_fun = bempp.api.GridFunction(space, fun=bempp.api.real_callable(linear_field))
+
+    local_points = _np.array([[0.1, 0.6, 0.3, 0.0], [0.2, 0.1, 0.3, 1.0]])
+    for element in range(grid.number_of_elements):
+        global_points = grid.get_element(element).geometry.local2global(local_points)
+        expected = _np.zeros((3, local_points.shape[1]))
+        for index, point in enumerate(global_points.T):
+            linear_field(point, grid.normals[element], 0, expected[:, index])
+        _np.testing.assert_allclose(
+            grid_fun.evaluate(element, local_points), expected, atol=1e-10
+        )
@@ -0,0 +1,125 @@
+"""Unit tests for the instrumentation module."""
+
+import json
+
+import numpy as np
+import pytest
+
+import bempp.api
+from bempp.api.utils import instrumentation
+
+
+def test_nested_spans_and_counters():
+    """Test that spans are nested and counters are attached to spans."""
+    with instrumentation.record() as profile:
+        with instrumentation.span("outer", label="test"):
+            instrumentation.count("pairs", 3)
+            with instrumentation.span("inner"):
+                instrumentation.count("pairs", 2)
+                instrumentation.add_device_memory(1024)
+            with instrumentation.span("inner"):
+                pass
+
+    (outer,) = profile.spans("outer")
+    assert outer.attributes == {"label": "test"}
+    assert [child.name for child in outer.children] == ["inner", "inner"]
+    assert outer.counters == {"pairs": 3}
+    assert outer.device_memory == 1024
+    assert outer.peak_rss is not None
+    assert outer.duration >= sum(child.duration for child in outer.children)
+    assert profile.counters == {"pairs": 5}
+    assert profile.total_time("inner") <= profile.total_time("outer")
+
+
+def test_export():
+    """Test the export as JSON and Chrome trace."""
+    with instrumentation.record() as profile:
+        with instrumentation.span("outer"):
+            with instrumentation.span("inner"):
+                instrumentation.count("pairs")
+
+    data = json.loads(profile.to_json())
+    assert data["counters"] == {"pairs": 1}
+    assert data["spans"]["children"][0]["name"] == "outer"
+    assert data["spans"]["children"][0]["children"][0]["counters"] == {"pairs": 1}
+
+    trace = json.loads(profile.to_chrome_trace())
+    names = [event["name"] for event in trace["traceEvents"] if event["ph"] == "X"]
+    assert names == ["outer", "inner"]
+
+
+def test_no_recording():
+    """Test that the instrumentation is a no-op outside of a recording."""
+    assert not instrumentation.is_recording()
+    with instrumentation.span("outer") as span:
+        instrumentation.count("pairs")
+        assert span is None
+
+    with instrumentation.record():
+        with pytest.raises(RuntimeError):
+            with instrumentation.record():
+                pass
+
+
+def test_worker_threads():
+    """Test that spans and counters of worker threads attach to a parent span."""
+    import threading
+
+    def work(parent):
+        """Open a span and increment counters in a worker thread."""
+        with instrumentation.attach(parent):
+            with instrumentation.span("task"):
+                pass
+            for _ in range(1000):
+                instrumentation.count("pairs")
+                instrumentation.add_device_memory(1)
+
+    with instrumentation.record() as profile:
+        with instrumentation.span("kernel run") as kernel_run:
+            threads = [
+                threading.Thread(target=work, args=(instrumentation.current_span(),))
+                for _ in range(4)
+            ]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+
+    assert [child.name for child in kernel_run.children] == 4 * ["task"]
+    assert kernel_run.counters == {"pairs": 4000}
+    assert kernel_run.device_memory == 4000
+    assert instrumentation.current_span() is None
+
+
+def test_assembly_is_recorded():
+    """Test that the assembly of an operator is recorded."""
+    grid = bempp.api.shapes.regular_sphere(1)
+    space = bempp.api.function_space(grid, "DP", 0)
+    op = bempp.api.operators.boundary.laplace.single_layer(
+        space, space, space, assembler="dense", device_interface="numba"
+    )
+
+    with instrumentation.record() as profile:
+        op.weak_form()
+
+    (assembly,) = profile.spans("assembly")
+    assert assembly.attributes["operator"] == op.descriptor.identifier
+    assert profile.spans("kernel run")
+    assert profile.spans("singular rule setup")
+    assert profile.counters["element pairs"] == grid.number_of_elements**2
+    assert profile.counters["singular element pairs"] > 0
+
+
+def test_counted_operator():
+    """Test that matrix-vector products are counted."""
+    from scipy.sparse.linalg import gmres
+
+    rng = np.random.default_rng(0)
+    mat = np.eye(10) + 0.1 * rng.random((10, 10))
+    rhs = rng.random(10)
+
+    with instrumentation.record() as profile:
+        with instrumentation.span("gmres"):
+            gmres(instrumentation.counted_operator(mat), rhs)
+
+    assert profile.spans("gmres")[0].counters["matvecs"] > 0
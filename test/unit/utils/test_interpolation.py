@@ -61,3 +61,103 @@ def test_evaluation_tensor_interp_polynomial():
     )
 
     np.testing.assert_allclose(actual, expected, rtol=1e-6)
+
+
+def test_tensor_interp_polynomial_with_complex_values():
+    """Test the evaluation of a complex tensor interpolation polynomial."""
+
+    order = 16
+
+    nodes, weights = interpolation.chebychev_nodes_and_weights_second_kind(order)
+
+    x, y, z = np.meshgrid(nodes, nodes, nodes, indexing="ij")
+
+    values = np.exp(1j * (x + 2 * y + 3 * z))
+
+    rng = np.random.default_rng(0)
+    evaluation_points = rng.uniform(-1, 1, (50, 3))
+    # Include interpolation nodes to test the exact evaluation.
+    evaluation_points[0] = nodes[[1, 2, 3]]
+
+    expected = np.exp(
+        1j
+        * (
+            evaluation_points[:, 0]
+            + 2 * evaluation_points[:, 1]
+            + 3 * evaluation_points[:, 2]
+        )
+    )
+
+    actual = interpolation.evaluate_tensor_interp_polynomial(
+        nodes, weights, values, evaluation_points
+    )
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-5)
+    assert actual[0] == values[1, 2, 3]
+
+
+def test_tensor_interp_polynomial_on_grid():
+    """Test the evaluation of a tensor interpolation polynomial on a grid."""
+
+    order = 10
+
+    nodes, weights = interpolation.chebychev_nodes_and_weights_second_kind(order)
+
+    x, y, z = np.meshgrid(nodes, nodes, nodes, indexing="ij")
+
+    values = np.cos(x + y * z)
+
+    gridx = np.linspace(-1, 1, 5)
+    gridy = np.linspace(-1, 1, 6)
+    gridz = np.linspace(-1, 1, 7)
+
+    eval_x, eval_y, eval_z = np.meshgrid(gridx, gridy, gridz, indexing="ij")
+
+    expected = interpolation.evaluate_tensor_interp_polynomial(
+        nodes,
+        weights,
+        values,
+        np.vstack([eval_x.ravel(), eval_y.ravel(), eval_z.ravel()]).T,
+    ).reshape(eval_x.shape)
+
+    actual = interpolation.evaluate_tensor_interp_polynomial_on_grid(
+        nodes, weights, values, gridx, gridy, gridz
+    )
+
+    np.testing.assert_allclose(actual, expected, rtol=1e-12)
+    np.testing.assert_allclose(actual, np.cos(eval_x + eval_y * eval_z), rtol=1e-6)
+
+
+def test_compressed_kernel_on_interpolation_points():
+    """Test the low-rank approximation of kernels on interp. points."""
+
+    order = 5
+
+    nodes, _ = interpolation.chebychev_nodes_and_weights_second_kind(order)
+
+    lboundx = np.array([-2.0, -3.0, -1.0])
+    uboundx = np.array([-1.0, -2.0, -0.5])
+
+    lboundy = np.array([1.0, 1.5, 2.0])
+    uboundy = np.array([2.0, 2.5, 3.0])
+
+    for kernel_type in ["laplace", "helmholtz"]:
+        expected = interpolation.evaluate_kernel_on_interpolation_points(
+            kernel_type, lboundx, uboundx, lboundy, uboundy, nodes, wavenumber=1.5
+        )
+
+        u, v = interpolation.compressed_kernel_on_interpolation_points(
+            kernel_type,
+            lboundx,
+            uboundx,
+            lboundy,
+            uboundy,
+            nodes,
+            tol=1e-8,
+            wavenumber=1.5,
+        )
+
+        assert u.shape[1] < len(nodes) ** 3 // 4
+        np.testing.assert_allclose(
+            np.linalg.norm(u @ v - expected) / np.linalg.norm(expected), 0, atol=1e-7
+        )
@@ -0,0 +1,86 @@
+"""Unit tests for the octree."""
+
+import numpy as np
+import pytest
+
+from bempp.api.utils.octree import Octree, _radix_argsort, de_morton
+
+
+@pytest.fixture
+def octree():
+    """An octree over random points."""
+    rng = np.random.default_rng(0)
+    vertices = rng.random((3, 2000))
+    return Octree(np.zeros(3), np.ones(3), 4, vertices)
+
+
+def _level_nodes(octree, level):
+    """Return the non-empty nodes of a level."""
+    ptr = octree.non_empty_nodes_ptr
+    return octree.non_empty_nodes_by_level[ptr[level] : ptr[level + 1]]
+
+
+def _coordinates(node):
+    """Return the integer coordinates of a node."""
+    return np.array(de_morton(node))
+
+
+def test_radix_argsort():
+    """Test the radix sort against the stable Numpy sort."""
+    rng = np.random.default_rng(0)
+    keys = rng.integers(0, 1 << 30, 5000, dtype=np.uint32)
+    keys[:1000] = keys[1000:2000]
+
+    perm, sorted_keys = _radix_argsort(keys, 30)
+
+    np.testing.assert_equal(perm, np.argsort(keys, kind="stable"))
+    np.testing.assert_equal(sorted_keys, np.sort(keys))
+
+
+def test_leaves_and_levels(octree):
+    """Test the leaf assignment and the non-empty nodes on each level."""
+    leaves = np.array(
+        [octree.leaf_containing_point(point) for point in octree.vertices.T]
+    )
+    ptr = octree.leaf_nodes_ptr
+    for index, node in enumerate(octree.non_empty_leaf_nodes):
+        indices = octree.sorted_indices[ptr[index] : ptr[index + 1]]
+        assert np.all(leaves[indices] == node)
+    assert ptr[-1] == octree.vertices.shape[1]
+
+    for level in range(octree.maximum_level + 1):
+        expected = np.unique(leaves >> 3 * (octree.maximum_level - level))
+        np.testing.assert_equal(_level_nodes(octree, level), expected)
+
+
+def test_near_fields_and_interaction_lists(octree):
+    """Test near fields and interaction lists against a brute force search."""
+    near_field = octree.near_field_nodes
+    interaction_list = octree.interaction_list
+    interaction_ptr = octree.interaction_list_ptr
+
+    position = 0
+    for level in range(octree.maximum_level + 1):
+        nodes = _level_nodes(octree, level)
+        for node in nodes:
+            coords = _coordinates(node)
+            distances = np.array(
+                [np.max(np.abs(_coordinates(other) - coords)) for other in nodes]
+            )
+            neighbors = sorted(nodes[distances <= 1])
+            actual = near_field[27 * position : 27 * position + 27]
+            assert sorted(actual[actual != -1]) == neighbors
+
+            parent_distances = np.array(
+                [
+                    np.max(np.abs(_coordinates(other >> 3) - (coords >> 1)))
+                    for other in nodes
+                ]
+            )
+            expected = sorted(nodes[(distances > 1) & (parent_distances <= 1)])
+            actual = interaction_list[
+                interaction_ptr[position] : interaction_ptr[position + 1]
+            ]
+            assert sorted(actual) == expected
+            assert len(actual) <= 189
+            position += 1